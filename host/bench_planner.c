@@ -0,0 +1,167 @@
+#define _POSIX_C_SOURCE 199309L // clock_gettime()
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "maze_planner.h"
+#include "maze_corpus.h"
+#include "ref_step_map.h"
+
+// 探索の計画のベンチマーク
+// 迷路を作って、歩数Mapの作成時間と、探索1回分の計画にかかる時間を測る
+// 歩数Mapは、以前の全区画を走査する作り方(ref_step_map.c)の時間も測って比べる
+// 迷路のサイズごとにbench_planner(32x32区画)とbench_planner16(16x16区画)がある
+//
+// 使い方: bench_planner [迷路の数] [歩数Mapの繰り返し回数]
+
+typedef struct
+{
+    int calls; // 計画した回数(区画数)
+    double totalUsec; // 計画にかかった時間の合計
+    double maxUsec; // 1回の計画にかかった最大の時間
+}t_plan_stats;
+
+static double getUsec(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e6 + now.tv_nsec * 1e-3;
+}
+
+static void addStats(t_plan_stats *stats, const double usec){
+    stats->calls++;
+    stats->totalUsec += usec;
+    if(usec > stats->maxUsec){
+        stats->maxUsec = usec;
+    }
+}
+
+static t_local_dir planMove(const t_true_maze *maze, const t_goal *goal, const int isExploring,
+        t_direction *dir, const t_position *mypos, t_plan_stats *stats){
+    // 壁を読んでから次に向かう方向を決めるまでを、実機の計画タスクと同じ順に行う
+    int isWall[DIREC_NUM];
+    senseWalls(maze, mypos, isWall);
+
+    double start = getUsec();
+    setWall(goal, mypos, isWall);
+    t_local_dir localDir;
+    if(isExploring){
+        localDir = getNextCandidateDirection(goal, dir, mypos);
+    }else{
+        localDir = getNextDirection(goal, MASK_SEARCH, dir, mypos);
+    }
+    addStats(stats, getUsec() - start);
+    return localDir;
+}
+
+static void movePosition(const t_direction dir, t_position *mypos){
+    int nextX, nextY;
+    getNeighbor(mypos->x, mypos->y, dir, &nextX, &nextY);
+    mypos->x = nextX;
+    mypos->y = nextY;
+    mypos->dir = dir;
+}
+
+static int simulateSearch(const t_true_maze *maze, t_plan_stats *stats){
+    // 足立法でゴールまで行き、最短経路が確定するまで探索しながら戻る
+    // 1区画ずつ計画する。壁を読まずにまとめて直進する区画も計画に含める
+    // 確定した最短経路の歩数を返す
+    const t_goal *goal = &maze->goal;
+    t_position pos = {0, 0, north};
+    t_direction dir = pos.dir;
+
+    initMaze();
+
+    // スタート区画の壁はわかっているので、読まずに出発する
+    getNextDirection(goal, MASK_SEARCH, &dir, &pos);
+    movePosition(dir, &pos);
+    while(isGoal(goal, pos.x, pos.y) == FALSE){
+        planMove(maze, goal, FALSE, &dir, &pos, stats);
+        if(getSteps(pos.x, pos.y) == INIT_STEPS){
+            return -1;
+        }
+        movePosition(dir, &pos);
+    }
+
+    // ゴールの区画の壁を読んで止まり、候補の区画を探索しに行く
+    int isWall[DIREC_NUM];
+    senseWalls(maze, &pos, isWall);
+    setWall(goal, &pos, isWall);
+    dir = pos.dir;
+    if(getNextCandidateDirection(goal, &dir, &pos) != LOCAL_UNKNOWN){
+        movePosition(dir, &pos);
+        while(planMove(maze, goal, TRUE, &dir, &pos, stats) != LOCAL_UNKNOWN){
+            movePosition(dir, &pos);
+        }
+    }
+
+    makeStepMap(goal, MASK_SECOND);
+    return getSteps(START_GOAL.x, START_GOAL.y);
+}
+
+static double benchStepMap(const t_goal *goal, const int mask, const int repeat){
+    // 歩数Mapを1から作る時間の平均を返す
+    double start = getUsec();
+    for(int repeat_i=0; repeat_i<repeat; repeat_i++){
+        makeStepMap(goal, mask);
+    }
+    return (getUsec() - start) / repeat;
+}
+
+static double benchSweepStepMap(const t_goal *goal, const int mask, const int repeat){
+    // 以前の作り方で歩数Mapを作る時間の平均を返す
+    // 以前と同じく、壁情報の配列を直接読む
+    static t_wall wallMap[MAZESIZE_X][MAZESIZE_Y];
+    static t_steps map[MAZESIZE_X][MAZESIZE_Y];
+    getWallMap(wallMap);
+    double start = getUsec();
+    for(int repeat_i=0; repeat_i<repeat; repeat_i++){
+        makeSweepStepMap(wallMap, goal, mask, FALSE, map);
+    }
+    return (getUsec() - start) / repeat;
+}
+
+int main(int argc, char **argv){
+    int mazeNum = (argc > 1) ? atoi(argv[1]) : 100;
+    int repeat = (argc > 2) ? atoi(argv[2]) : 1000;
+
+    static t_true_maze maze;
+    t_plan_stats stats = {0};
+    double emptyUsec = 0;
+    double knownUsec = 0;
+    double emptySweepUsec = 0;
+    double knownSweepUsec = 0;
+    int sweepRepeat = (repeat >= 10) ? repeat / 10 : 1; // 以前の作り方は遅いので回数を減らす
+    double searchUsec = 0;
+    int optimalNum = 0;
+
+    for(int maze_i=0; maze_i<mazeNum; maze_i++){
+        generateMaze(&maze, maze_i);
+
+        // 何もわからない迷路と、探索し終えた迷路で歩数Mapを作る
+        initMaze();
+        emptyUsec += benchStepMap(&maze.goal, MASK_SEARCH, repeat);
+        emptySweepUsec += benchSweepStepMap(&maze.goal, MASK_SEARCH, sweepRepeat);
+
+        double start = getUsec();
+        int steps = simulateSearch(&maze, &stats);
+        searchUsec += getUsec() - start;
+        if(steps == getTrueSteps(&maze, &maze.goal)){
+            optimalNum++;
+        }
+
+        knownUsec += benchStepMap(&maze.goal, MASK_SECOND, repeat);
+        knownSweepUsec += benchSweepStepMap(&maze.goal, MASK_SECOND, sweepRepeat);
+    }
+
+    printf("mazes: %d (%dx%d), optimal routes: %d\n", mazeNum, MAZESIZE_X, MAZESIZE_Y, optimalNum);
+    printf("makeStepMap (unknown maze): %.2f usec, old sweep %.2f usec\n",
+            emptyUsec / mazeNum, emptySweepUsec / mazeNum);
+    printf("makeStepMap (searched maze): %.2f usec, old sweep %.2f usec\n",
+            knownUsec / mazeNum, knownSweepUsec / mazeNum);
+    printf("search: %.3f msec per maze, %.1f cells per maze\n", 
+            searchUsec / mazeNum * 1e-3, (double)stats.calls / mazeNum);
+    printf("plan per cell: %.2f usec average, %.2f usec max\n", 
+            stats.totalUsec / stats.calls, stats.maxUsec);
+
+    return (optimalNum == mazeNum) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
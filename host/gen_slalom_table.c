@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <math.h>
+
+#include "trajectory.h"
+#include "variables.h"
+
+// スラロームの角速度の表(main/slalom_table.c)を作る
+// Cではコンパイル時に表を計算できないので、trajectory.cのslalomCurve()をPC上で動かして、
+// 結果をconstの配列として書き出す(ESP32ではconstの配列はフラッシュに置かれる)
+// ターンの形ごとに、SLALOM_SPEEDSのうち表の速度以下の直進速度の表を作る
+//
+// 使い方: gen_slalom_table > main/slalom_table.c
+// SEARCH_SLALOM、FAST_TURNS、SLALOM_SPEEDS、pSLALOM_JERK_TIMEを変えたら作り直すこと
+
+#define VALUES_PER_LINE 8
+
+typedef struct
+{
+    const t_slalom *shape;
+    const char *shapeName; // 表から形を指すときの名前
+    const char *arrayName; // 配列の名前の頭
+}t_shape_entry;
+
+static const t_shape_entry SHAPES[] = {
+    {&SEARCH_SLALOM, "&SEARCH_SLALOM", "SEARCH"},
+    {&FAST_TURNS[FAST_TURN_SMALL90], "&FAST_TURNS[FAST_TURN_SMALL90]", "SMALL90"},
+    {&FAST_TURNS[FAST_TURN_LARGE90], "&FAST_TURNS[FAST_TURN_LARGE90]", "LARGE90"},
+    {&FAST_TURNS[FAST_TURN_180], "&FAST_TURNS[FAST_TURN_180]", "TURN180"},
+    {&FAST_TURNS[FAST_TURN_45], "&FAST_TURNS[FAST_TURN_45]", "TURN45"},
+    {&FAST_TURNS[FAST_TURN_135], "&FAST_TURNS[FAST_TURN_135]", "TURN135"},
+    {&FAST_TURNS[FAST_TURN_V90], "&FAST_TURNS[FAST_TURN_V90]", "V90"},
+};
+#define SHAPE_NUM (int)(sizeof(SHAPES) / sizeof(SHAPES[0]))
+
+static int isTableSpeed(const t_slalom *shape, const float speed){
+    // 表の速度より速い直進速度では曲がらないので、表を作らない
+    return speed <= shape->speed + 0.0001;
+}
+
+static int tableLength(const t_scurve *curve){
+    return (int)ceilf(curve->time / SLALOM_TABLE_PERIOD);
+}
+
+static void printArray(const t_shape_entry *entry, const float speed){
+    t_scurve curve;
+    slalomCurve(&curve, entry->shape, speed);
+    int length = tableLength(&curve);
+
+    printf("static const float OMEGA_%s_%03d[%d] = {\n",
+            entry->arrayName, (int)roundf(speed * 100.0), length);
+    for(int tick=0; tick<length; tick++){
+        if(tick % VALUES_PER_LINE == 0){
+            printf("   ");
+        }
+        printf(" %.5f,", slalomTableOmega(&curve, tick));
+        if(tick % VALUES_PER_LINE == VALUES_PER_LINE - 1 || tick == length - 1){
+            printf("\n");
+        }
+    }
+    printf("};\n\n");
+}
+
+int main(void){
+    int tableNum = 0;
+    int valueNum = 0;
+
+    printf("// スラロームの角速度の表\n");
+    printf("// host/gen_slalom_table.cで作ったので、直接編集しないこと\n");
+    printf("// SEARCH_SLALOM、FAST_TURNS、SLALOM_SPEEDS、pSLALOM_JERK_TIMEを変えたら作り直す\n");
+    printf("//   $ ./host/build/gen_slalom_table > main/slalom_table.c\n");
+    printf("// host/sim_motionで、表がslalomCurve()と一致するか確かめられる\n\n");
+    printf("#include \"trajectory.h\"\n\n");
+
+    for(int shape_i=0; shape_i<SHAPE_NUM; shape_i++){
+        for(int speed_i=0; speed_i<SLALOM_SPEED_NUM; speed_i++){
+            if(isTableSpeed(SHAPES[shape_i].shape, SLALOM_SPEEDS[speed_i])){
+                printArray(&SHAPES[shape_i], SLALOM_SPEEDS[speed_i]);
+            }
+        }
+    }
+
+    printf("const t_slalom_table SLALOM_TABLES[] = {\n");
+    for(int shape_i=0; shape_i<SHAPE_NUM; shape_i++){
+        const t_shape_entry *entry = &SHAPES[shape_i];
+        for(int speed_i=0; speed_i<SLALOM_SPEED_NUM; speed_i++){
+            const float speed = SLALOM_SPEEDS[speed_i];
+            if(isTableSpeed(entry->shape, speed) == FALSE){
+                continue;
+            }
+            t_scurve curve;
+            slalomCurve(&curve, entry->shape, speed);
+            int length = tableLength(&curve);
+            printf("    {%s, %.2f, %d, OMEGA_%s_%03d},\n",
+                    entry->shapeName, speed, length, entry->arrayName, (int)roundf(speed * 100.0));
+            tableNum++;
+            valueNum += length;
+        }
+    }
+    printf("};\n\n");
+    printf("const int SLALOM_TABLE_NUM = sizeof(SLALOM_TABLES) / sizeof(SLALOM_TABLES[0]);\n");
+
+    fprintf(stderr, "%d tables, %d values (%d bytes)\n",
+            tableNum, valueNum, valueNum * (int)sizeof(float));
+    return 0;
+}
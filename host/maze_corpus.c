@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "maze_corpus.h"
+
+// ベンチマーク用の迷路
+// 乱数の種から毎回同じ迷路を作るので、計画を変えたときに同じ迷路で比べられる
+
+static const int DX[4] = {0, 1, 0, -1}; // 方角ごとのX座標の変化
+static const int DY[4] = {1, 0, -1, 0}; // 方角ごとのY座標の変化
+
+static unsigned int nextRandom(unsigned int *state){
+    // xorshift32
+    // 標準ライブラリのrand()と違い、どの環境でも同じ迷路になる
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void removeWall(t_true_maze *maze, int x, int y, int dir){
+    // 座標x,yの方角dirの壁を、隣の区画の分と合わせて取り除く
+    int nextX = x + DX[dir];
+    int nextY = y + DY[dir];
+    if(nextX < 0 || nextX >= MAZESIZE_X || nextY < 0 || nextY >= MAZESIZE_Y){
+        return; // 一番外側の壁は残す
+    }
+    maze->isWall[x][y][dir] = FALSE;
+    maze->isWall[nextX][nextY][(dir + 2) % 4] = FALSE;
+}
+
+void generateMaze(t_true_maze *maze, const unsigned int seed){
+    // 穴掘り法で全区画がつながった迷路を作り、いくつか壁を抜いてループを作る
+    // ゴールは中央の2x2区画で、ゴールの中の壁はない
+    unsigned int state = seed * 2654435761u + 1;
+    static unsigned char visited[MAZESIZE_X][MAZESIZE_Y];
+    static t_cell stack[MAZESIZE_X * MAZESIZE_Y];
+
+    memset(maze->isWall, TRUE, sizeof(maze->isWall));
+    memset(visited, FALSE, sizeof(visited));
+
+    int stackNum = 0;
+    stack[stackNum].x = 0;
+    stack[stackNum].y = 0;
+    stackNum++;
+    visited[0][0] = TRUE;
+    while(stackNum > 0){
+        int x = stack[stackNum-1].x;
+        int y = stack[stackNum-1].y;
+        int dirs[4];
+        int dirNum = 0;
+        for(int dir=0; dir<4; dir++){
+            int nextX = x + DX[dir];
+            int nextY = y + DY[dir];
+            if(nextX >= 0 && nextX < MAZESIZE_X && nextY >= 0 && nextY < MAZESIZE_Y
+                    && visited[nextX][nextY] == FALSE){
+                dirs[dirNum++] = dir;
+            }
+        }
+        if(dirNum == 0){
+            stackNum--;
+            continue;
+        }
+        int dir = dirs[nextRandom(&state) % dirNum];
+        removeWall(maze, x, y, dir);
+        visited[x + DX[dir]][y + DY[dir]] = TRUE;
+        stack[stackNum].x = x + DX[dir];
+        stack[stackNum].y = y + DY[dir];
+        stackNum++;
+    }
+
+    // ループを作る
+    for(int loop_i=0; loop_i<MAZESIZE_X * MAZESIZE_Y / 16; loop_i++){
+        int x = nextRandom(&state) % MAZESIZE_X;
+        int y = nextRandom(&state) % MAZESIZE_Y;
+        removeWall(maze, x, y, nextRandom(&state) % 4);
+    }
+
+    maze->goal.x = MAZESIZE_X / 2 - 1;
+    maze->goal.y = MAZESIZE_Y / 2 - 1;
+    maze->goal.sizeX = 2;
+    maze->goal.sizeY = 2;
+    for(int x=maze->goal.x; x<maze->goal.x + maze->goal.sizeX; x++){
+        for(int y=maze->goal.y; y<maze->goal.y + maze->goal.sizeY; y++){
+            if(x + 1 < maze->goal.x + maze->goal.sizeX){
+                removeWall(maze, x, y, east);
+            }
+            if(y + 1 < maze->goal.y + maze->goal.sizeY){
+                removeWall(maze, x, y, north);
+            }
+        }
+    }
+
+    // スタート区画は東に壁があり、北にだけ出られる
+    maze->isWall[0][0][east] = maze->isWall[1][0][west] = TRUE;
+    removeWall(maze, 0, 0, north);
+}
+
+static void setEndGoal(t_true_maze *maze, int x, int y){
+    // 1本道の終わりの区画x,yだけをゴールにする
+    maze->goal.x = x;
+    maze->goal.y = y;
+    maze->goal.sizeX = 1;
+    maze->goal.sizeY = 1;
+}
+
+void generateSpiralMaze(t_true_maze *maze){
+    // スタートから外周を右回りに渦を巻いて中央で終わる1本道の迷路を作る
+    // 全区画を一筆書きで通るので、ゴールまでの歩数は区画数-1になる(歩数の最大値)
+    static unsigned char visited[MAZESIZE_X][MAZESIZE_Y];
+    memset(maze->isWall, TRUE, sizeof(maze->isWall));
+    memset(visited, FALSE, sizeof(visited));
+
+    int x = 0;
+    int y = 0;
+    int dir = north;
+    visited[x][y] = TRUE;
+    for(int cell_i=1; cell_i<MAZESIZE_X * MAZESIZE_Y; cell_i++){
+        // 壁か通った区画に当たったら右に曲がる
+        for(int turn_i=0; turn_i<4; turn_i++){
+            int nextX = x + DX[dir];
+            int nextY = y + DY[dir];
+            if(nextX >= 0 && nextX < MAZESIZE_X && nextY >= 0 && nextY < MAZESIZE_Y
+                    && visited[nextX][nextY] == FALSE){
+                break;
+            }
+            dir = (dir + 1) % 4;
+        }
+        removeWall(maze, x, y, dir);
+        x += DX[dir];
+        y += DY[dir];
+        visited[x][y] = TRUE;
+    }
+    setEndGoal(maze, x, y);
+}
+
+void generateSerpentineMaze(t_true_maze *maze){
+    // スタートから列ごとに北、南と折り返して進む1本道の迷路を作る
+    // 全区画を一筆書きで通るので、ゴールまでの歩数は区画数-1になる(歩数の最大値)
+    memset(maze->isWall, TRUE, sizeof(maze->isWall));
+
+    for(int x=0; x<MAZESIZE_X; x++){
+        for(int y=0; y<MAZESIZE_Y - 1; y++){
+            removeWall(maze, x, y, north);
+        }
+        // 北に進んだ列は北の端で、南に進んだ列は南の端で隣の列に移る
+        if(x + 1 < MAZESIZE_X){
+            removeWall(maze, x, (x % 2 == 0) ? MAZESIZE_Y - 1 : 0, east);
+        }
+    }
+    setEndGoal(maze, MAZESIZE_X - 1, (MAZESIZE_X % 2 == 0) ? 0 : MAZESIZE_Y - 1);
+}
+
+void senseWalls(const t_true_maze *maze, const t_position *mypos, 
+        int isWall[DIREC_NUM]){
+    // 区画mypos->x,yに向きmypos->dirで入ったときに、壁センサが読む壁を返す
+    const unsigned char *walls = maze->isWall[mypos->x][mypos->y];
+    isWall[DIREC_FRONT] = walls[mypos->dir];
+    isWall[DIREC_RIGHT] = walls[(mypos->dir + 1) % 4];
+    isWall[DIREC_BACK] = walls[(mypos->dir + 2) % 4];
+    isWall[DIREC_LEFT] = walls[(mypos->dir + 3) % 4];
+}
+
+int getTrueSteps(const t_true_maze *maze, const t_goal *goal){
+    // 正解の迷路で、スタートからゴールまでの最短の歩数を返す
+    // たどり着けなければ-1を返す
+    static int steps[MAZESIZE_X][MAZESIZE_Y];
+    static t_cell queue[MAZESIZE_X * MAZESIZE_Y];
+    int head = 0;
+    int tail = 0;
+    for(int x=0; x<MAZESIZE_X; x++){
+        for(int y=0; y<MAZESIZE_Y; y++){
+            steps[x][y] = -1;
+            if(isGoal(goal, x, y)){
+                steps[x][y] = 0;
+                queue[tail].x = x;
+                queue[tail].y = y;
+                tail++;
+            }
+        }
+    }
+    while(head < tail){
+        int x = queue[head].x;
+        int y = queue[head].y;
+        head++;
+        for(int dir=0; dir<4; dir++){
+            int nextX = x + DX[dir];
+            int nextY = y + DY[dir];
+            if(maze->isWall[x][y][dir] || nextX < 0 || nextX >= MAZESIZE_X 
+                    || nextY < 0 || nextY >= MAZESIZE_Y || steps[nextX][nextY] >= 0){
+                continue;
+            }
+            steps[nextX][nextY] = steps[x][y] + 1;
+            queue[tail].x = nextX;
+            queue[tail].y = nextY;
+            tail++;
+        }
+    }
+    return steps[0][0];
+}
+
+#define MAZE_FILE_LINE_MAX (MAZESIZE_X * 4 + 8) // 迷路ファイルの1行の最大の長さ
+
+static char getMazeChar(char lines[][MAZE_FILE_LINE_MAX], int row, int column){
+    // 迷路ファイルのrow行column文字目を返す
+    // 行末の空白が削られていても、範囲外は空白として扱う
+    if(column >= (int)strlen(lines[row])){
+        return ' ';
+    }
+    return lines[row][column];
+}
+
+int loadMazeFile(t_true_maze *maze, const char *path){
+    // 大会の迷路の公開でよく使われるテキスト形式の迷路を読み込む
+    // 柱は'o'か'+'、横の壁は"---"、縦の壁は'|'で、1区画を4文字x2行で書く
+    // 一番上の行が北の端で、ゴールの区画に'G'があればそこをゴールにする
+    // 32x32区画より小さい迷路は左下に置き、迷路の外の区画は壁で囲んでおく
+    static char lines[MAZESIZE_Y * 2 + 1][MAZE_FILE_LINE_MAX];
+    FILE *fp = fopen(path, "r");
+    if(fp == NULL){
+        return FALSE;
+    }
+    int lineNum = 0;
+    while(lineNum < MAZESIZE_Y * 2 + 1 && fgets(lines[lineNum], MAZE_FILE_LINE_MAX, fp) != NULL){
+        lines[lineNum][strcspn(lines[lineNum], "\r\n")] = '\0';
+        if(lineNum == 0 && strlen(lines[0]) == 0){
+            continue; // 先頭の空行は読み飛ばす
+        }
+        lineNum++;
+    }
+    fclose(fp);
+
+    int size = ((int)strlen(lines[0]) - 1) / 4;
+    if(size <= 0 || size > MAZESIZE_X || size > MAZESIZE_Y || lineNum < size * 2 + 1){
+        return FALSE;
+    }
+
+    memset(maze->isWall, TRUE, sizeof(maze->isWall));
+    int goalMinX = MAZESIZE_X, goalMinY = MAZESIZE_Y, goalMaxX = -1, goalMaxY = -1;
+    for(int row=0; row<size; row++){
+        for(int column=0; column<size; column++){
+            int x = column;
+            int y = size - 1 - row;
+            unsigned char *walls = maze->isWall[x][y];
+            walls[north] = getMazeChar(lines, row * 2, column * 4 + 2) == '-';
+            walls[south] = getMazeChar(lines, row * 2 + 2, column * 4 + 2) == '-';
+            walls[west] = getMazeChar(lines, row * 2 + 1, column * 4) == '|';
+            walls[east] = getMazeChar(lines, row * 2 + 1, column * 4 + 4) == '|';
+            char center = getMazeChar(lines, row * 2 + 1, column * 4 + 2);
+            if(center == 'G' || center == 'g'){
+                goalMinX = x < goalMinX ? x : goalMinX;
+                goalMinY = y < goalMinY ? y : goalMinY;
+                goalMaxX = x > goalMaxX ? x : goalMaxX;
+                goalMaxY = y > goalMaxY ? y : goalMaxY;
+            }
+        }
+    }
+
+    if(goalMaxX >= 0){
+        maze->goal.x = goalMinX;
+        maze->goal.y = goalMinY;
+        maze->goal.sizeX = goalMaxX - goalMinX + 1;
+        maze->goal.sizeY = goalMaxY - goalMinY + 1;
+    }else{
+        // ゴールの印がなければ、中央の区画(偶数なら2x2区画)をゴールにする
+        maze->goal.x = (size - 1) / 2;
+        maze->goal.y = (size - 1) / 2;
+        maze->goal.sizeX = 2 - size % 2;
+        maze->goal.sizeY = 2 - size % 2;
+    }
+    return TRUE;
+}
@@ -0,0 +1,21 @@
+#ifndef MAZE_CORPUS_H
+#define MAZE_CORPUS_H
+
+#include "maze_planner.h"
+
+// PC上で使う正解の迷路
+typedef struct
+{
+    unsigned char isWall[MAZESIZE_X][MAZESIZE_Y][4]; // 方角(north〜west)ごとの壁
+    t_goal goal;
+}t_true_maze;
+
+extern void generateMaze(t_true_maze *maze, const unsigned int seed);
+extern void generateSpiralMaze(t_true_maze *maze);
+extern void generateSerpentineMaze(t_true_maze *maze);
+extern void senseWalls(const t_true_maze *maze, const t_position *mypos, 
+        int isWall[DIREC_NUM]);
+extern int loadMazeFile(t_true_maze *maze, const char *path);
+extern int getTrueSteps(const t_true_maze *maze, const t_goal *goal);
+
+#endif
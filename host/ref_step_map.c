@@ -0,0 +1,49 @@
+#include "ref_step_map.h"
+
+// 以前のmain/maze.cのmakeStepMap()
+// 歩数が変わらなくなるまで迷路全体を走査し、歩数が決まった区画から隣の区画に広げる
+// ベンチマークで今のmakeStepMap()と速さを比べ、テストで歩数を比べるために残しておく
+//
+// 以前の作り方は、隣の区画に最初に書き込んだ歩数をそのまま使う
+// ループのある迷路では走査の順番によって遠回りの歩数が残るので、最短の歩数より大きくなることがある
+// isRelaxingがTRUEなら、小さい歩数が見つかったときに書き換えるので、最短の歩数になる
+
+void makeSweepStepMap(t_wall wallMap[MAZESIZE_X][MAZESIZE_Y], const t_goal *goal,
+        const int mask, const int isRelaxing, t_steps map[MAZESIZE_X][MAZESIZE_Y]){
+    for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+        for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+            map[x_i][y_i] = isGoal(goal, x_i, y_i) ? MIN_STEP : INIT_STEPS;
+        }
+    }
+
+    int isChanged;
+    do{
+        isChanged = FALSE;
+        for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+            for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+                if(map[x_i][y_i] == INIT_STEPS){
+                    continue;
+                }
+                t_steps nextSteps = map[x_i][y_i] + 1;
+                int nextX[4] = {x_i, x_i + 1, x_i, x_i - 1};
+                int nextY[4] = {y_i + 1, y_i, y_i - 1, y_i};
+                int isOpen[4] = {
+                    y_i < MAZESIZE_Y-1 && (wallMap[x_i][y_i].north & mask) == NOWALL,
+                    x_i < MAZESIZE_X-1 && (wallMap[x_i][y_i].east & mask) == NOWALL,
+                    y_i > 0 && (wallMap[x_i][y_i].south & mask) == NOWALL,
+                    x_i > 0 && (wallMap[x_i][y_i].west & mask) == NOWALL,
+                };
+                for(int dir=north; dir<=west; dir++){
+                    if(isOpen[dir] == FALSE){
+                        continue;
+                    }
+                    t_steps *steps = &map[nextX[dir]][nextY[dir]];
+                    if(*steps == INIT_STEPS || (isRelaxing && nextSteps < *steps)){
+                        *steps = nextSteps;
+                        isChanged = TRUE;
+                    }
+                }
+            }
+        }
+    }while(isChanged);
+}
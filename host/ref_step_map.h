@@ -0,0 +1,10 @@
+#ifndef REF_STEP_MAP_H
+#define REF_STEP_MAP_H
+
+#include "maze_planner.h"
+
+// 比べるための、以前の全区画を走査する歩数Mapの作り方
+extern void makeSweepStepMap(t_wall wallMap[MAZESIZE_X][MAZESIZE_Y], const t_goal *goal,
+        const int mask, const int isRelaxing, t_steps map[MAZESIZE_X][MAZESIZE_Y]);
+
+#endif
@@ -0,0 +1,332 @@
+#include <math.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "controller.h"
+#include "variables.h"
+#include "parameters.h"
+#include "sim_controller.h"
+
+// PC上のシミュレーション用の走行関数
+// controller.hの走行関数を、モータを回す代わりに所要時間を見積もって位置を動かす関数に置き換える
+// 所要時間はmaze.cの経路探索と同じtrajectory.cの見積もりを使うので、実時間を待たずに走り終わる
+// 走り終わるたびに、新しい位置で壁センサが読むはずの壁をgObsIsWallに入れる
+
+#define SIM_DT 0.0005 // ターンの軌跡を積分する刻み sec
+#define SIM_STEP 0.001 // 壁の通り抜けを調べる刻み meter
+#define HEADING_NUM 8 // 向きの数(45度ずつ)
+#define CONTROL_PERIOD 0.001 // 制御周期 sec
+
+static const int DX[4] = {0, 1, 0, -1}; // 方角ごとのX座標の変化
+static const int DY[4] = {1, 0, -1, 0}; // 方角ごとのY座標の変化
+
+static const t_true_maze *SimMaze; // 正解の迷路
+static double PoseX, PoseY; // 区画(0,0)の中心から見た位置 meter (東がX、北がY)
+static int PoseHeading; // 北から右回りに45度ずつ数えた向き
+static float PoseSpeed; // 直進速度 m/s
+static int PoseCellX, PoseCellY; // 今いる区画
+static t_sim_stats Stats;
+static unsigned char Visited[MAZESIZE_X][MAZESIZE_Y];
+
+static int isInMaze(int x, int y){
+    return x >= 0 && x < MAZESIZE_X && y >= 0 && y < MAZESIZE_Y;
+}
+
+static void visitCell(int x, int y){
+    if(isInMaze(x, y) && Visited[x][y] == FALSE){
+        Visited[x][y] = TRUE;
+        Stats.visitedCells++;
+    }
+}
+
+static void getCell(double x, double y, int *cellX, int *cellY){
+    *cellX = (int)floor(x / pCELL_DISTANCE + 0.5);
+    *cellY = (int)floor(y / pCELL_DISTANCE + 0.5);
+}
+
+static void setPosition(double x, double y){
+    // 位置を動かし、区画の境界を越えたらそこに壁がないか調べる
+    int cellX, cellY;
+    getCell(x, y, &cellX, &cellY);
+    if(cellX != PoseCellX || cellY != PoseCellY){
+        int crossDir = -1;
+        for(int dir=0; dir<4; dir++){
+            if(PoseCellX + DX[dir] == cellX && PoseCellY + DY[dir] == cellY){
+                crossDir = dir;
+            }
+        }
+        // 柱の上を越えたときや、迷路の外に出たときもぶつかったとみなす
+        if(crossDir < 0 || isInMaze(PoseCellX, PoseCellY) == FALSE
+                || SimMaze->isWall[PoseCellX][PoseCellY][crossDir]){
+            Stats.crashes++;
+        }
+        PoseCellX = cellX;
+        PoseCellY = cellY;
+        visitCell(cellX, cellY);
+    }
+    PoseX = x;
+    PoseY = y;
+}
+
+static double getHeadingAngle(int heading){
+    // 北から右回りの角度 rad
+    return heading * M_PI / 4.0;
+}
+
+static void moveStraight(const float distance){
+    // 今の向きにdistanceだけ進む
+    double angle = getHeadingAngle(PoseHeading);
+    double startX = PoseX;
+    double startY = PoseY;
+    int steps = (int)ceil(fabs(distance) / SIM_STEP);
+    for(int step_i=1; step_i<=steps; step_i++){
+        double moved = distance * step_i / steps;
+        setPosition(startX + moved * sin(angle), startY + moved * cos(angle));
+    }
+}
+
+static void moveTurn(const t_slalom *shape, const float speed, const int isTurnRight,
+        const int isExit){
+    // queueSlalomBase()と同じ角速度で軌跡をたどり、
+    // 最後は表の出口の位置と45度刻みの向きに合わせる
+    float startOffset = shape->startOffsetDistance;
+    float stopOffset = shape->stopOffsetDistance;
+    if(isExit){
+        startOffset = shape->stopOffsetDistance;
+        stopOffset = shape->startOffsetDistance;
+    }
+    t_scurve curve;
+    slalomCurve(&curve, shape, speed);
+    float turnAngle = curve.distance;
+    int turnSteps = (int)lround(turnAngle / (M_PI / 4.0));
+    double side = isTurnRight ? 1.0 : -1.0; // 右回りを正とする
+    double startX = PoseX;
+    double startY = PoseY;
+    double startAngle = getHeadingAngle(PoseHeading);
+
+    moveStraight(startOffset);
+    int steps = (int)ceil(curve.time / SIM_DT);
+    for(int step_i=0; step_i<steps; step_i++){
+        float angle, omega, alpha;
+        scurveSample(&curve, (step_i + 0.5) * SIM_DT, &angle, &omega, &alpha);
+        double worldAngle = startAngle + side * angle;
+        setPosition(PoseX + speed * sin(worldAngle) * SIM_DT,
+                PoseY + speed * cos(worldAngle) * SIM_DT);
+    }
+    double worldAngle = startAngle + side * turnAngle;
+    setPosition(PoseX + stopOffset * sin(worldAngle), PoseY + stopOffset * cos(worldAngle));
+
+    // 出口の位置はcheckFastTurn()と同じように、INの表の値から求める
+    double snapAngle = turnSteps * M_PI / 4.0;
+    double endX = shape->endX;
+    double endY = shape->endY;
+    if(isExit){
+        endX = shape->endX * cos(snapAngle) + shape->endY * sin(snapAngle);
+        endY = shape->endX * sin(snapAngle) - shape->endY * cos(snapAngle);
+    }
+    setPosition(startX + endX * sin(startAngle) + side * endY * cos(startAngle),
+            startY + endX * cos(startAngle) - side * endY * sin(startAngle));
+    PoseHeading = ((PoseHeading + (isTurnRight ? turnSteps : -turnSteps)) % HEADING_NUM
+            + HEADING_NUM) % HEADING_NUM;
+}
+
+static void senseWallsAhead(void){
+    // 向いている方向に1/4区画先の区画の壁を、その区画に入ったときの壁センサの値にする
+    // 斜めを向いているときは壁を読まない
+    if(PoseHeading % 2 != 0){
+        return;
+    }
+    double angle = getHeadingAngle(PoseHeading);
+    int cellX, cellY;
+    getCell(PoseX + pHALF_CELL_DISTANCE * 0.5 * sin(angle),
+            PoseY + pHALF_CELL_DISTANCE * 0.5 * cos(angle), &cellX, &cellY);
+    if(isInMaze(cellX, cellY) == FALSE){
+        return;
+    }
+    t_position pos;
+    pos.x = cellX;
+    pos.y = cellY;
+    pos.dir = PoseHeading / 2;
+    senseWalls(SimMaze, &pos, gObsIsWall);
+}
+
+static void finishMove(const double time, const float endSpeed){
+    Stats.time += time;
+    PoseSpeed = endSpeed;
+    senseWallsAhead();
+}
+
+void simStart(const t_true_maze *maze){
+    // スタート区画の中心で北を向いて止まっている状態にする
+    SimMaze = maze;
+    PoseX = PoseY = 0;
+    PoseHeading = north * 2;
+    PoseSpeed = 0;
+    PoseCellX = PoseCellY = 0;
+    memset(&Stats, 0, sizeof(Stats));
+    memset(Visited, FALSE, sizeof(Visited));
+    visitCell(0, 0);
+    senseWallsAhead();
+}
+
+void simGetStats(t_sim_stats *stats){
+    *stats = Stats;
+}
+
+void simGetCell(int *x, int *y){
+    *x = PoseCellX;
+    *y = PoseCellY;
+}
+
+void vTaskDelay(const TickType_t ticks){
+    // シミュレーションの時間は走行関数の所要時間だけで進め、待ち時間は数えない
+    (void)ticks;
+}
+
+int straight(const float targetDistance, const float endSpeed, const float timeout,
+        const float maxSpeed, const float accel){
+    (void)timeout;
+    double time = straightTime(targetDistance, PoseSpeed, endSpeed, maxSpeed, accel);
+    moveStraight(targetDistance);
+    finishMove(time, endSpeed);
+    return TRUE;
+}
+
+int turn(const float targetAngle, const float timeout){
+    // 左回りが正
+    (void)timeout;
+    int turnSteps = (int)lround(targetAngle / (M_PI / 4.0));
+    PoseHeading = ((PoseHeading - turnSteps) % HEADING_NUM + HEADING_NUM) % HEADING_NUM;
+    finishMove(turnTime(targetAngle), 0);
+    return TRUE;
+}
+
+int slalom(const int isTurnRight, const float endSpeed, const float timeout){
+    (void)timeout;
+    double time = slalomTime(&SEARCH_SLALOM, endSpeed);
+    moveTurn(&SEARCH_SLALOM, endSpeed, isTurnRight, FALSE);
+    finishMove(time, endSpeed);
+    return TRUE;
+}
+
+int fastSlalom(const int isTurnRight, const float endSpeed, const float timeout){
+    (void)timeout;
+    const t_slalom *fastTurn = &FAST_TURNS[FAST_TURN_SMALL90];
+    double time = slalomTime(fastTurn, endSpeed);
+    moveTurn(fastTurn, endSpeed, isTurnRight, FALSE);
+    finishMove(time, endSpeed);
+    return TRUE;
+}
+
+int fastTurn(const int type, const int isTurnRight, const int isExit,
+        const float speed, const float timeout){
+    // fastTurn()と同じく、遅い速度では同じ軌跡になるように角速度を変える
+    (void)timeout;
+    const t_slalom *fastTurn = &FAST_TURNS[type];
+    float turnSpeed = fastTurn->speed;
+    if(speed < turnSpeed){
+        turnSpeed = speed;
+    }
+    double time = slalomTime(fastTurn, turnSpeed);
+    moveTurn(fastTurn, turnSpeed, isTurnRight, isExit);
+    finishMove(time, turnSpeed);
+    return TRUE;
+}
+
+int straightBack(const float timeout){
+    // タイムアウトまで後ろの壁に押し付けるので、その時間だけ待つ
+    finishMove(timeout, 0);
+    return TRUE;
+}
+
+void keepSpeed(void){
+    moveStraight(PoseSpeed * CONTROL_PERIOD);
+    finishMove(CONTROL_PERIOD, PoseSpeed);
+}
+
+int searchStraight(const float distance, const float endSpeed){
+    return straight(distance, endSpeed, pSEARCH_TIMEOUT,
+            pSEARCH_MAX_SPEED, pSEARCH_ACCEL);
+}
+
+int searchKnownStraight(const float distance, const float endSpeed){
+    return straight(distance, endSpeed, pSEARCH_TIMEOUT + distance / pSEARCH_MAX_SPEED,
+            pFAST_STRAIGHT_MAX_SPEED, pFAST_ACCEL);
+}
+
+int fastStraight(const float distance, const float endSpeed){
+    return straight(distance, endSpeed, pFAST_TIMEOUT,
+            pFAST_STRAIGHT_MAX_SPEED, pFAST_ACCEL);
+}
+
+int diagonalStraight(const float distance, const float endSpeed){
+    return straight(distance, endSpeed, pFAST_TIMEOUT,
+            pFAST_DIAGONAL_MAX_SPEED, pFAST_ACCEL);
+}
+
+int ketsuate(const float endSpeed){
+    // 後ろの壁に押し付け、モータを止めてジャイロのバイアスをリセットしてから、
+    // 区画の中心まで進む
+    straightBack(pKETSU_TIMEOUT);
+    double time = 0.1 + straightTime(pKETSU_DISTANCE, 0, endSpeed,
+            pSEARCH_MAX_SPEED, pSEARCH_ACCEL);
+    setPosition(PoseCellX * pCELL_DISTANCE, PoseCellY * pCELL_DISTANCE);
+    finishMove(time, endSpeed);
+    return TRUE;
+}
+
+// 走行コマンドのキュー
+// 入れたその場で走り終えたことにして、番号だけ返す
+static int LastTicket = 0;
+
+int queueStraight(const float targetDistance, const float endSpeed, const float timeout,
+        const float maxSpeed, const float accel){
+    straight(targetDistance, endSpeed, timeout, maxSpeed, accel);
+    return ++LastTicket;
+}
+
+int queueTurn(const float targetAngle, const float timeout){
+    turn(targetAngle, timeout);
+    return ++LastTicket;
+}
+
+int queueSlalom(const int isTurnRight, const float endSpeed, const float timeout){
+    slalom(isTurnRight, endSpeed, timeout);
+    return ++LastTicket;
+}
+
+int queueFastTurn(const int type, const int isTurnRight, const int isExit,
+        const float speed, const float timeout){
+    fastTurn(type, isTurnRight, isExit, speed, timeout);
+    return ++LastTicket;
+}
+
+int queueSearchStraight(const float distance, const float endSpeed){
+    searchStraight(distance, endSpeed);
+    return ++LastTicket;
+}
+
+int queueSearchKnownStraight(const float distance, const float endSpeed){
+    searchKnownStraight(distance, endSpeed);
+    return ++LastTicket;
+}
+
+int queueFastStraight(const float distance, const float endSpeed){
+    fastStraight(distance, endSpeed);
+    return ++LastTicket;
+}
+
+int queueDiagonalStraight(const float distance, const float endSpeed){
+    diagonalStraight(distance, endSpeed);
+    return ++LastTicket;
+}
+
+int motionIsDone(const int ticket){
+    return (ticket <= LastTicket);
+}
+
+int motionWait(const int ticket){
+    return (ticket > 0);
+}
@@ -0,0 +1,18 @@
+#ifndef SIM_CONTROLLER_H
+#define SIM_CONTROLLER_H
+
+#include "maze_corpus.h"
+
+// シミュレーションの走行結果
+typedef struct
+{
+    double time; // 走行時間の合計 sec
+    int visitedCells; // 通った区画の数(同じ区画は1回だけ数える)
+    int crashes; // 壁を通り抜けた回数
+}t_sim_stats;
+
+extern void simStart(const t_true_maze *maze);
+extern void simGetStats(t_sim_stats *stats);
+extern void simGetCell(int *x, int *y);
+
+#endif
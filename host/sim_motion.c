@@ -0,0 +1,378 @@
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#include "controller.h"
+#include "variables.h"
+#include "parameters.h"
+#include "maze_corpus.h"
+#include "sim_plant.h"
+
+// 走行制御のシミュレーション
+// main/controller.cの走行関数をそのまま、sim_plant.cの車体モデルの上で走らせる
+// 走行ごとに、かかった時間と見積もり(trajectory.c)、止まった位置のずれ、
+// 目標速度への追従誤差を表示するので、制御を変えたときに前の結果と比べられる
+// その前に、trajectory.cのS字加減速が目標の距離と終端速度に届くか、
+// slalom_table.cの角速度の表が今のslalomCurve()と一致するか、
+// 固定ゲインのフィードフォワードが以前と同じか確かめる
+//
+// 使い方: sim_motion
+// S字加減速、表、フィードフォワードの確認に失敗するか、走行関数がタイムアウトするか、
+// スラロームで曲がった角度がずれたら、終了コードを1にする
+
+#define PROFILE_TOLERANCE 0.001 // S字加減速の距離の許容誤差 meter
+#define SLALOM_TABLE_TOLERANCE 0.001 // スラロームの表の角速度の許容誤差 rad/s
+#define SLALOM_ANGLE_TOLERANCE (0.5 * M_PI / 180.0) // 表の角速度の和と、曲がるべき角度の許容誤差 rad
+#define FEEDFORWARD_TOLERANCE 0.000001 // 固定ゲインのフィードフォワード電圧の許容誤差 V
+#define HEADING_TOLERANCE (1.0 * M_PI / 180.0) // スラロームで止まったときの向きの許容誤差 rad
+#define CORRIDOR_X 0 // 両側に壁がある通路の列
+#define FIELD_X 10 // 周りに壁がない区画
+#define FIELD_Y 10
+
+typedef struct
+{
+    const char *name;
+    // 走行関数を呼び、全て成功したらTRUEを返す
+    // 見積もった時間と、スタートから見た止まる位置(前がX、左がY)を返す
+    int (*run)(const int arg, float *estimatedTime, t_plant_pose *expected);
+    int arg;
+    int inCorridor; // 通路で走るならTRUE、周りに壁がない区画で走るならFALSE
+}t_scenario;
+
+static int runSearchStraight(const int arg, float *estimatedTime, t_plant_pose *expected){
+    // 探索と同じく、区画の中心から区画の境界をまたいで走り、区画の中心で止まる
+    const float speed = pSEARCH_MAX_SPEED;
+    const int cells = arg;
+    int result = TRUE;
+    result &= searchStraight(pHALF_CELL_DISTANCE, speed);
+    result &= searchStraight(pCELL_DISTANCE * (cells - 1), speed);
+    result &= searchStraight(pHALF_CELL_DISTANCE, 0);
+    *estimatedTime = straightTime(pHALF_CELL_DISTANCE, 0, speed, pSEARCH_MAX_SPEED, pSEARCH_ACCEL)
+        + straightTime(pCELL_DISTANCE * (cells - 1), speed, speed, pSEARCH_MAX_SPEED, pSEARCH_ACCEL)
+        + straightTime(pHALF_CELL_DISTANCE, speed, 0, pSEARCH_MAX_SPEED, pSEARCH_ACCEL);
+    expected->x = pCELL_DISTANCE * cells;
+    return result;
+}
+
+static int runFastStraight(const int arg, float *estimatedTime, t_plant_pose *expected){
+    const float distance = pCELL_DISTANCE * arg;
+    int result = fastStraight(distance, 0);
+    *estimatedTime = straightTime(distance, 0, 0, pFAST_STRAIGHT_MAX_SPEED, pFAST_ACCEL);
+    expected->x = distance;
+    return result;
+}
+
+static int runTurn(const int arg, float *estimatedTime, t_plant_pose *expected){
+    // argは左回りを正とした角度 deg
+    const float angle = arg * M_PI / 180.0;
+    int result = turn(angle, pSEARCH_TIMEOUT);
+    *estimatedTime = turnTime(angle);
+    expected->angle = angle;
+    return result;
+}
+
+static int runSlalom(const int arg, float *estimatedTime, t_plant_pose *expected){
+    // 区画の中心から、スラロームで隣の区画の中心まで走る
+    // argがTRUEなら右に曲がる
+    const float speed = pSEARCH_MAX_SPEED;
+    const int isTurnRight = arg;
+    int result = TRUE;
+    result &= searchStraight(pHALF_CELL_DISTANCE, speed);
+    result &= slalom(isTurnRight, speed, pSEARCH_TIMEOUT);
+    result &= searchStraight(pHALF_CELL_DISTANCE, 0);
+    *estimatedTime = straightTime(pHALF_CELL_DISTANCE, 0, speed, pSEARCH_MAX_SPEED, pSEARCH_ACCEL)
+        + slalomTime(&SEARCH_SLALOM, speed)
+        + straightTime(pHALF_CELL_DISTANCE, speed, 0, pSEARCH_MAX_SPEED, pSEARCH_ACCEL);
+    expected->x = pCELL_DISTANCE;
+    expected->y = isTurnRight ? -pCELL_DISTANCE : pCELL_DISTANCE;
+    expected->angle = isTurnRight ? -M_PI_2 : M_PI_2;
+    return result;
+}
+
+static int runFastTurn(const int arg, float *estimatedTime, t_plant_pose *expected){
+    // 2区画分の直線で表の速度まで加速してから左にターンし、2区画分の直線で止まる
+    // 斜めの区間はqueueDiagonalStraight()で走る
+    const t_slalom *shape = &FAST_TURNS[arg];
+    const float distance = pCELL_DISTANCE * 2;
+    const float speed = shape->speed;
+    float turnAngle = slalomNominalAngle(shape);
+    int isStartDiagonal = (arg == FAST_TURN_V90);
+    int isEndDiagonal = (arg == FAST_TURN_45 || arg == FAST_TURN_135 || arg == FAST_TURN_V90);
+    float startMaxSpeed = isStartDiagonal ? pFAST_DIAGONAL_MAX_SPEED : pFAST_STRAIGHT_MAX_SPEED;
+    float endMaxSpeed = isEndDiagonal ? pFAST_DIAGONAL_MAX_SPEED : pFAST_STRAIGHT_MAX_SPEED;
+
+    // fastRun()と同じく、3つともキューに入れてから走り終わるのを待つ
+    int tickets[3];
+    tickets[0] = isStartDiagonal ? queueDiagonalStraight(distance, speed) : queueFastStraight(distance, speed);
+    tickets[1] = queueFastTurn(arg, FALSE, FALSE, speed, pFAST_TIMEOUT);
+    tickets[2] = isEndDiagonal ? queueDiagonalStraight(distance, 0) : queueFastStraight(distance, 0);
+    int result = TRUE;
+    for(int ticket_i=0; ticket_i<3; ticket_i++){
+        result &= motionWait(tickets[ticket_i]);
+    }
+    *estimatedTime = straightTime(distance, 0, speed, startMaxSpeed, pFAST_ACCEL)
+        + fastTurnTime(arg)
+        + straightTime(distance, speed, 0, endMaxSpeed, pFAST_ACCEL);
+    expected->x = distance + shape->endX + distance * cos(turnAngle);
+    expected->y = shape->endY + distance * sin(turnAngle);
+    expected->angle = turnAngle;
+    return result;
+}
+
+static const t_scenario SCENARIOS[] = {
+    {"search straight 1", runSearchStraight, 1, TRUE},
+    {"search straight 4", runSearchStraight, 4, TRUE},
+    {"fast straight 8", runFastStraight, 8, TRUE},
+    {"fast straight 15", runFastStraight, 15, TRUE},
+    {"turn left 90", runTurn, 90, FALSE},
+    {"turn right 90", runTurn, -90, FALSE},
+    {"turn 180", runTurn, 180, FALSE},
+    {"slalom left", runSlalom, FALSE, FALSE},
+    {"slalom right", runSlalom, TRUE, FALSE},
+    {"fast small 90", runFastTurn, FAST_TURN_SMALL90, FALSE},
+    {"fast large 90", runFastTurn, FAST_TURN_LARGE90, FALSE},
+    {"fast 180", runFastTurn, FAST_TURN_180, FALSE},
+    {"fast 45", runFastTurn, FAST_TURN_45, FALSE},
+    {"fast 135", runFastTurn, FAST_TURN_135, FALSE},
+    {"fast V90", runFastTurn, FAST_TURN_V90, FALSE},
+};
+
+static int checkProfiles(void){
+    // S字加減速を制御周期ごとに取り出して速度を積分し、
+    // 目標の距離と終端速度に届くか、加速度とジャークが上限を守るかを確かめる
+    // 距離が短すぎて終端速度まで加減速しきれない組み合わせは数えない
+    const float DISTANCES[] = {0.01, 0.045, 0.09, 0.18, 0.45, 1.35};
+    const float SPEEDS[] = {0, 0.2, 0.4, 1.0};
+    const float MAX_SPEEDS[] = {0.5, 1.0, 2.0};
+    const float ACCELS[] = {1.0, 1.5, 3.0};
+    const float DT = 0.001; // 制御周期 sec
+    int cases = 0;
+    int failures = 0;
+    float maxDistanceError = 0;
+    float maxSpeedError = 0;
+    float maxAccelOver = 0; // 加速度の上限を超えた量
+    float maxJerkOver = 0; // ジャークの上限を超えた量
+
+    for(size_t d_i=0; d_i<sizeof(DISTANCES)/sizeof(DISTANCES[0]); d_i++)
+    for(size_t s_i=0; s_i<sizeof(SPEEDS)/sizeof(SPEEDS[0]); s_i++)
+    for(size_t e_i=0; e_i<sizeof(SPEEDS)/sizeof(SPEEDS[0]); e_i++)
+    for(size_t m_i=0; m_i<sizeof(MAX_SPEEDS)/sizeof(MAX_SPEEDS[0]); m_i++)
+    for(size_t a_i=0; a_i<sizeof(ACCELS)/sizeof(ACCELS[0]); a_i++){
+        float distance = DISTANCES[d_i];
+        float startSpeed = SPEEDS[s_i];
+        float endSpeed = SPEEDS[e_i];
+        float maxSpeed = MAX_SPEEDS[m_i];
+        float accel = ACCELS[a_i];
+        float jerk = accel / pJERK_TIME;
+        if(startSpeed > maxSpeed || endSpeed > maxSpeed){
+            continue;
+        }
+        // 速度を変えるだけで進む距離
+        t_scurve curve;
+        float position, speed, acceleration;
+        scurvePlan(&curve, 0, startSpeed, endSpeed, maxSpeed, accel, jerk);
+        scurveSample(&curve, curve.time, &position, &speed, &acceleration);
+        if(position > distance){
+            continue;
+        }
+
+        scurvePlan(&curve, distance, startSpeed, endSpeed, maxSpeed, accel, jerk);
+        double integrated = 0;
+        float prevTime = 0;
+        float prevSpeed = startSpeed;
+        float prevAccel = 0;
+        int isFailed = FALSE;
+        for(int tick=1; prevTime < curve.time; tick++){
+            float time = fminf(tick * DT, curve.time);
+            scurveSample(&curve, time, &position, &speed, &acceleration);
+            integrated += (prevSpeed + speed) * 0.5 * (time - prevTime);
+            float accelOver = fabsf(acceleration) - accel;
+            float jerkOver = fabsf(acceleration - prevAccel) / (time - prevTime) - jerk;
+            maxAccelOver = fmaxf(maxAccelOver, accelOver);
+            maxJerkOver = fmaxf(maxJerkOver, jerkOver);
+            if(accelOver > accel * 0.01 || jerkOver > jerk * 0.01){
+                isFailed = TRUE;
+            }
+            prevTime = time;
+            prevSpeed = speed;
+            prevAccel = acceleration;
+        }
+
+        float distanceError = fmaxf(fabs(integrated - distance), fabsf(position - distance));
+        float speedError = fabsf(speed - endSpeed);
+        maxDistanceError = fmaxf(maxDistanceError, distanceError);
+        maxSpeedError = fmaxf(maxSpeedError, speedError);
+        if(distanceError > PROFILE_TOLERANCE || speedError > 0.001){
+            isFailed = TRUE;
+        }
+        if(isFailed){
+            printf("profile NG: distance %.3f start %.2f end %.2f max %.2f accel %.1f"
+                    "  error %.3f mm %.4f m/s\n",
+                    distance, startSpeed, endSpeed, maxSpeed, accel,
+                    distanceError * 1000.0, speedError);
+        }
+        cases++;
+        failures += isFailed;
+    }
+
+    printf("profile check: %d cases  distance error %.4f mm  end speed error %.5f m/s"
+            "  accel over %.4f m/ss  jerk over %.4f m/sss%s\n",
+            cases, maxDistanceError * 1000.0, maxSpeedError, maxAccelOver, maxJerkOver,
+            failures > 0 ? "  NG" : "");
+    return failures;
+}
+
+static int checkSlalomTables(void){
+    // slalom_table.cの表を作り直した結果と比べて、表が古くなっていないか確かめる
+    // FAST_TURNSやpSLALOM_JERK_TIMEを変えて作り直し忘れると、表の長さか角速度がずれる
+    // 表の角速度の和が、曲がるべき角度(探索のスラロームは90度)になるかも確かめる
+    // 角度のフィードバックは表の角度に合わせるので、表の角度がずれていると直せない
+    int failures = 0;
+    float maxOmegaError = 0;
+    float maxAngleError = 0;
+
+    for(int table_i=0; table_i<SLALOM_TABLE_NUM; table_i++){
+        const t_slalom_table *table = &SLALOM_TABLES[table_i];
+        t_scurve curve;
+        slalomCurve(&curve, table->shape, table->speed);
+        int length = (int)ceilf(curve.time / SLALOM_TABLE_PERIOD);
+        float omegaError = 0;
+        float angle = 0;
+        if(length == table->length){
+            for(int tick=0; tick<length; tick++){
+                omegaError = fmaxf(omegaError,
+                        fabsf(table->omega[tick] - slalomTableOmega(&curve, tick)));
+                angle += table->omega[tick] * SLALOM_TABLE_PERIOD;
+            }
+        }
+        float angleError = fabsf(angle - slalomNominalAngle(table->shape));
+        int isFailed = (length != table->length || omegaError > SLALOM_TABLE_TOLERANCE
+                || angleError > SLALOM_ANGLE_TOLERANCE);
+        if(isFailed){
+            printf("slalom table NG: table %d speed %.2f  length %d (expected %d)"
+                    "  omega error %.5f rad/s  angle %.2f deg (expected %.2f deg)\n",
+                    table_i, table->speed, table->length, length, omegaError,
+                    angle * 180.0 / M_PI, slalomNominalAngle(table->shape) * 180.0 / M_PI);
+        }
+        maxOmegaError = fmaxf(maxOmegaError, omegaError);
+        maxAngleError = fmaxf(maxAngleError, angleError);
+        failures += isFailed;
+    }
+
+    printf("slalom table check: %d tables  omega error %.5f rad/s  angle error %.5f rad%s\n",
+            SLALOM_TABLE_NUM, maxOmegaError, maxAngleError, failures > 0 ? "  NG" : "");
+    return failures;
+}
+
+static int checkFeedforward(void){
+    // pFEEDFORWARD_MODELが0のとき、フィードフォワード電圧が以前の固定ゲインの式と同じか確かめる
+    // 以前は速度に1.5 V/(m/s)、角速度に0.02 V/(rad/s)をかけ、加速度は使っていなかった
+    // モデルを有効にしたときは、固定ゲインの経路を通らないので確かめない
+    const float BASE_SPEED_GAIN = 1.5;
+    const float BASE_OMEGA_GAIN = 0.02;
+    const float SPEEDS[] = {-0.2, 0, 0.2, 0.5, 1.5, 3.0}; // m/s
+    const float OMEGAS[] = {-20.0, -M_PI, 0, 0.3 * M_PI, 8.0, 20.0}; // rad/s
+    const float ACCELS[] = {-20.0, 0, 5.0, 20.0}; // m/s^2 (角加速度はこの100倍 rad/s^2)
+    int cases = 0;
+    int failures = 0;
+    float maxError = 0;
+
+    if(pFEEDFORWARD_MODEL){
+        printf("feedforward check: model enabled, fixed-gain check skipped\n");
+        return 0;
+    }
+    for(size_t speed_i=0; speed_i<sizeof(SPEEDS)/sizeof(SPEEDS[0]); speed_i++){
+        for(size_t omega_i=0; omega_i<sizeof(OMEGAS)/sizeof(OMEGAS[0]); omega_i++){
+            for(size_t accel_i=0; accel_i<sizeof(ACCELS)/sizeof(ACCELS[0]); accel_i++){
+                float speed = SPEEDS[speed_i];
+                float omega = OMEGAS[omega_i];
+                float voltage[SIDE_NUM];
+                calcFeedforwardVoltage(speed, omega, ACCELS[accel_i], ACCELS[accel_i] * 100.0, voltage);
+                float error = fmaxf(
+                        fabsf(voltage[RIGHT] - (speed * BASE_SPEED_GAIN + omega * BASE_OMEGA_GAIN)),
+                        fabsf(voltage[LEFT] - (speed * BASE_SPEED_GAIN - omega * BASE_OMEGA_GAIN)));
+                if(error > FEEDFORWARD_TOLERANCE){
+                    printf("feedforward NG: speed %.2f omega %.2f accel %.1f  error %.6f V\n",
+                            speed, omega, ACCELS[accel_i], error);
+                    failures++;
+                }
+                maxError = fmaxf(maxError, error);
+                cases++;
+            }
+        }
+    }
+    printf("feedforward check: %d cases  error %.6f V%s\n",
+            cases, maxError, failures > 0 ? "  NG" : "");
+    return failures;
+}
+
+static void makeField(t_true_maze *maze){
+    // 一番外側の壁と、CORRIDOR_Xの列を通路にする壁だけがある迷路
+    memset(maze->isWall, FALSE, sizeof(maze->isWall));
+    for(int i=0; i<MAZESIZE_X; i++){
+        maze->isWall[i][0][south] = TRUE;
+        maze->isWall[i][MAZESIZE_Y-1][north] = TRUE;
+    }
+    for(int i=0; i<MAZESIZE_Y; i++){
+        maze->isWall[0][i][west] = TRUE;
+        maze->isWall[MAZESIZE_X-1][i][east] = TRUE;
+        maze->isWall[CORRIDOR_X][i][east] = TRUE;
+        maze->isWall[CORRIDOR_X+1][i][west] = TRUE;
+    }
+}
+
+int main(void){
+    static t_true_maze maze;
+    int failures = checkProfiles();
+    failures += checkSlalomTables();
+    failures += checkFeedforward();
+    makeField(&maze);
+
+    printf("%-18s %6s %6s %7s %7s %7s %7s %7s %7s %7s\n",
+            "", "time", "est", "dx(mm)", "dy(mm)", "da(deg)",
+            "v max", "v rms", "w max", "w rms");
+    for(size_t scenario_i=0; scenario_i<sizeof(SCENARIOS)/sizeof(SCENARIOS[0]); scenario_i++){
+        const t_scenario *scenario = &SCENARIOS[scenario_i];
+        // 北を向いて区画の中心に置く
+        // 斜めから始まるターンは、北西を向けて置く
+        t_plant_pose start = {0, pCELL_DISTANCE, M_PI_2};
+        if(scenario->inCorridor == FALSE){
+            start.x = FIELD_X * pCELL_DISTANCE;
+            start.y = FIELD_Y * pCELL_DISTANCE;
+        }
+        if(scenario->run == runFastTurn && scenario->arg == FAST_TURN_V90){
+            start.angle += M_PI_4;
+        }
+        plantStart(&maze, &start);
+
+        float estimatedTime = 0;
+        t_plant_pose expected = {0, 0, 0};
+        int result = scenario->run(scenario->arg, &estimatedTime, &expected);
+
+        // スタートの向きから見た、止まった位置のずれ
+        t_plant_pose end;
+        t_plant_stats stats;
+        plantGetPose(&end);
+        plantGetStats(&stats);
+        double moveX = end.x - start.x;
+        double moveY = end.y - start.y;
+        double forward = moveX * cos(start.angle) + moveY * sin(start.angle);
+        double left = -moveX * sin(start.angle) + moveY * cos(start.angle);
+        double angleError = end.angle - start.angle - expected.angle;
+
+        // 角度のフィードバックをかけるスラロームは、止まったときの向きが
+        // 曲がるべき角度からずれていないか確かめる
+        int isSlalom = (scenario->run == runSlalom || scenario->run == runFastTurn);
+        int isHeadingOk = isSlalom == FALSE || fabs(angleError) <= HEADING_TOLERANCE;
+        printf("%-18s %6.3f %6.3f %7.2f %7.2f %7.2f %7.3f %7.3f %7.3f %7.3f%s\n",
+                scenario->name, stats.time, estimatedTime,
+                (forward - expected.x) * 1000.0, (left - expected.y) * 1000.0,
+                angleError * 180.0 / M_PI,
+                stats.maxSpeedError, stats.rmsSpeedError,
+                stats.maxOmegaError, stats.rmsOmegaError,
+                (result && isHeadingOk) ? "" : "  NG");
+        failures += (result == FALSE || isHeadingOk == FALSE);
+    }
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,289 @@
+#include <math.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "observer.h"
+#include "variables.h"
+#include "parameters.h"
+#include "sim_plant.h"
+
+// PC上の車体モデル
+// モータの電気系と機械系、車体の質量と慣性モーメント、壁センサの電圧を1 kHzで計算する
+// main/のcontroller.cとobserver.cをそのまま動かすために、
+// vTaskDelay()とclock()を、実時間ではなくシミュレーションの時間で進める
+//
+// 1 msごとに、gMotorDutyから車体を動かしてエンコーダ、ジャイロ、壁センサの値を作り、
+// TaskObservation()と同じ順に観測値を更新する
+
+#define PLANT_TICK 0.001 // 制御周期 sec
+#define PLANT_SUBSTEPS 100 // 制御周期あたりの積分回数(モータの電気的時定数より細かくする)
+#define WALL_HALF_THICKNESS 0.006 // 壁の厚さの半分 meter
+#define SENSOR_RANGE 0.25 // 壁センサが壁を見る最大の距離 meter
+#define SENSOR_MIN_DISTANCE 0.005 // 壁センサの電圧を計算する最小の距離 meter
+
+// 車体のパラメータ
+// 実機で測っていない値は、controller.cのフィードフォワードゲインと合うように決めている
+typedef struct
+{
+    float resistance; // モータの巻線抵抗 ohm
+    float inductance; // モータのインダクタンス H
+    float backEmfConstant; // 逆起電力定数 V/(rad/s)
+    float torqueConstant; // トルク定数 Nm/A
+    float frictionTorque; // 動摩擦トルク(モータ軸) Nm
+    float viscousFriction; // 粘性摩擦係数(モータ軸) Nm/(rad/s)
+    float rotorInertia; // ロータの慣性モーメント kg m^2
+    float gearRatio; // 減速比
+    float mass; // 車体の質量 kg
+    float inertia; // 車体の鉛直軸周りの慣性モーメント kg m^2
+    float tread; // 左右のタイヤの間隔 meter
+    float batteryVoltage; // バッテリー電圧 volts
+}t_plant_params;
+
+static const t_plant_params PLANT = {
+    .resistance = 4.0,
+    .inductance = 0.0001,
+    .backEmfConstant = 0.008,
+    .torqueConstant = 0.008,
+    .frictionTorque = 0.0002,
+    .viscousFriction = 0.000001,
+    .rotorInertia = 0.00000001,
+    .gearRatio = 1.0,
+    .mass = 0.025,
+    .inertia = 0.000008,
+    .tread = 0.028,
+    .batteryVoltage = 4.0,
+};
+
+// 壁センサの取り付け位置と向き、距離と電圧の関係
+// 電圧は距離の2乗に反比例するとし、区画の中心で横の壁を見たときに
+// observer.cの壁制御の基準値になるよう係数を決めている
+typedef struct
+{
+    float forward; // 車体中心から前方向の位置 meter
+    float left; // 車体中心から左方向の位置 meter
+    float angle; // 前を0とした左回りの向き rad
+    float gain; // 電圧 = gain / 距離^2 (volts m^2)
+}t_wall_sensor;
+
+static const t_wall_sensor WALL_SENSORS[OBJ_SENS_NUM] = {
+    [OBJ_SENS_FL] = {0.025,  0.012, 0.0,     0.000522},
+    [OBJ_SENS_L]  = {0.020,  0.010, M_PI_2,  0.000436},
+    [OBJ_SENS_R]  = {0.020, -0.010, -M_PI_2, 0.000473},
+    [OBJ_SENS_FR] = {0.025, -0.012, 0.0,     0.000522},
+};
+
+static const t_true_maze *PlantMaze; // 正解の迷路
+static double SimTime; // シミュレーションの時刻 sec
+static t_plant_pose Pose;
+static double Speed; // 車体の直進速度 m/s
+static double Omega; // 車体の角速度 rad/s
+static double Current[SIDE_NUM]; // モータ電流 A
+static double WheelAngle[SIDE_NUM]; // タイヤの回転角度(前進が正) rad
+static t_plant_stats Stats;
+static double SumSpeedError2, SumOmegaError2;
+static long StatsTicks;
+
+static double getWallDistance(double originX, double originY, double angle){
+    // 点originから向きangleに進んで、最初に当たる壁の面までの距離を返す
+    // 壁は区画の境界の線分とし、壁の厚さの分だけ手前で当たるとする
+    const double CELL = pCELL_DISTANCE;
+    double dirX = cos(angle);
+    double dirY = sin(angle);
+    int originCellX = (int)floor(originX / CELL + 0.5);
+    int originCellY = (int)floor(originY / CELL + 0.5);
+    int range = (int)ceil(SENSOR_RANGE / CELL);
+    double nearest = INFINITY;
+
+    for(int x=originCellX - range; x<=originCellX + range; x++){
+        for(int y=originCellY - range; y<=originCellY + range; y++){
+            if(x < 0 || x >= MAZESIZE_X || y < 0 || y >= MAZESIZE_Y){
+                continue;
+            }
+            for(int dir=0; dir<4; dir++){
+                if(PlantMaze->isWall[x][y][dir] == FALSE){
+                    continue;
+                }
+                // 区画の境界の線分: 北と南は横向き、東と西は縦向き
+                double lineX = x * CELL;
+                double lineY = y * CELL;
+                int isHorizontal = (dir == north || dir == south);
+                if(dir == north){ lineY += CELL * 0.5; }
+                if(dir == south){ lineY -= CELL * 0.5; }
+                if(dir == east){ lineX += CELL * 0.5; }
+                if(dir == west){ lineX -= CELL * 0.5; }
+
+                double along = isHorizontal ? dirY : dirX; // 壁の法線方向の成分
+                if(fabs(along) < 1e-9){
+                    continue;
+                }
+                double t = isHorizontal ? (lineY - originY) / along : (lineX - originX) / along;
+                if(t <= 0){
+                    continue;
+                }
+                double hit = isHorizontal ? originX + dirX * t : originY + dirY * t;
+                double center = isHorizontal ? lineX : lineY;
+                if(fabs(hit - center) > CELL * 0.5){
+                    continue;
+                }
+                double distance = t - WALL_HALF_THICKNESS / fabs(along);
+                if(distance < nearest){
+                    nearest = distance;
+                }
+            }
+        }
+    }
+    return nearest;
+}
+
+static void updateWallSensors(void){
+    // 壁センサの電圧を、壁までの距離から計算する
+    for(int sensor_i=0; sensor_i<OBJ_SENS_NUM; sensor_i++){
+        const t_wall_sensor *sensor = &WALL_SENSORS[sensor_i];
+        double originX = Pose.x + sensor->forward * cos(Pose.angle) - sensor->left * sin(Pose.angle);
+        double originY = Pose.y + sensor->forward * sin(Pose.angle) + sensor->left * cos(Pose.angle);
+        double distance = getWallDistance(originX, originY, Pose.angle + sensor->angle);
+        if(distance > SENSOR_RANGE){
+            gObjVoltages[sensor_i] = 0;
+            continue;
+        }
+        if(distance < SENSOR_MIN_DISTANCE){
+            distance = SENSOR_MIN_DISTANCE;
+        }
+        gObjVoltages[sensor_i] = sensor->gain / (distance * distance);
+    }
+}
+
+static void updateEncoders(void){
+    // エンコーダは0〜2πの角度を返し、左は取り付け向きの都合で符号が逆になる
+    gWheelAngle[RIGHT] = fmod(fmod(WheelAngle[RIGHT], 2.0 * M_PI) + 2.0 * M_PI, 2.0 * M_PI);
+    gWheelAngle[LEFT] = fmod(fmod(-WheelAngle[LEFT], 2.0 * M_PI) + 2.0 * M_PI, 2.0 * M_PI);
+}
+
+static void stepDynamics(const double dt){
+    // モータの電圧から電流、トルク、車体の加速度を計算して、dtだけ進める
+    // タイヤは滑らないとする
+    const double radius = pTIRE_RADIUS;
+    const double gear = PLANT.gearRatio;
+    // ロータの慣性を車体の質量と慣性モーメントに足す
+    double rotorMass = PLANT.rotorInertia * gear * gear / (radius * radius);
+    double mass = PLANT.mass + 2.0 * rotorMass;
+    double inertia = PLANT.inertia + 2.0 * rotorMass * PLANT.tread * PLANT.tread * 0.25;
+
+    double wheelSpeed[SIDE_NUM];
+    wheelSpeed[RIGHT] = Speed + Omega * PLANT.tread * 0.5;
+    wheelSpeed[LEFT] = Speed - Omega * PLANT.tread * 0.5;
+
+    double force[SIDE_NUM];
+    for(int side_i=0; side_i<SIDE_NUM; side_i++){
+        double voltage = 0;
+        if(gMotorState == MOTOR_ON){
+            double duty = fmax(fmin(gMotorDuty[side_i], 100.0), -100.0);
+            voltage = duty * 0.01 * PLANT.batteryVoltage;
+        }
+        double motorOmega = wheelSpeed[side_i] * gear / radius;
+        if(gMotorState == MOTOR_ON){
+            Current[side_i] += (voltage - PLANT.resistance * Current[side_i]
+                    - PLANT.backEmfConstant * motorOmega) / PLANT.inductance * dt;
+        }else{
+            // モータドライバがスリープすると電流は流れない
+            Current[side_i] = 0;
+        }
+        // 停止付近で符号が振動しないよう、動摩擦をなめらかに切り替える
+        double torque = PLANT.torqueConstant * Current[side_i]
+            - PLANT.frictionTorque * tanh(motorOmega / 10.0)
+            - PLANT.viscousFriction * motorOmega;
+        force[side_i] = torque * gear / radius;
+    }
+
+    Speed += (force[RIGHT] + force[LEFT]) / mass * dt;
+    Omega += (force[RIGHT] - force[LEFT]) * PLANT.tread * 0.5 / inertia * dt;
+
+    WheelAngle[RIGHT] += wheelSpeed[RIGHT] / radius * dt;
+    WheelAngle[LEFT] += wheelSpeed[LEFT] / radius * dt;
+    Pose.x += Speed * cos(Pose.angle) * dt;
+    Pose.y += Speed * sin(Pose.angle) * dt;
+    Pose.angle += Omega * dt;
+}
+
+static void updateStats(void){
+    float speedError = fabs(gTargetSpeed - Speed);
+    float omegaError = fabs(gTargetOmega - Omega);
+    if(speedError > Stats.maxSpeedError){
+        Stats.maxSpeedError = speedError;
+    }
+    if(omegaError > Stats.maxOmegaError){
+        Stats.maxOmegaError = omegaError;
+    }
+    SumSpeedError2 += speedError * speedError;
+    SumOmegaError2 += omegaError * omegaError;
+    StatsTicks++;
+}
+
+static void stepPlant(void){
+    // 1制御周期だけ車体を動かし、センサの値と観測値を更新する
+    for(int step_i=0; step_i<PLANT_SUBSTEPS; step_i++){
+        stepDynamics(PLANT_TICK / PLANT_SUBSTEPS);
+    }
+    SimTime += PLANT_TICK;
+
+    updateEncoders();
+    gGyro[AXIS_Z] = Omega;
+    gBatteryVoltage = PLANT.batteryVoltage;
+    gGyroBiasResetRequest = 0; // バイアスはないので、すぐにリセットが終わる
+    updateWallSensors();
+
+    batteryObservation();
+    movingDistanceObservation();
+    angleObservation();
+    wallObservation();
+    wallErrorObservation();
+
+    updateStats();
+}
+
+void vTaskDelay(const TickType_t ticks){
+    // 待つ代わりに、待つ時間だけ車体を動かす
+    for(TickType_t tick_i=0; tick_i<ticks * portTICK_PERIOD_MS; tick_i++){
+        stepPlant();
+    }
+}
+
+clock_t simClock(void){
+    // controller.cとobserver.cのclock()を置き換え、シミュレーションの時刻を返す
+    return (clock_t)(SimTime * CLOCKS_PER_SEC);
+}
+
+void plantStart(const t_true_maze *maze, const t_plant_pose *pose){
+    // 車体を止めてposeに置き、追従誤差の集計を始める
+    // エンコーダの角度は観測値の計算が続くように、前の値を引き継ぐ
+    PlantMaze = maze;
+    Pose = *pose;
+    Speed = 0;
+    Omega = 0;
+    Current[RIGHT] = Current[LEFT] = 0;
+    gMotorState = MOTOR_ON;
+    gMotorDuty[RIGHT] = gMotorDuty[LEFT] = 0;
+    // 置いた位置のセンサの値で観測値を更新する
+    vTaskDelay(1);
+    gObsMovingDistance = 0;
+
+    memset(&Stats, 0, sizeof(Stats));
+    SumSpeedError2 = SumOmegaError2 = 0;
+    StatsTicks = 0;
+    Stats.time = SimTime;
+}
+
+void plantGetPose(t_plant_pose *pose){
+    *pose = Pose;
+}
+
+void plantGetStats(t_plant_stats *stats){
+    *stats = Stats;
+    stats->time = SimTime - Stats.time;
+    if(StatsTicks > 0){
+        stats->rmsSpeedError = sqrt(SumSpeedError2 / StatsTicks);
+        stats->rmsOmegaError = sqrt(SumOmegaError2 / StatsTicks);
+    }
+}
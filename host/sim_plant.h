@@ -0,0 +1,32 @@
+#ifndef SIM_PLANT_H
+#define SIM_PLANT_H
+
+#include <time.h>
+
+#include "maze_corpus.h"
+
+// 車体の位置
+// 区画(0,0)の中心が原点で、東がX、北がY
+typedef struct
+{
+    double x; // meter
+    double y; // meter
+    double angle; // 東を0とした左回りの角度 rad
+}t_plant_pose;
+
+// 目標速度への追従誤差
+typedef struct
+{
+    double time; // 経過時間 sec
+    float maxSpeedError; // 直進速度の誤差の最大値 m/s
+    float maxOmegaError; // 角速度の誤差の最大値 rad/s
+    float rmsSpeedError; // 直進速度の誤差の二乗平均平方根 m/s
+    float rmsOmegaError; // 角速度の誤差の二乗平均平方根 rad/s
+}t_plant_stats;
+
+extern void plantStart(const t_true_maze *maze, const t_plant_pose *pose);
+extern void plantGetPose(t_plant_pose *pose);
+extern void plantGetStats(t_plant_stats *stats);
+extern clock_t simClock(void);
+
+#endif
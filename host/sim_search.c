@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "maze.h"
+#include "controller.h"
+#include "maze_corpus.h"
+#include "sim_controller.h"
+
+// 探索走行と最短走行のシミュレーション
+// main/maze.cのsearch()とrun()を、正解の迷路の上でsim_controller.cの走行関数を使って走らせる
+// 走行時間は見積もりで進めるので、実時間を待たずに何百もの迷路を回せる
+//
+// 使い方: sim_search [--no-slalom] [--no-diagonal] [迷路ファイル ...]
+// 迷路ファイルがなければ、bench_plannerと同じ乱数の種から作った迷路を使う
+
+#define GENERATED_MAZE_NUM 100 // 迷路ファイルがないときに作る迷路の数
+
+typedef struct
+{
+    int mazes; // 走らせた迷路の数
+    int failures; // ぶつかった、壁を読み違えた、ゴールに着かなかった迷路の数
+    double searchTime; // 探索走行(スタートに戻るまで)の時間の合計 sec
+    double fastTime; // 最短走行の時間の合計 sec
+    long visitedCells; // 探索で通った区画の数の合計
+}t_sim_total;
+
+static int countWallMismatches(const t_true_maze *maze){
+    // 探索で書き込んだ壁のうち、正解の迷路と違うものを数える
+    // 仮想の壁(VWALL)は通らない区画をふさいだだけなので数えない
+    int mismatches = 0;
+    for(int x=0; x<MAZESIZE_X; x++){
+        for(int y=0; y<MAZESIZE_Y; y++){
+            for(int dir=0; dir<4; dir++){
+                int wall = getWall(x, y, dir);
+                if((wall == WALL && maze->isWall[x][y][dir] == FALSE)
+                        || (wall == NOWALL && maze->isWall[x][y][dir] == TRUE)){
+                    mismatches++;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+static void simulateMaze(const char *name, const t_true_maze *maze,
+        const int slalomEnable, const int diagonalEnable, t_sim_total *total){
+    // 探索してスタートに戻り、そのあと最短走行でゴールまで走る
+    t_goal goal = maze->goal;
+    t_sim_stats searchStats, fastStats;
+    int x, y;
+
+    simStart(maze);
+    initMaze();
+    search(&goal, slalomEnable, TRUE);
+    simGetStats(&searchStats);
+    simGetCell(&x, &y);
+    int isHome = (x == 0 && y == 0);
+    int mismatches = countWallMismatches(maze);
+
+    simStart(maze);
+    run(&goal, slalomEnable, diagonalEnable, FALSE);
+    simGetStats(&fastStats);
+    simGetCell(&x, &y);
+    int isGoalReached = isGoal(&goal, x, y);
+
+    int crashes = searchStats.crashes + fastStats.crashes;
+    int isFailed = crashes > 0 || mismatches > 0 || isHome == FALSE || isGoalReached == FALSE;
+    printf("%-24s search %7.2f s  fast %6.3f s  visited %4d  crash %d  mismatch %d%s\n",
+            name, searchStats.time, fastStats.time, searchStats.visitedCells,
+            crashes, mismatches, isFailed ? "  NG" : "");
+
+    total->mazes++;
+    total->failures += isFailed;
+    total->searchTime += searchStats.time;
+    total->fastTime += fastStats.time;
+    total->visitedCells += searchStats.visitedCells;
+}
+
+int main(int argc, char *argv[]){
+    static t_true_maze maze;
+    t_sim_total total = {0};
+    int slalomEnable = TRUE;
+    int diagonalEnable = TRUE;
+    int fileNum = 0;
+
+    // ターンの軌跡が区画の中心線に乗っているか、先に確かめておく
+    checkSearchSlalom();
+    for(int type=0; type<FAST_TURN_NUM; type++){
+        checkFastTurn(type, FALSE);
+        checkFastTurn(type, TRUE);
+    }
+
+    for(int arg_i=1; arg_i<argc; arg_i++){
+        if(strcmp(argv[arg_i], "--no-slalom") == 0){
+            slalomEnable = FALSE;
+        }else if(strcmp(argv[arg_i], "--no-diagonal") == 0){
+            diagonalEnable = FALSE;
+        }else if(loadMazeFile(&maze, argv[arg_i]) == TRUE){
+            simulateMaze(argv[arg_i], &maze, slalomEnable, diagonalEnable, &total);
+            fileNum++;
+        }else{
+            fprintf(stderr, "Cannot load maze file %s\n", argv[arg_i]);
+            total.failures++;
+            fileNum++;
+        }
+    }
+
+    if(fileNum == 0){
+        for(int seed=0; seed<GENERATED_MAZE_NUM; seed++){
+            char name[32];
+            snprintf(name, sizeof(name), "seed %d", seed);
+            generateMaze(&maze, seed);
+            simulateMaze(name, &maze, slalomEnable, diagonalEnable, &total);
+        }
+    }
+
+    if(total.mazes > 0){
+        printf("mazes %d  failures %d  search %.2f s/maze  fast %.3f s/maze  visited %.1f cells/maze\n",
+                total.mazes, total.failures, total.searchTime / total.mazes,
+                total.fastTime / total.mazes, (double)total.visitedCells / total.mazes);
+    }
+    return total.failures > 0 ? 1 : 0;
+}
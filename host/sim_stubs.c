@@ -0,0 +1,83 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+
+#include "logger.h"
+
+// PC上のシミュレーション用のFreeRTOSとlogger.cの代わり
+// 計画タスクと制御タスクは作らないので、maze.cのgetNextMove()はその場で計画し、
+// controller.cの走行関数は呼び出し側で1 msごとに制御する
+// vTaskDelay()はシミュレーションごとに時間の進め方が違うので、それぞれで定義する
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name,
+        const uint32_t stackDepth, void *arg, UBaseType_t priority,
+        TaskHandle_t *handle, const BaseType_t coreId){
+    (void)task; (void)name; (void)stackDepth; (void)arg;
+    (void)priority; (void)handle; (void)coreId;
+    return pdFALSE;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void){
+    return NULL;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCount, TickType_t ticks){
+    (void)clearCount; (void)ticks;
+    return 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task){
+    (void)task;
+    return pdPASS;
+}
+
+int esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *handle){
+    (void)args;
+    *handle = NULL;
+    return 0;
+}
+
+int esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period){
+    (void)timer; (void)period;
+    return 0;
+}
+
+QueueHandle_t xQueueCreate(const UBaseType_t length, const UBaseType_t itemSize){
+    (void)length; (void)itemSize;
+    return NULL;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks){
+    (void)queue; (void)item; (void)ticks;
+    return pdFALSE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks){
+    (void)queue; (void)item; (void)ticks;
+    return pdFALSE;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item){
+    (void)queue; (void)item;
+    return pdFALSE;
+}
+
+int loggingSaveWallAsync(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]){
+    // 保存はしないが、書き込みを頼めたことにする
+    (void)wallMap;
+    return 1;
+}
+
+int loggingLoadWall(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]){
+    (void)wallMap;
+    return FALSE;
+}
+
+void loggingDeleteWall(void){
+}
+
+int loggingWaitWrite(const int ticket, const int timeout_msec){
+    (void)ticket; (void)timeout_msec;
+    return TRUE;
+}
@@ -0,0 +1,7 @@
+#ifndef ADC_H
+#define ADC_H
+
+// PC上でmain/のコードをビルドするためのESP-IDFの代わり
+// observer.cはADCの関数を使わないので、何も定義しない
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+// PC上でmain/のコードをビルドするためのESP-IDFの代わり
+// 大量の迷路を回すので、エラーと警告だけを標準エラー出力に出す
+
+#include <stdio.h>
+
+#define ESP_LOG_INFO 3
+
+#define ESP_LOGE(tag, format, ...) fprintf(stderr, "E (%s) " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) fprintf(stderr, "W (%s) " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ((void)(tag))
+#define ESP_LOGD(tag, format, ...) ((void)(tag))
+
+#endif
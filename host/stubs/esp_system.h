@@ -0,0 +1,6 @@
+#ifndef ESP_SYSTEM_H
+#define ESP_SYSTEM_H
+
+// PC上でmain/のコードをビルドするためのESP-IDFの代わり
+
+#endif
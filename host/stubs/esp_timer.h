@@ -0,0 +1,20 @@
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include <stdint.h>
+
+typedef void *esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef struct
+{
+    esp_timer_cb_t callback;
+    void *arg;
+    int dispatch_method;
+    const char *name;
+}esp_timer_create_args_t;
+
+extern int esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *handle);
+extern int esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+// PC上でmain/のコードをビルドするためのFreeRTOSの代わり
+// 使っている型とマクロだけを定義する
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *QueueHandle_t;
+
+extern QueueHandle_t xQueueCreate(const UBaseType_t length, const UBaseType_t itemSize);
+extern BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks);
+extern BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
+extern BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item);
+
+#endif
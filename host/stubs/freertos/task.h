@@ -0,0 +1,17 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+extern void vTaskDelay(const TickType_t ticks);
+extern BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name,
+        const uint32_t stackDepth, void *arg, UBaseType_t priority,
+        TaskHandle_t *handle, const BaseType_t coreId);
+extern TaskHandle_t xTaskGetCurrentTaskHandle(void);
+extern uint32_t ulTaskNotifyTake(BaseType_t clearCount, TickType_t ticks);
+extern BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+#endif
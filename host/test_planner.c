@@ -0,0 +1,281 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "maze_planner.h"
+#include "maze_corpus.h"
+#include "ref_step_map.h"
+
+// 探索の計画のテスト
+// 迷路を作って壁の一部を読んだ状態にし、歩数Mapを別の作り方と比べる
+// 迷路の中を歩きながら壁を読み、壁が変わった分だけ直した歩数Mapと進む方向を、作り直した場合と比べる
+// 一筆書きの迷路で、最大の歩数がt_stepsに収まり未到達の値と重ならないことを確かめる
+//
+// 使い方: test_planner [迷路の数]
+// 1つでも一致しなければ、終了コードを1にする
+
+#define KNOWN_PERCENTS_NUM 4
+#define WALK_LENGTH (MAZESIZE_X * MAZESIZE_Y) // 1つの迷路で歩く区画数
+static const int KNOWN_PERCENTS[KNOWN_PERCENTS_NUM] = {0, 30, 70, 100}; // 読んだ壁の割合 %
+static const int MASKS[2] = {MASK_SEARCH, MASK_SECOND};
+
+static unsigned int nextRandom(unsigned int *state){
+    // xorshift32
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static void setWallSide(t_wall *wall, const int dir, const int value){
+    switch(dir){
+        case north: wall->north = value; break;
+        case east: wall->east = value; break;
+        case south: wall->south = value; break;
+        default: wall->west = value; break;
+    }
+}
+
+static void makeKnownWallMap(const t_true_maze *maze, const int knownPercent, unsigned int seed,
+        t_wall wallMap[MAZESIZE_X][MAZESIZE_Y]){
+    // 正解の迷路の壁のうち、knownPercent %だけを読んだ壁情報を作る
+    // 区画の境界の両側は同じ値にし、一番外側の壁は初めからわかっている
+    unsigned int state = seed * 2654435761u + 1;
+    initMaze();
+    getWallMap(wallMap);
+    for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+        for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+            for(int dir=north; dir<=east; dir++){
+                int nextX, nextY;
+                if(getNeighbor(x_i, y_i, dir, &nextX, &nextY) == FALSE
+                        || (int)(nextRandom(&state) % 100) >= knownPercent){
+                    continue;
+                }
+                int wall = CONV_SEN2WALL(maze->isWall[x_i][y_i][dir]);
+                setWallSide(&wallMap[x_i][y_i], dir, wall);
+                setWallSide(&wallMap[nextX][nextY], (dir + 2) % 4, wall);
+            }
+        }
+    }
+}
+
+static int checkSweep(const int mazeNum){
+    // makeStepMap()の歩数が、以前の走査で小さい歩数に書き換えていく作り方と一致するか確かめる
+    // 以前の作り方そのもの(最初に書き込んだ歩数を残す)は遠回りの歩数が残ることがあるので、
+    // 今の歩数がそれより大きくならず、辿り着ける区画が同じことだけを確かめる
+    static t_true_maze maze;
+    static t_wall wallMap[MAZESIZE_X][MAZESIZE_Y];
+    static t_steps exactMap[MAZESIZE_X][MAZESIZE_Y];
+    static t_steps sweepMap[MAZESIZE_X][MAZESIZE_Y];
+    int cases = 0;
+    int failures = 0;
+    long longerCells = 0; // 以前の作り方で遠回りの歩数になった区画の数
+
+    for(int maze_i=0; maze_i<mazeNum; maze_i++){
+        generateMaze(&maze, maze_i);
+        for(int known_i=0; known_i<KNOWN_PERCENTS_NUM; known_i++){
+            makeKnownWallMap(&maze, KNOWN_PERCENTS[known_i], maze_i, wallMap);
+            setWallMap(wallMap);
+            for(int mask_i=0; mask_i<2; mask_i++){
+                const int mask = MASKS[mask_i];
+                makeStepMap(&maze.goal, mask);
+                makeSweepStepMap(wallMap, &maze.goal, mask, TRUE, exactMap);
+                makeSweepStepMap(wallMap, &maze.goal, mask, FALSE, sweepMap);
+
+                int mismatches = 0;
+                for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+                    for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+                        t_steps steps = getSteps(x_i, y_i);
+                        if(steps != exactMap[x_i][y_i]
+                                || steps > sweepMap[x_i][y_i]
+                                || (steps == INIT_STEPS) != (sweepMap[x_i][y_i] == INIT_STEPS)){
+                            mismatches++;
+                        }
+                        longerCells += (steps < sweepMap[x_i][y_i]);
+                    }
+                }
+                if(mismatches > 0){
+                    printf("sweep NG: maze %d known %d%% mask %d  %d cells\n",
+                            maze_i, KNOWN_PERCENTS[known_i], mask, mismatches);
+                }
+                cases++;
+                failures += (mismatches > 0);
+            }
+        }
+    }
+
+    printf("sweep check (%dx%d): %d cases  %ld cells longer in the old sweep%s\n",
+            MAZESIZE_X, MAZESIZE_Y, cases, longerCells, failures > 0 ? "  NG" : "");
+    return failures;
+}
+
+static void movePosition(const t_direction dir, t_position *mypos){
+    int nextX, nextY;
+    getNeighbor(mypos->x, mypos->y, dir, &nextX, &nextY);
+    mypos->x = nextX;
+    mypos->y = nextY;
+    mypos->dir = dir;
+}
+
+static t_direction selectWalkDirection(const t_true_maze *maze, const t_position *mypos,
+        unsigned char isVisited[MAZESIZE_X][MAZESIZE_Y], unsigned int *state){
+    // 正解の迷路で通れる方向から1つ選ぶ。まだ通っていない区画があればそちらを選ぶ
+    // 計画の結果とは関係なく歩くので、作り直す場合と同じ順番で壁を読める
+    t_direction dirs[4];
+    int dirNum = 0;
+    int isNewFound = FALSE;
+    for(int dir=north; dir<=west; dir++){
+        int nextX, nextY;
+        if(maze->isWall[mypos->x][mypos->y][dir]
+                || getNeighbor(mypos->x, mypos->y, dir, &nextX, &nextY) == FALSE){
+            continue;
+        }
+        int isNew = (isVisited[nextX][nextY] == FALSE);
+        if(isNew && isNewFound == FALSE){
+            dirNum = 0; // 通っていない区画の方向だけから選び直す
+            isNewFound = TRUE;
+        }
+        if(isNew || isNewFound == FALSE){
+            dirs[dirNum++] = dir;
+        }
+    }
+    return dirs[nextRandom(state) % dirNum];
+}
+
+static void walkMaze(const t_true_maze *maze, const int mask, const int seed, const int isIncremental,
+        t_direction nextDirs[WALK_LENGTH], t_steps stepMaps[WALK_LENGTH][MAZESIZE_X][MAZESIZE_Y]){
+    // 迷路を歩きながら壁を読み、区画ごとにgetNextDirection()で進む方向を決める
+    // isIncrementalがFALSEなら、毎回makeStepMap()で歩数Mapを作り直す
+    // 区画ごとに、進む方向をnextDirsに、歩数MapをstepMapsに残す
+    static unsigned char isVisited[MAZESIZE_X][MAZESIZE_Y];
+    unsigned int state = seed * 2654435761u + 1;
+    t_position pos = {0, 0, north};
+
+    initMaze();
+    for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+        for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+            isVisited[x_i][y_i] = FALSE;
+        }
+    }
+    isVisited[0][0] = TRUE;
+    getNextDirection(&maze->goal, mask, &pos.dir, &pos);
+
+    for(int walk_i=0; walk_i<WALK_LENGTH; walk_i++){
+        movePosition(selectWalkDirection(maze, &pos, isVisited, &state), &pos);
+        isVisited[pos.x][pos.y] = TRUE;
+
+        int isWall[DIREC_NUM];
+        senseWalls(maze, &pos, isWall);
+        setWall(&maze->goal, &pos, isWall);
+        if(isIncremental == FALSE){
+            makeStepMap(&maze->goal, mask);
+        }
+        t_direction dir = pos.dir;
+        getNextDirection(&maze->goal, mask, &dir, &pos);
+        nextDirs[walk_i] = dir;
+        for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+            for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+                stepMaps[walk_i][x_i][y_i] = getSteps(x_i, y_i);
+            }
+        }
+    }
+}
+
+static int checkIncremental(const int mazeNum){
+    // 壁を読むたびにupdateStepMap()で直した歩数Mapと進む方向が、
+    // makeStepMap()で作り直した場合と一致するか確かめる
+    static t_true_maze maze;
+    static t_direction incrementalDirs[WALK_LENGTH];
+    static t_direction rebuiltDirs[WALK_LENGTH];
+    static t_steps incrementalMaps[WALK_LENGTH][MAZESIZE_X][MAZESIZE_Y];
+    static t_steps rebuiltMaps[WALK_LENGTH][MAZESIZE_X][MAZESIZE_Y];
+    int cases = 0;
+    int failures = 0;
+
+    for(int maze_i=0; maze_i<mazeNum; maze_i++){
+        generateMaze(&maze, maze_i);
+        for(int mask_i=0; mask_i<2; mask_i++){
+            const int mask = MASKS[mask_i];
+            walkMaze(&maze, mask, maze_i, TRUE, incrementalDirs, incrementalMaps);
+            walkMaze(&maze, mask, maze_i, FALSE, rebuiltDirs, rebuiltMaps);
+
+            int mapMismatches = 0;
+            int dirMismatches = 0;
+            for(int walk_i=0; walk_i<WALK_LENGTH; walk_i++){
+                dirMismatches += (incrementalDirs[walk_i] != rebuiltDirs[walk_i]);
+                for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+                    for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+                        mapMismatches += (incrementalMaps[walk_i][x_i][y_i] != rebuiltMaps[walk_i][x_i][y_i]);
+                    }
+                }
+            }
+            if(mapMismatches > 0 || dirMismatches > 0){
+                printf("incremental NG: maze %d mask %d  %d cells  %d directions\n",
+                        maze_i, mask, mapMismatches, dirMismatches);
+            }
+            cases++;
+            failures += (mapMismatches > 0 || dirMismatches > 0);
+        }
+    }
+
+    printf("incremental check (%dx%d): %d cases  %d walls read per case%s\n",
+            MAZESIZE_X, MAZESIZE_Y, cases, WALK_LENGTH, failures > 0 ? "  NG" : "");
+    return failures;
+}
+
+static int checkStepMapRange(const t_true_maze *maze, const t_goal *goal, const t_goal *from,
+        const int mask){
+    // 全ての壁を読んだ迷路で、区画fromの歩数が一筆書きの長さ(区画数-1)になり、
+    // どの区画の歩数も未到達の値(INIT_STEPS)にならないか確かめる
+    static t_wall wallMap[MAZESIZE_X][MAZESIZE_Y];
+    makeKnownWallMap(maze, 100, 0, wallMap);
+    setWallMap(wallMap);
+    makeStepMap(goal, mask);
+
+    int mismatches = 0;
+    for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+        for(int y_i=0; y_i<MAZESIZE_Y; y_i++){
+            t_steps steps = getSteps(x_i, y_i);
+            mismatches += (steps == INIT_STEPS || steps > MAZESIZE_X * MAZESIZE_Y - 1);
+        }
+    }
+    mismatches += (getSteps(from->x, from->y) != MAZESIZE_X * MAZESIZE_Y - 1);
+    return mismatches;
+}
+
+static int checkWorstCase(void){
+    // 全区画を一筆書きで通る迷路で、歩数が区画数-1まで数えられるか確かめる
+    static t_true_maze maze;
+    const int maxSteps = MAZESIZE_X * MAZESIZE_Y - 1;
+    const char *names[2] = {"spiral", "serpentine"};
+    int failures = 0;
+
+    for(int maze_i=0; maze_i<2; maze_i++){
+        if(maze_i == 0){
+            generateSpiralMaze(&maze);
+        }else{
+            generateSerpentineMaze(&maze);
+        }
+        int trueSteps = getTrueSteps(&maze, &maze.goal);
+        int mismatches = (trueSteps != maxSteps);
+        for(int mask_i=0; mask_i<2; mask_i++){
+            // スタートからゴール、ゴールからスタートの両方向
+            mismatches += checkStepMapRange(&maze, &maze.goal, &START_GOAL, MASKS[mask_i]);
+            mismatches += checkStepMapRange(&maze, &START_GOAL, &maze.goal, MASKS[mask_i]);
+        }
+        printf("worst case %s (%dx%d): %d steps, t_steps max %d%s\n", names[maze_i],
+                MAZESIZE_X, MAZESIZE_Y, trueSteps, (int)INIT_STEPS, mismatches > 0 ? "  NG" : "");
+        failures += (mismatches > 0);
+    }
+    return failures;
+}
+
+int main(int argc, char **argv){
+    int mazeNum = (argc > 1) ? atoi(argv[1]) : 100;
+    int failures = 0;
+    failures += checkSweep(mazeNum);
+    failures += checkIncremental(mazeNum);
+    failures += checkWorstCase();
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
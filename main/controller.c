@@ -1,12 +1,14 @@
 
 #include <stdio.h>
 #include <math.h>
-#include <time.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 
 #include "motion.h"
+#include "controller.h"
 #include "variables.h"
 #include "parameters.h"
 
@@ -28,6 +30,9 @@ typedef struct{
     int forceOmegaEnable;
     float forceSpeed;
     float forceOmega;
+    float forceAccel; // forceSpeedの計画上の加速度 m/s^2(フィードフォワード用)
+    float forceAlpha; // forceOmegaの計画上の角加速度 rad/s^2(フィードフォワード用)
+    float feedbackOmega; // forceOmegaのうち、角度のフィードバックで足した分(フィードフォワードには使わない)
     float enableWallControl;
     int initializeSumOfError;
 
@@ -40,38 +45,85 @@ typedef struct{
 
 }controlGain_t;
 
-void updateController(control_t *control){
-    const controlGain_t speedGain = {6.0, 0.0, 0.0}; // i= 0.1
-    const controlGain_t omegaGain = {0.50, 0.00002, 0.0}; // p = 0.5
+static void calcModelFeedforward(const float speed, const float omega,
+        const float accel, const float alpha, float voltage[SIDE_NUM]){
+    // 目標の速度と加速度から、モータモデルで左右のモータ電圧を計算する
+    // 車体を加速させる力を左右のタイヤに分け、タイヤの力からモータのトルク、電流、電圧の順に求める
+    const t_motor_model *model = &pMOTOR_MODEL;
+    const float FRICTION_OMEGA = 10.0; // rad/s モータ軸がこれより遅いときは、動摩擦を速度に比例させる
+    float wheelSpeed[SIDE_NUM];
+    float wheelForce[SIDE_NUM];
+
+    wheelSpeed[RIGHT] = speed + omega * model->tread * 0.5;
+    wheelSpeed[LEFT] = speed - omega * model->tread * 0.5;
+    // 直進は m a = F_R + F_L、回転は I α = (F_R - F_L) T/2
+    wheelForce[RIGHT] = model->mass * accel * 0.5 + model->inertia * alpha / model->tread;
+    wheelForce[LEFT] = model->mass * accel * 0.5 - model->inertia * alpha / model->tread;
 
-    // フィードフォワードパラメータ
+    for(int side_i=0; side_i<SIDE_NUM; side_i++){
+        float motorOmega = wheelSpeed[side_i] * model->gearRatio / pTIRE_RADIUS;
+        float friction = model->frictionTorque
+            * fmaxf(-1.0, fminf(motorOmega / FRICTION_OMEGA, 1.0))
+            + model->viscousFriction * motorOmega;
+        float torque = wheelForce[side_i] * pTIRE_RADIUS / model->gearRatio + friction;
+        float current = torque / model->torqueConstant;
+        voltage[side_i] = current * model->resistance + model->backEmfConstant * motorOmega;
+    }
+}
+
+void calcFeedforwardVoltage(const float speed, const float omega,
+        const float accel, const float alpha, float voltage[SIDE_NUM]){
+    // 目標の速度、角速度と計画上の加速度から、左右のモータのフィードフォワード電圧を計算する
+    // pFEEDFORWARD_MODELが0なら、速度と角速度に固定のゲインをかける(加速度のゲインは0)
     const float SPEED_FF_GAIN = 1.5;
     const float SPEED_ACCEL_FF_GAIN = 0.0;
     const float OMEGA_FF_GAIN = 0.02;
     const float OMEGA_ACCEL_FF_GAIN = 0;
+
+    if(pFEEDFORWARD_MODEL){
+        calcModelFeedforward(speed, omega, accel, alpha, voltage);
+        return;
+    }
+    float voltageSpeedFF = speed * SPEED_FF_GAIN + accel * SPEED_ACCEL_FF_GAIN;
+    float voltageOmegaFF = omega * OMEGA_FF_GAIN + alpha * OMEGA_ACCEL_FF_GAIN;
+    voltage[RIGHT] = voltageSpeedFF + voltageOmegaFF;
+    voltage[LEFT] = voltageSpeedFF - voltageOmegaFF;
+}
+
+void updateController(control_t *control){
+    const controlGain_t speedGain = {6.0, 0.0, 0.0}; // i= 0.1
+    const controlGain_t omegaGain = {0.50, 0.00002, 0.0}; // p = 0.5
+
+    // フィードフォワードはcalcFeedforwardVoltage()で計算する
     const float OMEGA_WALL_GAIN = 0.5;
 
-    static float prevTargetSpeed = 0;
-    static float prevTargetOmega = 0;
+    // 計画上の加速度(フィードフォワード用)
+    float targetAccel = 0;
+    float targetAlpha = 0;
 
     // 直進方向の速度更新
     if(control->forceSpeedEnable){
         // 強制的に目標速度を設定する
         if(control->invertSpeed){
             TargetSpeed = -control->forceSpeed;
+            targetAccel = -control->forceAccel;
         }else{
             TargetSpeed = control->forceSpeed;
+            targetAccel = control->forceAccel;
         }
     }else{
         // 目標速度を更新する
         if(control->invertSpeed){
             TargetSpeed -= control->accelSpeed * 0.001; // 1 msec周期なので、加速度を1/1000倍する
+            targetAccel = -control->accelSpeed;
         }else{
             TargetSpeed += control->accelSpeed * 0.001; // 1 msec周期なので、加速度を1/1000倍する
+            targetAccel = control->accelSpeed;
         }
 
         if(fabs(TargetSpeed) > control->maxSpeed){
             TargetSpeed = copysign(control->maxSpeed, TargetSpeed);
+            targetAccel = 0;
         }
     }
     // 回転方向の速度更新
@@ -79,20 +131,25 @@ void updateController(control_t *control){
         // 強制的に目標速度を設定する
         if(control->invertOmega){
             TargetOmega = -control->forceOmega;
+            targetAlpha = -control->forceAlpha;
         }else{
             TargetOmega = control->forceOmega;
+            targetAlpha = control->forceAlpha;
         }
     }else{
         // 目標速度を更新する
         if(control->invertOmega){
             TargetOmega -= control->accelOmega* 0.001; // 1 msec周期なので、加速度を1/1000倍する
+            targetAlpha = -control->accelOmega;
         }else{
             TargetOmega += control->accelOmega* 0.001; // 1 msec周期なので、加速度を1/1000倍する
+            targetAlpha = control->accelOmega;
 
         }
 
         if(fabs(TargetOmega) > control->maxOmega){
             TargetOmega = copysign(control->maxOmega, TargetOmega);
+            targetAlpha = 0;
         }
     }
 
@@ -122,16 +179,17 @@ void updateController(control_t *control){
         sumOmegaError = 0;
     }
 
-    // 直進速度のフィードフォワード
-    float voltageSpeedFF = TargetSpeed * SPEED_FF_GAIN 
-        + (TargetSpeed - prevTargetSpeed) * SPEED_ACCEL_FF_GAIN;
-    MotorVoltage[RIGHT] += voltageSpeedFF;
-    MotorVoltage[LEFT]  += voltageSpeedFF;
-    // 角速度のフィードフォワード
-    float voltageOmegaFF = TargetOmega * OMEGA_FF_GAIN 
-        + (TargetOmega - prevTargetOmega) * OMEGA_ACCEL_FF_GAIN;;
-    MotorVoltage[RIGHT] += voltageOmegaFF;
-    MotorVoltage[LEFT]  -= voltageOmegaFF;
+    // 直進速度と角速度のフィードフォワード
+    // 角度のフィードバックで足した角速度は、計画した動きではないので入れない
+    // 加速度は目標速度の差分ではなく、走行コマンドが計画した値を使う
+    float plannedOmega = TargetOmega;
+    if(control->forceOmegaEnable){
+        plannedOmega -= control->invertOmega ? -control->feedbackOmega : control->feedbackOmega;
+    }
+    float voltageFF[SIDE_NUM];
+    calcFeedforwardVoltage(TargetSpeed, plannedOmega, targetAccel, targetAlpha, voltageFF);
+    MotorVoltage[RIGHT] += voltageFF[RIGHT];
+    MotorVoltage[LEFT]  += voltageFF[LEFT];
 
     // 直進速度のフィードバック
     float voltageSpeedFB = speedError * speedGain.Kp
@@ -184,513 +242,720 @@ void updateController(control_t *control){
     // 目標速度を保存（デバッグ用）
     gTargetSpeed = TargetSpeed;
     gTargetOmega = TargetOmega;
-    // 目標速度を保存（フィードフォワード用）
-    prevTargetSpeed = TargetSpeed;
-    prevTargetSpeed = TargetOmega;
 }
 
-int straight(const float targetDistance, const float endSpeed, const float timeout,
-        const float maxSpeed, const float accel){
-    // 到達地点で速度がendSpeedになる直線走行
-    // 台形制御
-    // const float MAX_SPEED = 0.5; // m/s
-    const float MIN_SPEED = 0.2; // m/s
-    // const float ACCEL = 1.0; // m/s^2
-    // const float DECEL = -1.0; // m/s^2
-
-    float MAX_SPEED = maxSpeed;
-    float ACCEL = accel;
-    float DECEL = -accel;
+// 走行制御タスク
+// 走行関数は目標値の作り方(t_profile)を決めて、走行コマンドとしてキューに入れる
+// 制御タスクはesp_timerで1 msごとに起こされ、実行中のコマンドの目標値を更新してupdateController()を呼ぶ
+// 呼び出し側の処理時間やtickの境目に関係なく、制御周期が1 msに揃う
+// コマンドが終わったら、同じ制御周期のうちに次のコマンドを始めるので、つなぎ目で制御が止まらない
+// 各コマンドは前のコマンドの終端速度から走り始める
+#define CONTROL_PERIOD 0.001 // sec
+#define MOTION_QUEUE_SIZE 16 // キューに入れておける走行コマンドの数+1
+
+typedef enum{
+    PROFILE_STRAIGHT,
+    PROFILE_TURN,
+    PROFILE_SLALOM,
+    PROFILE_BACK,
+    PROFILE_HOLD, // 決まった周期数だけ、同じ目標値で制御する
+}t_profile_type;
+
+typedef enum{
+    PHASE_START_OFFSET,
+    PHASE_ACCEL,
+    PHASE_KEEP,
+    PHASE_DECEL,
+    PHASE_STOP_OFFSET,
+    PHASE_STOP,
+}t_profile_phase;
+
+// タイムアウトしたときに表示する段階の名前
+static const char *PHASE_NAMES[] = {
+    "offset", "acceleration", "keeping speed", "deceleration", "offset", "stop",
+};
+
+typedef enum{
+    STEP_CONTROL, // 制御器を更新して、次の周期も続ける
+    STEP_DONE,
+    STEP_FAILED,
+}t_step_result;
 
+typedef struct{
+    t_profile_type type;
+    int ticket; // 走行コマンドの番号
     control_t control;
-    control.maxSpeed = MAX_SPEED;
-    control.maxOmega = 0;
-    control.invertSpeed = 0;
-    control.invertOmega = 0;
-    control.accelSpeed = 0;
-    control.accelOmega = 0;
-    control.forceSpeedEnable = 0;
-    control.forceOmegaEnable = 0; 
-    control.enableWallControl = 1;
+    t_profile_phase phase;
+    int ticks; // 動作を始めてから制御器を更新した回数
+    float timeout;
+    // 目標速度(角速度)のS字加減速
+    t_scurve curve;
+    int curveStartTicks; // S字加減速を始めた周期
+    // 直線
+    float targetDistance;
+    float endSpeed;
+    float maxSpeed;
+    float accel;
+    float stopDistance;
+    int stopControlEnable;
+    // 超信地旋回、スラローム
+    float startAngle;
+    float targetAngle;
+    float startOffsetDistance;
+    float stopOffsetDistance;
+    // スラロームの角速度の表(表がなければNULLで、S字加減速から計算する)
+    const t_slalom_table *slalomTable;
+    float referenceAngle; // 回転を始めてから、目標の角速度で進んだ角度 rad
+    // PROFILE_HOLDで制御する周期数
+    int holdTicks;
+}t_profile;
+
+static const float STRAIGHT_MIN_SPEED = 0.2; // 最低駆動トルクの速度 m/s
+
+static t_profile Profile; // 実行中の走行コマンド
+static volatile int ProfileIsRunning = FALSE;
+// 走行関数を呼ぶタスクが入れ、制御タスクが取り出すリングバッファ
+// 入れる側と取り出す側が1つずつなので、位置の更新だけで受け渡せる
+static t_profile MotionQueue[MOTION_QUEUE_SIZE];
+static volatile int MotionQueueHead = 0; // 次に取り出す位置
+static volatile int MotionQueueTail = 0; // 次に入れる位置
+static int LastTicket = 0; // 最後にキューに入れたコマンドの番号
+static volatile int DoneTicket = 0; // 最後に終わったコマンドの番号
+static volatile int MotionResults[MOTION_QUEUE_SIZE]; // コマンドの番号ごとの結果
+static int ControlIsStepped = FALSE; // 制御タスクがないとき、今の周期に制御器を更新したか
+static TaskHandle_t ControlTask = NULL;
+static TaskHandle_t WaitingTask = NULL; // 走行コマンドの終わりを待つタスク
+static esp_timer_handle_t ControlTimer = NULL;
+
+static void initProfile(t_profile *profile, const t_profile_type type, const float timeout){
+    memset(profile, 0, sizeof(t_profile));
+    profile->type = type;
+    profile->timeout = timeout;
+}
 
-    // TODO:逆走機能を設ける
-    if(targetDistance < 0 || endSpeed < 0 || timeout < 0){
-        // control.invertSpeed = 1;
-        ESP_LOGE(TAG, "Invalid arguments, targetDistance:%f, endSpeed:%f, timeout:%f", 
-                targetDistance, endSpeed, timeout);
-        return FALSE;
+static int isTimeout(const t_profile *profile){
+    // 前の周期までの制御時間がタイムアウトを超えたか
+    if(profile->ticks > 0 && profile->timeout < profile->ticks * CONTROL_PERIOD){
+        ESP_LOGE(TAG, "Timeout at %s", PHASE_NAMES[profile->phase]);
+        return TRUE;
     }
+    return FALSE;
+}
 
-    // 移動距離を初期化
-    // gObsMovingDistance = 0;
+static void updateCurvePhase(t_profile *profile, const float time){
+    // S字加減速を始めてから時刻timeの段階にする
+    // タイムアウトしたときに表示するのに使う
+    const t_scurve *curve = &profile->curve;
+    if(time < curve->accelTime){
+        profile->phase = PHASE_ACCEL;
+    }else if(time < curve->accelTime + curve->cruiseTime){
+        profile->phase = PHASE_KEEP;
+    }else{
+        profile->phase = PHASE_DECEL;
+    }
+}
 
-    // 時間計測開始
-    clock_t startTime = clock();
+static float sampleCurve(t_profile *profile, float *accel){
+    // この制御周期の終わりの、S字加減速の目標速度を返す
+    // accelには、同じ時刻の計画上の加速度を入れる
+    // タイムアウトしたときに表示できるように、今の段階も更新する
+    float time = (profile->ticks - profile->curveStartTicks + 1) * CONTROL_PERIOD;
+    float position, speed;
+    scurveSample(&profile->curve, time, &position, &speed, accel);
+    updateCurvePhase(profile, time);
+    return speed;
+}
 
-    // 加速・定速
-    control.accelSpeed = ACCEL;
-    while(1){
-        // 目標位置までの残り移動距離
-        // endSpeedとTargetSpeedが等しい場合は、この条件分岐で関数を抜ける
-        // TODO:逆走機能を設ける
-        float remainingDistance = targetDistance - gObsMovingDistance;
-        if(remainingDistance < 0){
-            // 移動距離を初期化
-            // 関数の終了時に初期化することで、
-            // 関数外の処理中に進んだ距離を計測できる
-            gObsMovingDistance = 0;
-            return TRUE;
-        }
-        // 目標最終速度までの残り速度
-        float remainingSpeed = TargetSpeed - endSpeed;
-        // 減速にかかる時間
-        float brakingTime = remainingSpeed / fabs(DECEL); // 減速度の大きさだけ取る
-        // 減速に必要な距離
-        float brakingDistance = 
-            remainingSpeed * brakingTime * 0.5 // 三角形の面積
-            + endSpeed * brakingTime; // 四角形の面積
-
-        // 残距離が減速距離より短かったら加速ループを抜ける
-        if(remainingDistance <= brakingDistance){
-            break;
-        }
+static t_step_result stepStraight(t_profile *profile){
+    // S字加減速の直線走行
+    // 目標速度は時間で進め、止まる位置は移動距離で決める
+    control_t *control = &profile->control;
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+    if(isTimeout(profile)){
+        return STEP_FAILED;
+    }
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at accelereation");
-            return FALSE;
+    if(profile->phase != PHASE_STOP){
+        if(gObsMovingDistance < (profile->targetDistance - profile->stopDistance)){
+            float accel;
+            float speed = sampleCurve(profile, &accel);
+            // 減速中に最低駆動トルクの速度より遅くなったら、目標速度を固定する
+            if(profile->stopControlEnable && profile->phase == PHASE_DECEL
+                    && speed < STRAIGHT_MIN_SPEED){
+                speed = STRAIGHT_MIN_SPEED;
+                accel = 0;
+            }
+            control->forceSpeed = speed;
+            control->forceAccel = accel;
+            return STEP_CONTROL;
         }
+        profile->phase = PHASE_STOP;
     }
 
-    // 減速
-    // TODO:逆走機能を設ける
-    float stopDistance = 0.0;
-    int stopControlEnable = FALSE;
-    if(endSpeed < MIN_SPEED){
-        // 終端速度が最低駆動トルクの速度より小さい場合は、停止用の距離を設ける
-        stopDistance = 0.005;
-        stopControlEnable = TRUE;
-    }
-    control.accelSpeed = DECEL;
-    while(gObsMovingDistance < (targetDistance - stopDistance)){
-        // 制御速度が終端速度よりも小さくなったら、加速度(減速度)を0にする
-        if(TargetSpeed <= endSpeed){
-            control.accelSpeed = 0;
-        }
-        // 制御速度が最低駆動トルクの速度より小さくなったら、目標速度を固定する
-        if(TargetSpeed < MIN_SPEED){
-            control.forceSpeedEnable = 1;
-            control.forceSpeed = MIN_SPEED;
-        }
+    // 停止
+    const float SPEED_MARGIN = 0.01; // 0 m/s ピッタリ速度を合わせるのは難しいので
+    if(profile->stopControlEnable && fabs(gObsSpeed - profile->endSpeed) >= SPEED_MARGIN){
+        // 終端速度に達するまで、強制的に速度を0 m/sにして制御を続ける
+        // 目標速度を段差で変えるので、加速度は計画していない
+        control->forceSpeed = 0;
+        control->forceAccel = 0;
+        return STEP_CONTROL;
+    }
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+    // 移動距離を初期化
+    // 動作の終了時に初期化することで、
+    // 動作外の処理中に進んだ距離を計測できる
+    gObsMovingDistance = 0;
+    return STEP_DONE;
+}
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at deceleration");
-            return FALSE;
-        }
+static t_step_result stepTurn(t_profile *profile){
+    // S字加減速の超信地旋回
+    const float MIN_OMEGA= M_PI*0.3; // rad/s
+    const float STOP_ANGLE = M_PI*0.01; // 停止用の角度
+    control_t *control = &profile->control;
+
+    if(isTimeout(profile)){
+        return STEP_FAILED;
     }
 
-    // 停止
-    // TODO:逆走機能を設ける
-    const float SPEED_MARGIN = 0.01; // 0 m/s ピッタリ速度を合わせるのは難しいので
-    if(stopControlEnable){
-        // 終端速度に達するまで制御を続ける
-        while(fabs(gObsSpeed - endSpeed) >= SPEED_MARGIN){
-            // 強制的に速度を0 m/sにする
-            control.forceSpeedEnable = 1;
-            control.forceSpeed = 0;
-
-            // 制御器の更新
-            updateController(&control);
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-
-            // タイムアウトチェック
-            if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-                ESP_LOGE(TAG, "Timeout at stop");
-                return FALSE;
+    if(profile->phase != PHASE_STOP){
+        if(fabs((gObsAngle - profile->startAngle)) < fabs(profile->targetAngle) - STOP_ANGLE){
+            float alpha;
+            float omega = sampleCurve(profile, &alpha);
+            // 一定速度まで減速したら、最低駆動トルクで走行
+            if(profile->phase == PHASE_DECEL && omega < MIN_OMEGA){
+                omega = MIN_OMEGA;
+                alpha = 0;
             }
+            control->forceOmega = omega;
+            control->forceAlpha = alpha;
+            return STEP_CONTROL;
         }
+        profile->phase = PHASE_STOP;
+    }
+
+    // 速度が0以下になるまで制御を続ける
+    const float OMEGA_MARGIN = 0.01; // 0 rad/s ピッタリ速度を合わせるのは難しいので
+    if(fabs(gGyro[AXIS_Z]) >= OMEGA_MARGIN){
+        control->forceOmega = 0;
+        control->forceAlpha = 0;
+        return STEP_CONTROL;
     }
 
-    // 移動距離を初期化
-    // 関数の終了時に初期化することで、
-    // 関数外の処理中に進んだ距離を計測できる
     gObsMovingDistance = 0;
+    return STEP_DONE;
+}
 
-    return TRUE;
+static float slalomAngleFeedback(const t_profile *profile){
+    // 目標の角度と、回転を始めてから実際に曲がった角度の差を角速度に足す
+    // 表の角速度はフィードフォワードで流すだけなので、角速度の追従遅れで足りない角度をここで取り戻す
+    float turnedAngle = gObsAngle - profile->startAngle;
+    if(profile->control.invertOmega){
+        turnedAngle = -turnedAngle;
+    }
+    return (profile->referenceAngle - turnedAngle) * pSLALOM_ANGLE_GAIN;
 }
 
+static t_step_result stepSlalom(t_profile *profile){
+    // オフセット直線、角速度の表(またはS字加減速)の回転、オフセット直線の順に走る
+    // 回転は時間で進め、角度のフィードバックを重ねる
+    control_t *control = &profile->control;
 
-int turn(const float targetAngle, const float timeout){
-    // 到達角度で速度が0になる超信地旋回
-    // 台形制御
-    const float MAX_OMEGA= 8; // rad/s
-    const float MIN_OMEGA= M_PI*0.3; // rad/s
-    const float ACCEL = 100; // rad/s^2
-    const float DECEL = -100; // rad/s^2
+    if(isTimeout(profile)){
+        return STEP_FAILED;
+    }
 
-    const float END_OMEGA = 0; // 終端角速度を0 rad/s固定にする
+    if(profile->phase == PHASE_START_OFFSET){
+        // 走行距離がオフセット距離を超えるまで直進
+        if(gObsMovingDistance <= profile->startOffsetDistance){
+            return STEP_CONTROL;
+        }
+        profile->phase = PHASE_ACCEL;
+        profile->curveStartTicks = profile->ticks;
+        profile->startAngle = gObsAngle; // 曲がり始めの角度
+        profile->referenceAngle = 0;
+    }
 
-    control_t control;
-    control.maxSpeed = 0;
-    control.maxOmega = MAX_OMEGA;
-    control.invertSpeed = 0;
-    control.invertOmega = 0;
-    control.accelSpeed = 0;
-    control.accelOmega = 0;
-    control.forceSpeedEnable = 0;
-    control.forceOmegaEnable = 0; 
-    control.enableWallControl = 0;
+    if(profile->phase != PHASE_STOP_OFFSET){
+        const t_slalom_table *table = profile->slalomTable;
+        int tick = profile->ticks - profile->curveStartTicks;
+        float omega, alpha;
+        if(table != NULL && tick < table->length){
+            omega = table->omega[tick];
+            // 角加速度は表の傾き(表の終わりは角速度0につなぐ)
+            float nextOmega = (tick + 1 < table->length) ? table->omega[tick + 1] : 0;
+            alpha = (nextOmega - omega) / SLALOM_TABLE_PERIOD;
+            updateCurvePhase(profile, tick * CONTROL_PERIOD);
+        }else if(table == NULL && tick * CONTROL_PERIOD < profile->curve.time){
+            omega = sampleCurve(profile, &alpha);
+        }else{
+            // 角速度を0にして、オフセット距離を走行
+            profile->phase = PHASE_STOP_OFFSET;
+            profile->referenceAngle = profile->targetAngle;
+            gObsMovingDistance = 0; // 移動距離を初期化
+            omega = 0;
+            alpha = 0;
+        }
+        if(profile->phase != PHASE_STOP_OFFSET){
+            // 角度のフィードバックは計画した動きではないので、角加速度に入れない
+            profile->referenceAngle += omega * CONTROL_PERIOD;
+            control->feedbackOmega = slalomAngleFeedback(profile);
+            control->forceOmega = omega + control->feedbackOmega;
+            control->forceAlpha = alpha;
+            return STEP_CONTROL;
+        }
+    }
+
+    if(gObsMovingDistance <= profile->stopOffsetDistance){
+        // 残った角度のずれは、オフセット直線の間に戻す
+        control->feedbackOmega = slalomAngleFeedback(profile);
+        control->forceOmega = control->feedbackOmega;
+        control->forceAlpha = 0;
+        return STEP_CONTROL;
+    }
 
-    float startAngle = gObsAngle; // 制御開始前の角度取得
+    gObsMovingDistance = 0;
+    return STEP_DONE;
+}
 
-    // 時間計測開始
-    clock_t startTime = clock();
+static t_step_result stepBack(t_profile *profile){
+    // タイムアウトまで後ろに走り、壁に押し付ける
+    control_t *control = &profile->control;
 
-    if(targetAngle < 0){
-        control.invertOmega = 1;
+    if(profile->phase == PHASE_STOP){
+        gObsMovingDistance = 0;
+        return STEP_DONE;
     }
 
-    // 加速・定速
-    control.accelOmega = ACCEL;
-    while(1){
-        // 目標角度までの残り回転角度
-        float remainingAngle = fabs(targetAngle - (gObsAngle - startAngle));
-
-        // 目標最終角速度(0 rad/s)までの残り速度
-        float remainingOmega = TargetOmega - END_OMEGA;
-        // 減速にかかる時間
-        float brakingTime = remainingOmega / fabs(DECEL); // 減速度の大きさだけ取る
-        // 減速に必要な回転角度
-        float brakingAngle = 
-            remainingOmega * brakingTime * 0.5 // 三角系の面積
-            + END_OMEGA * brakingTime; // 四角形の面積
-
-        // 残角度が停止角度より短かったら加速ループを抜ける
-        if(remainingAngle <= brakingAngle){
-            break;
-        }
+    if(isTimeout(profile)){
+        // 強制的に速度を0にして、差分を初期化する
+        profile->phase = PHASE_STOP;
+        control->forceSpeedEnable = 1;
+        control->forceSpeed = 0;
+        control->initializeSumOfError = 1;
+    }
+    return STEP_CONTROL;
+}
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+static t_step_result stepHold(t_profile *profile){
+    if(profile->ticks >= profile->holdTicks){
+        return STEP_DONE;
+    }
+    return STEP_CONTROL;
+}
+
+static t_step_result stepProfile(t_profile *profile){
+    switch(profile->type){
+        case PROFILE_STRAIGHT:
+            return stepStraight(profile);
+        case PROFILE_TURN:
+            return stepTurn(profile);
+        case PROFILE_SLALOM:
+            return stepSlalom(profile);
+        case PROFILE_BACK:
+            return stepBack(profile);
+        case PROFILE_HOLD:
+            return stepHold(profile);
+    }
+    return STEP_FAILED;
+}
+
+static void setKeepSpeedControl(control_t *control){
+    // 今の速度のまま直進する
+    memset(control, 0, sizeof(control_t));
+    control->maxSpeed = fabs(TargetSpeed);
+    control->forceSpeedEnable = 1;
+    control->forceOmegaEnable = 1; 
+    control->forceSpeed = TargetSpeed;
+    control->forceOmega = 0;
+    control->enableWallControl = 1;
+}
+
+static int startNextProfile(void){
+    // キューから次の走行コマンドを取り出して始める
+    if(MotionQueueHead == MotionQueueTail){
+        return FALSE;
+    }
+    Profile = MotionQueue[MotionQueueHead];
+    MotionQueueHead = (MotionQueueHead + 1) % MOTION_QUEUE_SIZE;
+    Profile.startAngle = gObsAngle; // 制御開始前の角度取得
+    Profile.ticks = 0;
+    if(Profile.type == PROFILE_STRAIGHT){
+        // 直線は前のコマンドの終端速度から、残りの距離を加減速する
+        // 前のコマンドのあとに進んだ距離は差し引く
+        float distance = fmaxf(Profile.targetDistance - gObsMovingDistance, 0);
+        scurvePlan(&Profile.curve, distance, fabs(TargetSpeed), Profile.endSpeed,
+                Profile.maxSpeed, Profile.accel, Profile.accel / pJERK_TIME);
+    }
+    ProfileIsRunning = TRUE;
+    return TRUE;
+}
+
+static void finishProfile(const int result){
+    MotionResults[Profile.ticket % MOTION_QUEUE_SIZE] = result;
+    DoneTicket = Profile.ticket;
+    ProfileIsRunning = FALSE;
+    if(WaitingTask != NULL){
+        xTaskNotifyGive(WaitingTask);
+    }
+}
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at accelereation");
+static int controlStep(void){
+    // 1制御周期分、走行コマンドを進める
+    // 制御器を更新したらTRUEを返す
+    if(ProfileIsRunning == FALSE && startNextProfile() == FALSE){
+        if(TargetSpeed == 0){
+            // 止まっていれば何もせず、モータのデューティはそのままにする
             return FALSE;
         }
+        // コマンドが途切れたら、今の速度のまま直進して次のコマンドを待つ
+        control_t control;
+        setKeepSpeedControl(&control);
+        updateController(&control);
+        return TRUE;
     }
 
-    // 減速
-    control.accelOmega = DECEL;
-    const float STOP_ANGLE = M_PI*0.01; // 停止用の角度
-    while(fabs((gObsAngle - startAngle)) < fabs(targetAngle) - STOP_ANGLE){
-        // 一定速度まで減速したら、最低駆動トルクで走行
-        if(fabs(TargetOmega) <= MIN_OMEGA){
-            control.forceOmega = MIN_OMEGA;
-            control.forceOmegaEnable = 1;
+    while(1){
+        t_step_result result = stepProfile(&Profile);
+        if(result == STEP_CONTROL){
+            updateController(&Profile.control);
+            Profile.ticks++;
+            return TRUE;
         }
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
-
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at deceleration");
+        finishProfile(result == STEP_DONE);
+        // 次のコマンドがあれば、同じ制御周期のうちに始める
+        if(startNextProfile() == FALSE){
             return FALSE;
         }
     }
+}
 
-    // 速度が0以下になるまで制御を続ける
-    const float OMEGA_MARGIN = 0.01; // 0 rad/s ピッタリ速度を合わせるのは難しいので
-    while(fabs(gGyro[AXIS_Z]) >= OMEGA_MARGIN){
-        control.forceOmega = 0;
-        control.forceOmegaEnable = 1;
+static void onControlTimer(void *arg){
+    // 1 msごとに制御タスクを起こす
+    (void)arg;
+    xTaskNotifyGive(ControlTask);
+}
 
-        // 制御器の更新
-        updateController(&control);
+static void TaskControl(void *arg){
+    (void)arg;
+    while(1){
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        controlStep();
+    }
+}
+
+void startController(void){
+    // 走行制御タスクを、走行関数を呼ぶタスクより高い優先度でコア1に起動する
+    xTaskCreatePinnedToCore(TaskControl, "TaskControl", 4096, NULL, 10, &ControlTask, 1);
+
+    const esp_timer_create_args_t timerArgs = {
+        .callback = onControlTimer,
+        .name = "ControlTimer",
+    };
+    esp_timer_create(&timerArgs, &ControlTimer);
+    esp_timer_start_periodic(ControlTimer, CONTROL_PERIOD * 1000000);
+}
+
+static void waitControl(void){
+    // 走行コマンドが進むのを待つ
+    if(ControlTask != NULL){
+        // 制御タスクがコマンドを終えるたびに起こしてくれる
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        return;
+    }
+
+    // 制御タスクがなければ(PC上のシミュレーションなど)、ここで1 msごとに制御する
+    // 前の周期に制御器を更新していたら、1周期待ってから次の周期を制御する
+    if(ControlIsStepped){
         vTaskDelay(1 / portTICK_PERIOD_MS);
+    }
+    ControlIsStepped = controlStep();
+}
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at stop");
-            return FALSE;
-        }
+static int queueProfile(t_profile *profile){
+    // 走行コマンドをキューに入れて、番号を返す
+    // キューがいっぱいなら、空くまで待つ
+    WaitingTask = xTaskGetCurrentTaskHandle();
+    int nextTail = (MotionQueueTail + 1) % MOTION_QUEUE_SIZE;
+    while(nextTail == MotionQueueHead){
+        waitControl();
     }
+    profile->ticket = ++LastTicket;
+    MotionQueue[MotionQueueTail] = *profile;
+    MotionQueueTail = nextTail;
+    return profile->ticket;
+}
 
-    // 移動距離を初期化
-    // 関数の終了時に初期化することで、
-    // 関数外の処理中に進んだ距離を計測できる
-    gObsMovingDistance = 0;
+int motionIsDone(const int ticket){
+    // 番号ticketの走行コマンドが終わっていればTRUEを返す
+    return (ticket <= DoneTicket);
+}
 
-    return TRUE;
+int motionWait(const int ticket){
+    // 番号ticketの走行コマンドが終わるまで待ち、成功したらTRUEを返す
+    // 番号が0以下(コマンドを入れられなかった)ならFALSEを返す
+    if(ticket <= 0){
+        return FALSE;
+    }
+    while(motionIsDone(ticket) == FALSE){
+        waitControl();
+    }
+    return MotionResults[ticket % MOTION_QUEUE_SIZE];
 }
 
-int slalomBase(const int isTurnRight, const float endSpeed, const float timeout,
-        const float MAX_OMEGA, const float ACCEL_DECEL,
-        const float START_OFFSET_DISTANCE, const float STOP_OFFSET_DISTANCE,
-        const float ACCEL_DECEL_ANGLE, const float KEEP_OMEGA_ANGLE){
+static int queueStraightBase(const float targetDistance, const float endSpeed, const float timeout,
+        const float maxSpeed, const float accel, const int enableWallControl){
+    // 到達地点で速度がendSpeedになる直線走行
+    // S字加減速
+    t_profile profile;
+    initProfile(&profile, PROFILE_STRAIGHT, timeout);
+    profile.control.maxSpeed = maxSpeed;
+    profile.control.enableWallControl = enableWallControl;
 
-    // スラロームやりたい
-    control_t control;
-    // 直進速度は一定速
-    control.maxSpeed = endSpeed;
-    control.invertSpeed = 0;
-    control.accelSpeed = 0;
-    control.forceSpeedEnable = 1;
-    control.forceSpeed = endSpeed;
-    // 角速度を変化させる
-    control.maxOmega = MAX_OMEGA;
-    control.invertOmega = 0;
-    control.accelOmega = 0;
-    control.forceOmegaEnable = 0; 
-    // 壁制御はしない
-    control.enableWallControl = 0;
+    // TODO:逆走機能を設ける
+    if(targetDistance < 0 || endSpeed < 0 || timeout < 0){
+        // control.invertSpeed = 1;
+        ESP_LOGE(TAG, "Invalid arguments, targetDistance:%f, endSpeed:%f, timeout:%f", 
+                targetDistance, endSpeed, timeout);
+        return 0;
+    }
 
-    if(isTurnRight){
-        control.invertOmega = 1;
+    // 移動距離を初期化
+    // gObsMovingDistance = 0;
+
+    // 目標速度は走り始めるときに、その時の速度からS字加減速で作る
+    profile.phase = PHASE_ACCEL;
+    profile.control.forceSpeedEnable = 1;
+    profile.targetDistance = targetDistance;
+    profile.endSpeed = endSpeed;
+    profile.maxSpeed = maxSpeed;
+    profile.accel = accel;
+    if(endSpeed < STRAIGHT_MIN_SPEED){
+        // 終端速度が最低駆動トルクの速度より小さい場合は、停止用の距離を設ける
+        profile.stopDistance = 0.005;
+        profile.stopControlEnable = TRUE;
     }
 
-    float startAngle = gObsAngle; // 制御開始前の角度取得
-    // 時間計測開始
-    clock_t startTime = clock();
+    return queueProfile(&profile);
+}
 
-    // オフセット距離を走行
-    // gObsMovingDistance = 0; // 移動距離を初期化
-    while(1){
-        // 走行距離がオフセット距離を超えたらループを抜ける
-        if(gObsMovingDistance > START_OFFSET_DISTANCE){
-            break;
-        }
+int queueStraight(const float targetDistance, const float endSpeed, const float timeout,
+        const float maxSpeed, const float accel){
+    // 壁制御ありの直線走行
+    return queueStraightBase(targetDistance, endSpeed, timeout, maxSpeed, accel, TRUE);
+}
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+int queueTurn(const float targetAngle, const float timeout){
+    // 到達角度で速度が0になる超信地旋回
+    // S字加減速
+    const float MAX_OMEGA= 8; // rad/s
+    const float ACCEL = 100; // rad/s^2
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at offset");
-            return FALSE;
-        }
+    t_profile profile;
+    initProfile(&profile, PROFILE_TURN, timeout);
+    profile.control.maxOmega = MAX_OMEGA;
+    profile.control.forceOmegaEnable = 1;
+    if(targetAngle < 0){
+        profile.control.invertOmega = 1;
     }
 
-    // 一定角度に達するまで加速
-    control.accelOmega = ACCEL_DECEL;
-    while(1){
-        // 回転角度が一定角度を超えたらループを抜ける
-        if(fabs(gObsAngle - startAngle) > ACCEL_DECEL_ANGLE){
-            break;
-        }
+    profile.phase = PHASE_ACCEL;
+    profile.targetAngle = targetAngle;
+    scurvePlan(&profile.curve, fabs(targetAngle), 0, 0, MAX_OMEGA, ACCEL, ACCEL / pJERK_TIME);
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+    return queueProfile(&profile);
+}
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at accelereation");
-            return FALSE;
+static const t_slalom_table *findSlalomTable(const t_slalom *shape, const float speed){
+    // shapeの形を直進速度speedで曲がる、角速度の表を探す
+    // 表の速度と違う速度で曲がるときはNULLを返す
+    const float MARGIN = 0.0001; // m/s
+    for(int table_i=0; table_i<SLALOM_TABLE_NUM; table_i++){
+        const t_slalom_table *table = &SLALOM_TABLES[table_i];
+        if(table->shape == shape && fabsf(table->speed - speed) < MARGIN){
+            return table;
         }
     }
+    return NULL;
+}
 
-    // 一定角度に達するまで低速
-    control.accelOmega = 0;
-    while(1){
-        // 回転角度が一定角度を超えたらループを抜ける
-        if(fabs(gObsAngle - startAngle) > ACCEL_DECEL_ANGLE+KEEP_OMEGA_ANGLE){
-            break;
-        }
+static int queueSlalomBase(const int isTurnRight, const float speed, const float timeout,
+        const t_slalom *shape, const int isExit){
+    // 直進速度をspeedに保ったまま、shapeの形に曲がる
+    // isExitがTRUEなら、前後のオフセット距離を入れ替えて斜めから直線に戻る向きに走る
+    t_profile profile;
+    initProfile(&profile, PROFILE_SLALOM, timeout);
+    // 直進速度は一定速
+    profile.control.maxSpeed = speed;
+    profile.control.forceSpeedEnable = 1;
+    profile.control.forceSpeed = speed;
+    // 角速度はS字加減速で変化させる
+    profile.control.maxOmega = shape->maxOmega;
+    profile.control.forceOmegaEnable = 1;
+    // 壁制御はしない
+    profile.control.enableWallControl = 0;
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+    if(isTurnRight){
+        profile.control.invertOmega = 1;
+    }
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at keeping omega");
-            return FALSE;
-        }
+    // オフセット距離の走行から始める
+    // gObsMovingDistance = 0; // 移動距離を初期化
+    profile.phase = PHASE_START_OFFSET;
+    profile.startOffsetDistance = shape->startOffsetDistance;
+    profile.stopOffsetDistance = shape->stopOffsetDistance;
+    if(isExit){
+        profile.startOffsetDistance = shape->stopOffsetDistance;
+        profile.stopOffsetDistance = shape->startOffsetDistance;
+    }
+    // 表の速度で曲がるなら、前もって計算した角速度の表を流す
+    // 表がない速度では、制御周期ごとにS字加減速から角速度を計算する
+    slalomCurve(&profile.curve, shape, speed);
+    profile.targetAngle = profile.curve.distance;
+    profile.slalomTable = findSlalomTable(shape, speed);
+    if(profile.slalomTable == NULL){
+        ESP_LOGD(TAG, "No slalom table for %f m/s", speed);
     }
 
-    // 角速度が０以下になるまで減速
-    control.accelOmega = -ACCEL_DECEL;
-    while(1){
-        // 回転角度が一定角度を超えたらループを抜ける
-        if(fabs(gObsAngle - startAngle) > 2.0*ACCEL_DECEL_ANGLE+KEEP_OMEGA_ANGLE){
-            break;
-        }
+    return queueProfile(&profile);
+}
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+int queueSlalom(const int isTurnRight, const float endSpeed, const float timeout){
+    // 探索走行用のスラローム
+    return queueSlalomBase(isTurnRight, endSpeed, timeout, &SEARCH_SLALOM, FALSE);
+}
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at deceleration");
-            return FALSE;
-        }
+int queueFastTurn(const int type, const int isTurnRight, const int isExit, 
+        const float speed, const float timeout){
+    // 最短走行用のターン
+    // isExitがTRUEなら、斜めから直線に戻る向きに走る
+    // 表の速度より遅いspeedでも、slalomCurve()が同じ軌跡になるように角速度を変える
+    // speedがSLALOM_SPEEDSのどれかなら、その速度の角速度の表を流す
+    const t_slalom *fastTurn = &FAST_TURNS[type];
+    float turnSpeed = fastTurn->speed;
+    if(speed < turnSpeed){
+        turnSpeed = speed;
     }
+    return queueSlalomBase(isTurnRight, turnSpeed, timeout, fastTurn, isExit);
+}
 
-    // オフセット距離を走行
-    // 角速度を0にする
-    control.accelOmega = 0;
-    control.forceOmegaEnable = 1;
-    control.forceOmega = 0;
-    gObsMovingDistance = 0; // 移動距離を初期化
-    while(1){
-        // 走行距離がオフセット距離を超えたらループを抜ける
-        if(gObsMovingDistance > STOP_OFFSET_DISTANCE){
-            break;
-        }
+int queueSearchStraight(const float distance, const float endSpeed){
+    // 予めパラメータをセットした探索走行関数
+    // コードを綺麗にするために作成した
+    return queueStraight(distance, endSpeed, pSEARCH_TIMEOUT, 
+            pSEARCH_MAX_SPEED, pSEARCH_ACCEL);
+}
 
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+int queueSearchKnownStraight(const float distance, const float endSpeed){
+    // 探索中に、壁が全てわかっている区画を最短走行の速度と加速度でまとめて走る
+    // 距離が長くなるので、探索速度で走り切る時間をタイムアウトに足しておく
+    return queueStraight(distance, endSpeed, pSEARCH_TIMEOUT + distance / pSEARCH_MAX_SPEED, 
+            pFAST_STRAIGHT_MAX_SPEED, pFAST_ACCEL);
+}
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at offset");
-            return FALSE;
-        }
-    }
+int queueFastStraight(const float distance, const float endSpeed){
+    // 予めパラメータをセットした最短走行関数
+    // コードを綺麗にするために作成した
+    return queueStraight(distance, endSpeed, pFAST_TIMEOUT, 
+            pFAST_STRAIGHT_MAX_SPEED, pFAST_ACCEL);
+}
 
-    // 移動距離を初期化
-    // 関数の終了時に初期化することで、
-    // 関数外の処理中に進んだ距離を計測できる
-    gObsMovingDistance = 0;
+int queueDiagonalStraight(const float distance, const float endSpeed){
+    // 予めパラメータをセットした斜め走行関数
+    // 斜めでは横の壁センサが柱を見てしまうので、壁制御はしない
+    return queueStraightBase(distance, endSpeed, pFAST_TIMEOUT, 
+            pFAST_DIAGONAL_MAX_SPEED, pFAST_ACCEL, FALSE);
+}
 
-    return TRUE;
+// 走り終わるまで待つ走行関数
+int straight(const float targetDistance, const float endSpeed, const float timeout,
+        const float maxSpeed, const float accel){
+    return motionWait(queueStraight(targetDistance, endSpeed, timeout, maxSpeed, accel));
 }
 
+int turn(const float targetAngle, const float timeout){
+    return motionWait(queueTurn(targetAngle, timeout));
+}
 
 int slalom(const int isTurnRight, const float endSpeed, const float timeout){
-    // 探索走行用のスラローム
-    const float MAX_OMEGA= 8; // 最大角速度 rad/s
-    const float ACCEL_DECEL = 100; // 50 加減速度 rad/s^2
-    const float START_OFFSET_DISTANCE = 0.010; // オフセット直線走行距離 meter
-    const float STOP_OFFSET_DISTANCE = 0.018; // オフセット直線走行距離 meter
-    const float ACCEL_DECEL_ANGLE = 15.0 * M_PI / 180.0; // 25.0 ->  0.436332313; // 加減速角度 rad
-    const float KEEP_OMEGA_ANGLE  = 56.0 * M_PI / 180.0; // 40.0 -> 0.6981317008; // 低速角度 rad
-
-    return slalomBase(isTurnRight, endSpeed, timeout, 
-            MAX_OMEGA, ACCEL_DECEL, 
-            START_OFFSET_DISTANCE, STOP_OFFSET_DISTANCE,
-            ACCEL_DECEL_ANGLE, KEEP_OMEGA_ANGLE);
+    return motionWait(queueSlalom(isTurnRight, endSpeed, timeout));
 }
 
+int fastTurn(const int type, const int isTurnRight, const int isExit, 
+        const float speed, const float timeout){
+    return motionWait(queueFastTurn(type, isTurnRight, isExit, speed, timeout));
+}
 
 int fastSlalom(const int isTurnRight, const float endSpeed, const float timeout){
     // 最短走行用のスラローム
-    const float MAX_OMEGA= 15; // 最大角速度 rad/s
-    const float ACCEL_DECEL = 200; // 50 加減速度 rad/s^2
-    const float START_OFFSET_DISTANCE = 0.003; // オフセット直線走行距離 meter
-    const float STOP_OFFSET_DISTANCE = 0.003; // オフセット直線走行距離 meter
-    const float ACCEL_DECEL_ANGLE = 30.0 * M_PI / 180.0; // 25.0 ->  0.436332313; // 加減速角度 rad
-    const float KEEP_OMEGA_ANGLE  = 30.0 * M_PI / 180.0; // 40.0 -> 0.6981317008; // 低速角度 rad
-
-    return slalomBase(isTurnRight, endSpeed, timeout, 
-            MAX_OMEGA, ACCEL_DECEL, 
-            START_OFFSET_DISTANCE, STOP_OFFSET_DISTANCE,
-            ACCEL_DECEL_ANGLE, KEEP_OMEGA_ANGLE);
+    return motionWait(queueSlalomBase(isTurnRight, endSpeed, timeout,
+            &FAST_TURNS[FAST_TURN_SMALL90], FALSE));
 }
 
 int straightBack(const float timeout){
     // けつあてようの逆走行
+    // タイムアウトまで後ろに走ったら、速度を0にして終わる
     const float MIN_SPEED = 0.2; // m/s
 
-    control_t control;
-    control.maxSpeed = MIN_SPEED;
-    control.maxOmega = 0;
-    control.invertSpeed = 1;
-    control.invertOmega = 0;
-    control.accelSpeed = 0;
-    control.accelOmega = 0;
-    control.forceSpeedEnable = 0;
-    control.forceOmegaEnable = 0; 
-    control.enableWallControl = 0;
+    t_profile profile;
+    initProfile(&profile, PROFILE_BACK, timeout);
+    profile.control.maxSpeed = MIN_SPEED;
+    profile.control.invertSpeed = 1;
 
     // 移動距離を初期化
     // gObsMovingDistance = 0;
 
-    // 時間計測開始
-    clock_t startTime = clock();
-
     // 加速・定速
-    control.accelSpeed = 1.0;
+    profile.phase = PHASE_ACCEL;
+    profile.control.accelSpeed = 1.0;
     // 強制的に速度を与える
-    control.forceSpeedEnable = 1;
-    control.forceSpeed = MIN_SPEED;
-    while(1){
-        // 制御器の更新
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
+    profile.control.forceSpeedEnable = 1;
+    profile.control.forceSpeed = MIN_SPEED;
 
-        // タイムアウトチェック
-        if(timeout < (float)(clock() - startTime)/CLOCKS_PER_SEC){
-            ESP_LOGE(TAG, "Timeout at accelereation");
-            break;
-        }
-    }
-
-    // 強制的に速度を0にする
-    control.forceSpeedEnable = 1;
-    control.forceSpeed = 0;
-    // 差分を初期化する
-    control.initializeSumOfError = 1;
-    // 制御器の更新
-    updateController(&control);
-    vTaskDelay(1 / portTICK_PERIOD_MS);
-
-    // 移動距離を初期化
-    // 関数の終了時に初期化することで、
-    // 関数外の処理中に進んだ距離を計測できる
-    gObsMovingDistance = 0;
-
-    return TRUE;
+    return motionWait(queueProfile(&profile));
 }
 
 void stop(const int times){
     // その場にとどまる
-
-    control_t control;
-    control.maxSpeed = 0;
-    control.maxOmega = 0;
-    control.accelSpeed = 0;
-    control.accelOmega = 0;
-    control.forceSpeedEnable = 1;
-    control.forceOmegaEnable = 1; 
-    control.forceSpeed = 0;
-    control.forceOmega = 0;
-
-    for(int i=0;i<times;i++){
-        updateController(&control);
-        vTaskDelay(1 / portTICK_PERIOD_MS);
-    }
+    t_profile profile;
+    initProfile(&profile, PROFILE_HOLD, 0);
+    profile.control.forceSpeedEnable = 1;
+    profile.control.forceOmegaEnable = 1; 
+    profile.control.forceSpeed = 0;
+    profile.control.forceOmega = 0;
+    profile.holdTicks = times;
+
+    motionWait(queueProfile(&profile));
 }
 
 
+void keepSpeed(void){
+    // 今の速度のまま1制御周期だけ直進する
+    // 次の動作が決まるまで、制御を止めずに待つために使う
+    t_profile profile;
+    initProfile(&profile, PROFILE_HOLD, 0);
+    setKeepSpeedControl(&profile.control);
+    profile.holdTicks = 1;
+
+    motionWait(queueProfile(&profile));
+}
+
 int searchStraight(const float distance, const float endSpeed){
-    // 予めパラメータをセットした探索走行関数
-    // コードを綺麗にするために作成した
-    return straight(distance, endSpeed, pSEARCH_TIMEOUT, 
-            pSEARCH_MAX_SPEED, pSEARCH_ACCEL);
+    return motionWait(queueSearchStraight(distance, endSpeed));
+}
+
+int searchKnownStraight(const float distance, const float endSpeed){
+    return motionWait(queueSearchKnownStraight(distance, endSpeed));
 }
 
 int fastStraight(const float distance, const float endSpeed){
-    // 予めパラメータをセットした最短走行関数
-    // コードを綺麗にするために作成した
-    return straight(distance, endSpeed, pFAST_TIMEOUT, 
-            pFAST_MAX_SPEED, pFAST_ACCEL);
+    return motionWait(queueFastStraight(distance, endSpeed));
+}
+
+int diagonalStraight(const float distance, const float endSpeed){
+    return motionWait(queueDiagonalStraight(distance, endSpeed));
 }
 
 int ketsuate(const float endSpeed){
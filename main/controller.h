@@ -1,14 +1,42 @@
 #ifndef CONTROLLER_H 
 #define CONTROLLER_H
 
+#include "trajectory.h"
+
+extern void startController(void);
+// 走行制御のフィードフォワード電圧(voltageは右、左の順)
+extern void calcFeedforwardVoltage(const float speed, const float omega,
+        const float accel, const float alpha, float voltage[2]);
 extern int straight(const float targetDistance, const float endSpeed, const float timeout,
         const float maxSpeed, const float accel);
 extern int turn(const float targetAngle, const float timeout);
 extern int slalom(const int isTurnRight, const float endSpeed, const float timeout);
 extern int fastSlalom(const int isTurnRight, const float endSpeed, const float timeout);
+extern int fastTurn(const int type, const int isTurnRight, const int isExit, 
+        const float speed, const float timeout);
 extern int straightBack(const float timeout);
+extern void keepSpeed(void);
 extern int searchStraight(const float distance, const float endSpeed);
+extern int searchKnownStraight(const float distance, const float endSpeed);
 extern int fastStraight(const float distance, const float endSpeed);
+extern int diagonalStraight(const float distance, const float endSpeed);
 extern int ketsuate(const float endSpeed);
 
+// 走行コマンドのキュー
+// queueXXX()は走行コマンドをキューに入れて番号を返し、走り終わるのを待たない
+// 引数が正しくなければ0を返す
+// 前のコマンドが終わった制御周期のうちに次のコマンドを始める
+extern int queueStraight(const float targetDistance, const float endSpeed, const float timeout,
+        const float maxSpeed, const float accel);
+extern int queueTurn(const float targetAngle, const float timeout);
+extern int queueSlalom(const int isTurnRight, const float endSpeed, const float timeout);
+extern int queueFastTurn(const int type, const int isTurnRight, const int isExit, 
+        const float speed, const float timeout);
+extern int queueSearchStraight(const float distance, const float endSpeed);
+extern int queueSearchKnownStraight(const float distance, const float endSpeed);
+extern int queueFastStraight(const float distance, const float endSpeed);
+extern int queueDiagonalStraight(const float distance, const float endSpeed);
+extern int motionIsDone(const int ticket);
+extern int motionWait(const int ticket);
+
 #endif
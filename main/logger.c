@@ -4,6 +4,8 @@
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_spiffs.h"
@@ -19,7 +21,8 @@ static const char *TAG="Logger";
 #define SPIFFS_NG 0
 
 static const char *FILE_PATH = "/spiffs/log.csv";
-static const char *WALL_FILE_PATH = "/spiffs/wall.csv";
+static const char *WALL_FILE_PATH = "/spiffs/wall.bin";
+static const char *WALL_TMP_FILE_PATH = "/spiffs/wall.tmp"; // 書き込み途中のファイル
 static int spiffsInitialized = SPIFFS_NG;
 
 static const int INIT_PERIOD_MSEC = 1000;
@@ -162,32 +165,9 @@ void loggingPrint(void){
 }
 
 void loggingSave(void){
-    if(spiffsInitialized != SPIFFS_OK){
-        return;
-    }
-
-    // Use POSIX and C standard library functions to work with files.
-    // First create a file.
-    ESP_LOGI(TAG, "Opening file");
-
-    FILE* f = fopen(FILE_PATH, "w");
-    if (f == NULL) {
-        ESP_LOGE(TAG, "Failed to open file for writing");
-        return;
-    }
-
-    fprintf(f, "Index,TimeElapsed,%s,%s,%s\n", pLogName1,pLogName2,pLogName3);
-    for(int log_i=0; log_i<logIndex; log_i++){
-        fprintf(f, "%d,%d,%f,%f,%f\n", log_i,gLogTime[log_i],
-                gLogData[0][log_i],
-                gLogData[1][log_i],
-                gLogData[2][log_i]
-                );
-    }
-    fclose(f);
-
-    ESP_LOGI(TAG, "File written");
-
+    // ロギングしたデータをフラッシュメモリに保存する
+    // 書き終わるまで戻らない
+    loggingWaitWrite(loggingSaveAsync(), FLASH_WRITE_TIMEOUT_MSEC);
 }
 
 void loggingLoadPrint(void){
@@ -229,106 +209,442 @@ void loggingLoadPrint(void){
 
 }
 
+// 壁情報ファイル
+// ヘッダのあとに、1区画あたり北と東の壁を2bitずつ(4bit)詰めて並べる
+// 南と西の壁は隣の区画の北と東の壁から復元する
+#define WALL_FILE_VERSION 1
+#define WALL_FILE_DATA_MAX ((MAZESIZE_X * MAZESIZE_Y + 1) / 2)
+typedef struct
+{
+    char magic[4]; // "WALL"
+    uint16_t version;
+    uint8_t mazesizeX;
+    uint8_t mazesizeY;
+    uint32_t dataSize; // ヘッダのあとに続くデータのバイト数
+    uint32_t crc; // データのCRC32
+}t_wall_file_header;
+
+static uint32_t calcCrc32(const uint8_t *data, const size_t size){
+    // CRC32(IEEE 802.3)を計算する
+    uint32_t crc = 0xFFFFFFFF;
+    for(size_t data_i=0; data_i<size; data_i++){
+        crc ^= data[data_i];
+        for(int bit_i=0; bit_i<8; bit_i++){
+            crc = (crc >> 1) ^ (0xEDB88320 & (-(crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
 char encodeWall(const t_wall wall){
     // 壁情報を1つのchar型変数にまとめる
     //
     // Data order:
     // north:east:south:west
     char data=0;
-    data |= (wall.north && 0x03);
+    data |= (wall.north & 0x03);
     data <<= 2;
-    data |= (wall.east && 0x03);
+    data |= (wall.east & 0x03);
     data <<= 2;
-    data |= (wall.south && 0x03);
+    data |= (wall.south & 0x03);
     data <<= 2;
-    data |= (wall.west && 0x03);
+    data |= (wall.west & 0x03);
 
     return data;
 }
 
 void decodeWall(char* data, t_wall* wall){
-    wall->north = (*data) && 0x03;
-    wall->east  = ((*data)>>2) && 0x03;
-    wall->south = ((*data)>>4) && 0x03;
-    wall->west  = ((*data)>>6) && 0x03;
+    wall->north = ((*data)>>6) & 0x03;
+    wall->east  = ((*data)>>4) & 0x03;
+    wall->south = ((*data)>>2) & 0x03;
+    wall->west  = (*data) & 0x03;
 }
 
+static int readWallFile(const char *path, const int mazesize_x, const int mazesize_y, 
+        uint8_t data[WALL_FILE_DATA_MAX]){
+    // 壁情報ファイルを読み、ヘッダとCRCが正しければTRUEを返す
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        return FALSE;
+    }
+
+    t_wall_file_header header;
+    int isValid = FALSE;
+    if(fread(&header, sizeof(header), 1, f) == 1
+            && memcmp(header.magic, "WALL", 4) == 0
+            && header.version == WALL_FILE_VERSION
+            && header.mazesizeX == mazesize_x && header.mazesizeY == mazesize_y
+            && header.dataSize == (mazesize_x * mazesize_y + 1) / 2
+            && header.dataSize <= WALL_FILE_DATA_MAX
+            && fread(data, 1, header.dataSize, f) == header.dataSize
+            && calcCrc32(data, header.dataSize) == header.crc){
+        isValid = TRUE;
+    }
+    fclose(f);
 
-void loggingSaveWall(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]){
-    // 壁情報をフラッシュメモリに保存する
+    if(isValid == FALSE){
+        ESP_LOGW(TAG, "Invalid wall file %s", path);
+    }
+    return isValid;
+}
+
+typedef struct
+{
+    t_wall_file_header header;
+    uint8_t data[WALL_FILE_DATA_MAX];
+}t_wall_image; // 壁情報ファイルの中身
+
+static int packWallImage(const int mazesize_x, const int mazesize_y, 
+        t_wall wallMap[mazesize_x][mazesize_y], t_wall_image *image){
+    // 壁情報をファイルに書く形に詰める
+    t_wall_file_header header = {
+        .magic = {'W', 'A', 'L', 'L'},
+        .version = WALL_FILE_VERSION,
+        .mazesizeX = mazesize_x,
+        .mazesizeY = mazesize_y,
+        .dataSize = (mazesize_x * mazesize_y + 1) / 2,
+    };
+    if(header.dataSize > WALL_FILE_DATA_MAX){
+        ESP_LOGE(TAG, "Maze size %dx%d is too large to save", mazesize_x, mazesize_y);
+        return FALSE;
+    }
+
+    memset(image->data, 0, sizeof(image->data));
+    for(int y_i=0; y_i<mazesize_y; y_i++){
+        for(int x_i=0; x_i<mazesize_x; x_i++){
+            int cell_i = y_i * mazesize_x + x_i;
+            uint8_t cell = (wallMap[x_i][y_i].north & 0x03) | ((wallMap[x_i][y_i].east & 0x03) << 2);
+            image->data[cell_i / 2] |= cell << ((cell_i % 2) * 4);
+        }
+    }
+    header.crc = calcCrc32(image->data, header.dataSize);
+    image->header = header;
+    return TRUE;
+}
+
+static int writeWallImage(const t_wall_image *image){
+    // 詰めた壁情報をフラッシュメモリに書く
+    // 一時ファイルに書き切ってから置き換えるので、途中で電源が切れても前のファイルが残る
     
     if(spiffsInitialized != SPIFFS_OK){
-        return;
+        return FALSE;
     }
 
-    // Use POSIX and C standard library functions to work with files.
-    // First create a file.
-    ESP_LOGI(TAG, "Opening file");
-
-    FILE* f = fopen(WALL_FILE_PATH, "w");
+    FILE* f = fopen(WALL_TMP_FILE_PATH, "wb");
     if (f == NULL) {
         ESP_LOGE(TAG, "Failed to open file for writing");
-        return;
+        return FALSE;
     }
-    for(int x_i=0; x_i<mazesize_x; x_i++){
-        char text[128] = {};
-        char data = encodeWall(wallMap[x_i][0]);
-        strcat(text, &data);
-        for(int y_i=1; y_i<mazesize_y; y_i++){
-            data = encodeWall(wallMap[x_i][y_i]);
-            strcat(text, ",");
-            strcat(text, &data);
+    int isWritten = (fwrite(&image->header, sizeof(image->header), 1, f) == 1
+            && fwrite(image->data, 1, image->header.dataSize, f) == image->header.dataSize);
+    if(fclose(f) != 0 || isWritten == FALSE){
+        ESP_LOGE(TAG, "Failed to write wall file");
+        remove(WALL_TMP_FILE_PATH);
+        return FALSE;
+    }
+
+    // SPIFFSのrenameは上書きできないので、古いファイルを消してから置き換える
+    remove(WALL_FILE_PATH);
+    if(rename(WALL_TMP_FILE_PATH, WALL_FILE_PATH) != 0){
+        ESP_LOGE(TAG, "Failed to rename wall file");
+        return FALSE;
+    }
+
+    ESP_LOGI(TAG, "Wall file written");
+    return TRUE;
+}
+
+int loggingSaveWall(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]){
+    // 壁情報をフラッシュメモリに保存する
+    // 書き終わるまで戻らないので、走行中はloggingSaveWallAsync()を使う
+    t_wall_image image;
+    if(packWallImage(mazesize_x, mazesize_y, wallMap, &image) == FALSE){
+        return FALSE;
+    }
+    return writeWallImage(&image);
+}
+
+int loggingLoadWall(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]){
+    // フラッシュメモリから壁情報を読み込む
+    // 置き換えの途中で電源が切れていたら、書き切った一時ファイルを使う
+    // 正しいファイルがなければwallMapは書き換えずにFALSEを返す
+
+    if(spiffsInitialized != SPIFFS_OK){
+        return FALSE;
+    }
+
+    uint8_t data[WALL_FILE_DATA_MAX];
+    if(readWallFile(WALL_FILE_PATH, mazesize_x, mazesize_y, data) == FALSE
+            && readWallFile(WALL_TMP_FILE_PATH, mazesize_x, mazesize_y, data) == FALSE){
+        return FALSE;
+    }
+
+    for(int y_i=0; y_i<mazesize_y; y_i++){
+        for(int x_i=0; x_i<mazesize_x; x_i++){
+            int cell_i = y_i * mazesize_x + x_i;
+            uint8_t cell = data[cell_i / 2] >> ((cell_i % 2) * 4);
+            wallMap[x_i][y_i].north = cell & 0x03;
+            wallMap[x_i][y_i].east = (cell >> 2) & 0x03;
+        }
+    }
+    // 南と西の壁は隣の区画から復元する(一番外側は壁)
+    for(int y_i=0; y_i<mazesize_y; y_i++){
+        for(int x_i=0; x_i<mazesize_x; x_i++){
+            wallMap[x_i][y_i].south = (y_i > 0) ? wallMap[x_i][y_i-1].north : 1;
+            wallMap[x_i][y_i].west = (x_i > 0) ? wallMap[x_i-1][y_i].east : 1;
         }
-        ESP_LOGE(TAG, "%s", text);
-        fprintf(f, "%s\n",text);
     }
 
-    fclose(f);
+    ESP_LOGI(TAG, "Wall file loaded");
+    return TRUE;
+}
 
-    ESP_LOGI(TAG, "File written");
+static int deleteWallFile(void){
+    // 保存した壁情報のファイルを消す
+    if(spiffsInitialized != SPIFFS_OK){
+        return FALSE;
+    }
+    remove(WALL_FILE_PATH);
+    remove(WALL_TMP_FILE_PATH);
+    ESP_LOGI(TAG, "Wall file deleted");
+    return TRUE;
 }
 
 void loggingLoadPrintWall(void){
     // フラッシュメモリの壁情報を読み取り、シリアルでプリントする
+    // 1区画を north:east:south:west の順に2bitずつ並べた16進数で表示する
 
-    if(spiffsInitialized != SPIFFS_OK){
+    static t_wall wallMap[MAZESIZE_X][MAZESIZE_Y];
+    if(loggingLoadWall(MAZESIZE_X, MAZESIZE_Y, wallMap) == FALSE){
+        ESP_LOGE(TAG, "Failed to load wall file");
         return;
     }
 
-    // Use POSIX and C standard library functions to work with files.
-    // First create a file.
-    ESP_LOGI(TAG, "Opening file");
+    for(int y_i=MAZESIZE_Y-1; y_i>=0; y_i--){
+        printf("%2d:", y_i);
+        for(int x_i=0; x_i<MAZESIZE_X; x_i++){
+            printf(" %02x", (uint8_t)encodeWall(wallMap[x_i][y_i]));
+        }
+        printf("\n");
+    }
+}
+
+
+// フラッシュメモリへの書き込みタスク
+// SPIFFSへの書き込みは数十msかかることがあるので、優先度の低いタスクにまとめて任せる
+// 要求には書き込む内容を丸ごとコピーして渡すので、呼び出し側はすぐに元のデータを書き換えてよい
+// 要求には1から順に番号を付け、書き終わった番号で完了を知らせる
+#define FLASH_WRITE_QUEUE_LEN 4
+#define FLASH_WRITE_RESULT_NUM 8 // 結果を覚えておく要求の数。キューの長さ+書き込み中の1つより多くする
+#define LOG_BLOCK_ROWS 32 // 1回の要求で渡すログの行数
+#define LOG_NAME_LEN 32
+
+typedef enum
+{
+    FLASH_WRITE_WALL, // 壁情報を保存する
+    FLASH_WRITE_LOG, // ログを1ブロック保存する
+    FLASH_DELETE_WALL, // 保存した壁情報を消す
+}t_flash_write_type;
+
+typedef struct
+{
+    int isFirst; // 最初のブロックならファイルを作り直して見出しを書く
+    char names[LOG_DATA_NUM][LOG_NAME_LEN];
+    int startIndex;
+    int rows;
+    int time[LOG_BLOCK_ROWS];
+    float data[LOG_DATA_NUM][LOG_BLOCK_ROWS];
+}t_log_block;
+
+typedef struct
+{
+    t_flash_write_type type;
+    int ticket; // 要求の番号
+    union
+    {
+        t_wall_image wall;
+        t_log_block log;
+    }body;
+}t_flash_write_request;
+
+static QueueHandle_t flashWriteQueue = NULL;
+static SemaphoreHandle_t flashWriteMutex = NULL;
+static t_flash_write_request flashWriteBuffer; // flashWriteMutexを取ってから使う
+static int lastTicket = 0; // 最後にキューに入れた要求の番号
+static volatile int doneTicket = 0; // 最後に書き終わった要求の番号
+static volatile int writeResults[FLASH_WRITE_RESULT_NUM];
+
+static int writeLogBlock(const t_log_block *block){
+    // ログを1ブロックだけファイルに書き足す
+    if(spiffsInitialized != SPIFFS_OK){
+        return FALSE;
+    }
 
-    FILE* f = fopen(WALL_FILE_PATH, "r");
+    FILE* f = fopen(FILE_PATH, block->isFirst ? "w" : "a");
     if (f == NULL) {
-        ESP_LOGE(TAG, "Failed to open file for loading");
+        ESP_LOGE(TAG, "Failed to open file for writing");
+        return FALSE;
+    }
+
+    if(block->isFirst){
+        fprintf(f, "Index,TimeElapsed,%s,%s,%s\n", 
+                block->names[0], block->names[1], block->names[2]);
+    }
+    for(int row_i=0; row_i<block->rows; row_i++){
+        fprintf(f, "%d,%d,%f,%f,%f\n", block->startIndex + row_i, block->time[row_i],
+                block->data[0][row_i],
+                block->data[1][row_i],
+                block->data[2][row_i]
+                );
+    }
+    if(fclose(f) != 0){
+        ESP_LOGE(TAG, "Failed to write log file");
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static t_flash_write_request* beginFlashWrite(const t_flash_write_type type){
+    // 書き込み要求を作り始める
+    // endFlashWrite()を呼ぶまで、他のタスクは要求を作れない
+    if(flashWriteQueue == NULL){
+        ESP_LOGW(TAG, "Flash writer is not started");
+        return NULL;
+    }
+    xSemaphoreTake(flashWriteMutex, portMAX_DELAY);
+    flashWriteBuffer.type = type;
+    return &flashWriteBuffer;
+}
+
+static int endFlashWrite(const int doSend, const TickType_t waitTicks){
+    // 作った要求をキューに入れて、その番号を返す
+    // 入れなかったときや、キューが満杯のまま待ち時間が過ぎたときは0を返す
+    int ticket = 0;
+    if(doSend){
+        flashWriteBuffer.ticket = lastTicket + 1;
+        if(xQueueSend(flashWriteQueue, &flashWriteBuffer, waitTicks) == pdTRUE){
+            lastTicket = ticket = flashWriteBuffer.ticket;
+        }else{
+            ESP_LOGW(TAG, "Flash write queue is full");
+        }
+    }
+    xSemaphoreGive(flashWriteMutex);
+    return ticket;
+}
+
+int loggingSaveWallAsync(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]){
+    // 壁情報の保存を書き込みタスクに頼む
+    // 今の壁情報をコピーしてすぐに戻る。キューが満杯なら待たずに0を返す
+    t_flash_write_request *request = beginFlashWrite(FLASH_WRITE_WALL);
+    if(request == NULL){
+        return 0;
+    }
+    int isPacked = packWallImage(mazesize_x, mazesize_y, wallMap, &request->body.wall);
+    return endFlashWrite(isPacked, 0);
+}
+
+int loggingSaveAsync(void){
+    // ロギングしたデータの保存を書き込みタスクに頼む
+    // データをブロックに分けてコピーする。キューが空くのを待ちながら渡すので、
+    // データが多いと戻るまでに時間がかかる
+    const char *names[LOG_DATA_NUM] = {pLogName1, pLogName2, pLogName3};
+    int ticket = 0;
+    int start_i = 0;
+    do{
+        t_flash_write_request *request = beginFlashWrite(FLASH_WRITE_LOG);
+        if(request == NULL){
+            return 0;
+        }
+        t_log_block *block = &request->body.log;
+        block->isFirst = (start_i == 0);
+        for(int data_i=0; data_i<LOG_DATA_NUM; data_i++){
+            snprintf(block->names[data_i], LOG_NAME_LEN, "%s", names[data_i] ? names[data_i] : "");
+        }
+        block->startIndex = start_i;
+        block->rows = logIndex - start_i;
+        if(block->rows > LOG_BLOCK_ROWS){
+            block->rows = LOG_BLOCK_ROWS;
+        }
+        for(int row_i=0; row_i<block->rows; row_i++){
+            block->time[row_i] = gLogTime[start_i + row_i];
+            for(int data_i=0; data_i<LOG_DATA_NUM; data_i++){
+                block->data[data_i][row_i] = gLogData[data_i][start_i + row_i];
+            }
+        }
+        ticket = endFlashWrite(TRUE, portMAX_DELAY);
+        start_i += LOG_BLOCK_ROWS;
+    }while(start_i < logIndex);
+
+    return ticket;
+}
+
+void loggingDeleteWall(void){
+    // 保存した壁情報を消す
+    // 先に頼んだ保存のあとで消すように、書き込みタスクに頼んで終わるまで待つ
+    t_flash_write_request *request = beginFlashWrite(FLASH_DELETE_WALL);
+    if(request == NULL){
+        deleteWallFile();
         return;
     }
+    loggingWaitWrite(endFlashWrite(TRUE, portMAX_DELAY), FLASH_WRITE_TIMEOUT_MSEC);
+}
 
-    char buf[128] = {};
+int loggingIsWriteDone(const int ticket){
+    // 番号ticketの要求を書き終わっていればTRUEを返す
+    return (ticket <= doneTicket);
+}
 
-    int ret;
-    int count=0;
-    // 1行ずつ読み込む
-    while( (ret=fscanf(f, "%s", buf)) != EOF){
-        printf("%d:", count);
-
-        t_wall wall;
-
-        char* tp;
-        tp = strtok(buf, ",");
-        decodeWall(tp, &wall);
-        printf("%d", wall.north);
-        while((tp = strtok(NULL, ",")) ){
-            decodeWall(tp, &wall);
-            printf(" %d", wall.north);
+int loggingWaitWrite(const int ticket, const int timeout_msec){
+    // 番号ticketの要求を書き終わるまで待つ
+    // 書き込めたらTRUE、失敗したかtimeout_msecを過ぎたらFALSEを返す
+    if(ticket <= 0){
+        return FALSE;
+    }
+
+    int elapsed_msec = 0;
+    while(loggingIsWriteDone(ticket) == FALSE){
+        if(elapsed_msec >= timeout_msec){
+            ESP_LOGW(TAG, "Timeout waiting for flash write %d", ticket);
+            return FALSE;
         }
-        printf("\n");
-        count++;
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+        elapsed_msec += 10;
     }
-    fclose(f);
+    return writeResults[ticket % FLASH_WRITE_RESULT_NUM];
+}
 
-    ESP_LOGI(TAG, "File loaded");
+static void TaskFlashWriter(void *arg){
+    // キューに入った要求を順番にフラッシュメモリに書く
+    static t_flash_write_request request;
+
+    while(1){
+        if(xQueueReceive(flashWriteQueue, &request, portMAX_DELAY) == pdTRUE){
+            int result = FALSE;
+            switch(request.type){
+                case FLASH_WRITE_WALL:
+                    result = writeWallImage(&request.body.wall);
+                    break;
+                case FLASH_WRITE_LOG:
+                    result = writeLogBlock(&request.body.log);
+                    break;
+                case FLASH_DELETE_WALL:
+                    result = deleteWallFile();
+                    break;
+                default:
+                    break;
+            }
+            writeResults[request.ticket % FLASH_WRITE_RESULT_NUM] = result;
+            doneTicket = request.ticket;
+        }
+    }
+}
+
+void startFlashWriter(void){
+    // 書き込みタスクを起動する
+    // 走行制御の邪魔をしないように、優先度を他のタスクより低くしてコア0で動かす
+    flashWriteQueue = xQueueCreate(FLASH_WRITE_QUEUE_LEN, sizeof(t_flash_write_request));
+    flashWriteMutex = xSemaphoreCreateMutex();
+    xTaskCreatePinnedToCore(TaskFlashWriter, "TaskFlashWriter", 4096, NULL, 1, NULL, 0);
 }
 
 
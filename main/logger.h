@@ -3,6 +3,8 @@
 
 #include "variables.h"
 
+#define FLASH_WRITE_TIMEOUT_MSEC 5000 // 書き込みの完了を待つ時間の目安
+
 extern void loggingInitialize(const int period_msec, const int timeout_msec,
         char *name1, float *data1,
         char *name2, float *data2,
@@ -14,9 +16,16 @@ extern int loggingIsInitialized(void);
 extern int loggingIsStarted(void);
 extern void loggingPrint(void);
 extern void loggingSave(void);
+extern int loggingSaveAsync(void);
 extern void loggingLoadPrint(void);
-extern void loggingSaveWall(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]);
+extern int loggingSaveWall(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]);
+extern int loggingSaveWallAsync(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]);
+extern int loggingLoadWall(const int mazesize_x, const int mazesize_y, t_wall wallMap[mazesize_x][mazesize_y]);
+extern void loggingDeleteWall(void);
 extern void loggingLoadPrintWall(void);
+extern int loggingIsWriteDone(const int ticket);
+extern int loggingWaitWrite(const int ticket, const int timeout_msec);
+extern void startFlashWriter(void);
 extern void TaskLogging(void *arg);
 
 #endif 
@@ -370,19 +370,25 @@ void Debug(void){
     gObsDial = 0;
 }
 
+// TaskMainのスタックサイズ bytes
+// 探索と最短走行の経路計画(maze.c)の大きな配列はstaticに置き、スタックには載せない
+// モードを実行するたびにスタックの残りをログに出すので、処理を増やしたら確かめること
+#define TASK_MAIN_STACK_SIZE 4096
+
 static void TaskMain(void *arg){
     static const char *TAG="Main";
 
-    // 迷路初期化
-    initMaze();
+    // 迷路初期化(保存した壁情報があれば読み込む)
+    loadMaze();
 
     ESP_LOGI(TAG, "Complete initialization.");
     while(1){
         if(gCurrentMode == MODE_SELECT){
             // モード選択
             int mode = gObsDial;
-            int goalX = 1;
-            int goalY = 1;
+            // ゴール区画(左下の座標と大きさ)
+            // 2x2のゴールなら t_goal goal = {7, 7, 2, 2};
+            t_goal goal = {1, 1, 1, 1};
             // タッチセンサでモードを確定する
             if(gObsTouch[RIGHT] && gObsTouch[LEFT]){
                 switch(mode){
@@ -391,15 +397,16 @@ static void TaskMain(void *arg){
                     int slalomEnable = TRUE;
                     int goHomeEanble = TRUE;
                     ESP_LOGI(TAG, "SEARCH_SLALOM");
-                    search(goalX, goalY, slalomEnable, goHomeEanble);
+                    search(&goal, slalomEnable, goHomeEanble);
                     break;
                 }
                 case MODE1_FAST_RUN:
                 {
                     int slalomEnable = TRUE;
+                    int diagonalEnable = TRUE;
                     int goHomeEanble = FALSE;
                     ESP_LOGI(TAG, "FAST RUN");
-                    run(goalX, goalY, slalomEnable, goHomeEanble);
+                    run(&goal, slalomEnable, diagonalEnable, goHomeEanble);
                     break;
                 }
                 case MODE2_CONFIG:
@@ -419,10 +426,21 @@ static void TaskMain(void *arg){
                     ESP_LOGI(TAG, "CONFIG_PRINT");
                     indicateWall();
                     break;
+                case MODE6_DUMMY:
+                    ESP_LOGI(TAG, "MAZE RESET");
+                    resetMaze();
+                    break;
+                case MODE7_DUMMY:
+                    ESP_LOGI(TAG, "WALL PRINT");
+                    loggingLoadPrintWall();
+                    vTaskDelay(2000 / portTICK_PERIOD_MS);
+                    break;
                 default:
                     ESP_LOGI(TAG, "ELSE");
                     break;
                 }
+                ESP_LOGI(TAG, "Stack remaining %d / %d bytes",
+                        (int)uxTaskGetStackHighWaterMark(NULL), TASK_MAIN_STACK_SIZE);
             }
             gIndicatorValue = mode;
         }
@@ -461,11 +479,14 @@ void app_main()
             xTaskCreate(TaskReadEncoders, "TaskReadEncoders", 4096, NULL, 5, NULL);
             xTaskCreate(TaskReadMotion, "TaskReadMotion", 4096, NULL, 5, NULL);
             xTaskCreate(TaskMotorDrive, "TaskMotorDrive", 4096, NULL, 5, NULL);
-            // xTaskCreate(TaskControlMotion, "TaskControlMotion", 4096, NULL, 5, NULL);
             gIndicatorValue = 9; // LED点灯
 
             vTaskDelay(3000 / portTICK_PERIOD_MS);
-            xTaskCreate(TaskMain, "TaskMain", 4096, NULL, 5, NULL);
+            // 探索中の計画とフラッシュメモリへの書き込みはコア0、走行制御はコア1で動かす
+            startFlashWriter();
+            startPlanner();
+            startController();
+            xTaskCreatePinnedToCore(TaskMain, "TaskMain", TASK_MAIN_STACK_SIZE, NULL, 5, NULL, 1);
 
             // ダイアルを初期化
             gObsDial = 0;
@@ -1,9 +1,13 @@
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 #include "esp_system.h"
 
 #include "maze.h"
@@ -17,458 +21,1011 @@
 #include "esp_log.h"
 static const char *TAG="Maze";
 
-/*
- * Wall Status Bits: [00] -> [isKnown isWall]
- * Wall Mask: Search[01] -> 壁情報のみを抽出、 Second(2走目)[11] -> 知ってる かつ 壁があるところ抽出
- *
- */
-
-#define MASK_SEARCH 0x01 // 探索走行用マスク値.壁情報とこの値のAND値が０（NOWALL）なら壁なしor未探索区間
-#define MASK_SECOND 0x03 // 最短走行用マスク値.壁情報とこの値のAND値が０（NOWALL）なら壁なし
-#define MAZESIZE_X (32)
-#define MAZESIZE_Y (32)
-#define UNKNOWN 2 // 壁があるかないか判らない状態の場合の値
-#define NOWALL  0 // 壁がないばあいの値
-#define WALL    1 // 壁がある場合の値
-#define VWALL   3 // 仮想壁の値(未使用)
-#define CONV_SEN2WALL(w) ((w) ? WALL : NOWALL)
-
-typedef enum
+void loadMaze(void)
 {
-    north=0,
-    east=1,
-    south=2,
-    west=3,
-}t_direction;
+    // 迷路を初期化して、保存した壁情報があれば読み込む
+    // 探索のあとで電源を入れ直しても、探索をやり直さずに最短走行できる
+    static t_wall wallMap[MAZESIZE_X][MAZESIZE_Y];
+    initMaze();
+    if(loggingLoadWall(MAZESIZE_X, MAZESIZE_Y, wallMap) == TRUE)
+    {
+        setWallMap(wallMap);
+        ESP_LOGI(TAG, "Load saved walls");
+    }
+}
 
-typedef struct
+void resetMaze(void)
 {
-    short x;
-    short y;
-    t_direction dir;
-}t_position;
+    // 保存した壁情報を消して、迷路を何もわからない状態に戻す
+    loggingDeleteWall();
+    initMaze();
+}
 
-typedef enum
+// 最短走行の経路計画
+// 区画と向きの組(状態)をノードとし、走行時間をコストとしてダイクストラ法で経路を探す
+//
+// 状態(x,y,dir)は、区画x,yで曲がり終えてdirを向いたことを表す
+// スラローム有効時は区画の出口(境界)にいてスラローム速度で走っており、
+// スラローム無効時は区画の中心で停止している
+// 1つの状態から、直進してどこかの区画で曲がるか、ゴールで止まるまでを1本の辺とする
+// 直進の時間はS字加減速から求めるので、区画数を数えるだけの歩数Mapと違い、
+// 細かいジグザグより長い直線を選ぶことができる
+#define ROUTE_STATE_NUM (MAZESIZE_X * MAZESIZE_Y * 4)
+#define ROUTE_STATE_NONE (0xFFFF)
+#define ROUTE_STATE_START (ROUTE_STATE_NUM) // スタート地点を表す仮の状態
+#define ROUTE_MAX_LENGTH (MAZESIZE_X * MAZESIZE_Y)
+_Static_assert(ROUTE_STATE_NUM < ROUTE_STATE_NONE, "route state index overflow");
+
+static float RouteCost[ROUTE_STATE_NUM]; // スタートから各状態までの走行時間 sec
+static unsigned short RoutePrev[ROUTE_STATE_NUM]; // 1つ前の状態
+static unsigned short RouteHeap[ROUTE_STATE_NUM]; // 走行時間が小さい順の二分ヒープ
+static unsigned short RouteHeapPos[ROUTE_STATE_NUM]; // ヒープ内の位置+1(0はヒープ外)
+static int RouteHeapNum;
+
+static t_direction Route[ROUTE_MAX_LENGTH]; // 1区画ずつ進む方角
+static int RouteLength;
+
+static int getRouteState(int x, int y, t_direction dir)
 {
-    LOCAL_FRONT=0, // 前
-    LOCAL_RIGHT=1, // 右
-    LOCAL_REAR=2,  // 後
-    LOCAL_LEFT=3,  // 左
-    LOCAL_UNKNOWN, // 方向不明
-}ENUM_LOCAL_DIRECTION; // 自分から見た方向を示す列挙型
-typedef unsigned int t_local_dir;
+    return (x * MAZESIZE_Y + y) * 4 + dir;
+}
 
-typedef enum
+static void swapRouteHeap(int i, int j)
 {
-    PRIORITY_LOWEST = 0,
-    PRIORITY_LOW,
-    PRIORITY_MID,
-    PRIORITY_HIGH,
-    PRIORITY_HIGHEST,
-}ENUM_PRIORITY;
-typedef unsigned int t_priority;
+    unsigned short tmp = RouteHeap[i];
+    RouteHeap[i] = RouteHeap[j];
+    RouteHeap[j] = tmp;
+    RouteHeapPos[RouteHeap[i]] = i + 1;
+    RouteHeapPos[RouteHeap[j]] = j + 1;
+}
 
-const unsigned char INIT_STEPS = 255;
-const unsigned char MIN_STEP = 0;
-static t_steps StepMap[MAZESIZE_X][MAZESIZE_Y]; // 歩数マップ
-static t_wall WallMap[MAZESIZE_X][MAZESIZE_Y];
+static void upRouteHeap(int i)
+{
+    while(i > 0 && RouteCost[RouteHeap[(i-1)/2]] > RouteCost[RouteHeap[i]])
+    {
+        swapRouteHeap(i, (i-1)/2);
+        i = (i-1)/2;
+    }
+}
 
-void initialzeStepMap(int goalX, int goalY)
+static int popRouteHeap(void)
 {
-    // 迷路の歩数Mapを初期化する。
-    // 全体をINIT_STEPSで初期化し、ゴール座標golaX, golaYはMIN_STEPで初期化する
-    
-    for(int x_i = 0; x_i < MAZESIZE_X; x_i++) // 迷路の大きさ分ループ(x座標)
+    int state = RouteHeap[0];
+    RouteHeapNum--;
+    swapRouteHeap(0, RouteHeapNum);
+    RouteHeapPos[state] = 0;
+
+    int i = 0;
+    while(1)
     {
-        for(int y_i = 0; y_i < MAZESIZE_Y; y_i++) // 迷路の大きさ分ループ(y座標)
+        int smallest = i;
+        int left = 2*i + 1;
+        int right = 2*i + 2;
+        if(left < RouteHeapNum && RouteCost[RouteHeap[left]] < RouteCost[RouteHeap[smallest]])
+        {
+            smallest = left;
+        }
+        if(right < RouteHeapNum && RouteCost[RouteHeap[right]] < RouteCost[RouteHeap[smallest]])
+        {
+            smallest = right;
+        }
+        if(smallest == i)
         {
-            StepMap[x_i][y_i] = INIT_STEPS; // すべてINIT_STEPSで埋める
+            break;
         }
+        swapRouteHeap(i, smallest);
+        i = smallest;
     }
-
-    StepMap[goalX][goalY] = MIN_STEP; // ゴール座標の歩数をMIN_STEPに設定
+    return state;
 }
 
+static void relaxRouteState(int state, int prevState, float cost)
+{
+    // 状態stateまでの走行時間がcostより大きければ更新する
+    if(cost >= RouteCost[state])
+    {
+        return;
+    }
+    RouteCost[state] = cost;
+    RoutePrev[state] = prevState;
+    if(RouteHeapPos[state] == 0)
+    {
+        RouteHeap[RouteHeapNum] = state;
+        RouteHeapPos[state] = RouteHeapNum + 1;
+        RouteHeapNum++;
+    }
+    upRouteHeap(RouteHeapPos[state] - 1);
+}
 
-void makeStepMap(int goalX, int goalY, int mask) //歩数マップを作成する
+static float getRouteStraightTime(int cells, int isFirst, int isLast, const int slalomEnable)
 {
-    // 座標goalX,goalYをゴールとした歩数Mapを作成する。
-    // maskの値(MASK_SEARCH or MASK_SECOND)によって、
-    // 探索用の歩数Mapを作るか、最短走行の歩数Mapを作るかが切り替わる
+    // cells区画先の区画まで直進する時間を見積もる
+    float distance = pCELL_DISTANCE * cells;
+    float startSpeed = 0;
+    float endSpeed = 0;
 
-    initialzeStepMap(goalX, goalY); // 歩数Mapを初期化する
+    if(slalomEnable)
+    {
+        // 曲がる区画では、区画の境界から境界までスラロームで走る
+        if(isFirst == FALSE)
+        {
+            distance -= pHALF_CELL_DISTANCE;
+            startSpeed = fastTurnSpeed(FAST_TURN_SMALL90);
+        }
+        if(isLast == FALSE)
+        {
+            distance -= pHALF_CELL_DISTANCE;
+            endSpeed = fastTurnSpeed(FAST_TURN_SMALL90);
+        }
+    }
+    return straightTime(distance, startSpeed, endSpeed, pFAST_STRAIGHT_MAX_SPEED, pFAST_ACCEL);
+}
 
-    int change_flag;			//Map作成終了を見極めるためのフラグ
-    do
+static void expandRouteState(int x, int y, t_direction dir, int prevState, float cost,
+        const t_goal *goal, const int slalomEnable,
+        float *goalCost, int *goalPrevState, t_cell *goalCell)
+{
+    // 状態(x,y,dir)から直進し、曲がる区画とゴールまでの走行時間を更新する
+    int isFirst = (prevState == ROUTE_STATE_START);
+    float turnCost = slalomEnable ? fastTurnTime(FAST_TURN_SMALL90) : turnTime(M_PI_2);
+
+    int cells = 0;
+    int nextX = x;
+    int nextY = y;
+    while( (getWall(nextX, nextY, dir) & MASK_SECOND) == NOWALL 
+            && getNeighbor(nextX, nextY, dir, &nextX, &nextY) == TRUE)
     {
-        change_flag = FALSE; // 変更がなかった場合にはループを抜ける
-        for(int x_i = 0; x_i < MAZESIZE_X; x_i++) // 迷路の大きさ分ループ(x座標)
+        cells++;
+
+        // ゴール区画のどこかで止まる
+        if(isGoal(goal, nextX, nextY))
         {
-            for(int y_i = 0; y_i < MAZESIZE_Y; y_i++) // 迷路の大きさ分ループ(y座標)
+            float arrivalCost = cost + getRouteStraightTime(cells, isFirst, TRUE, slalomEnable);
+            if(arrivalCost < *goalCost)
             {
-                if(StepMap[x_i][y_i] == INIT_STEPS) // INIT_STEPSの場合は次へ
-                {
-                    continue;
-                }
+                *goalCost = arrivalCost;
+                *goalPrevState = prevState;
+                goalCell->x = nextX;
+                goalCell->y = nextY;
+            }
+            break; // ゴール区画に入ったら、その先には進まない
+        }
 
-                // 北方向の更新
-                if(y_i < MAZESIZE_Y-1) // 配列の範囲外アクセス防止
-                {
-                    if( (WallMap[x_i][y_i].north & mask) == NOWALL)
-                    {
-                        // 上の区画の歩数を更新
-                        if(StepMap[x_i][y_i+1] == INIT_STEPS)
-                        {
-                            StepMap[x_i][y_i+1] = StepMap[x_i][y_i] + 1;
-                            change_flag = TRUE;
-                        }
-                    }
-                }
+        // 左右に曲がる
+        float straightCost = getRouteStraightTime(cells, isFirst, FALSE, slalomEnable);
+        for(int turn_i = 1; turn_i <= 3; turn_i += 2)
+        {
+            t_direction nextDir = (dir + turn_i) % 4;
+            if( (getWall(nextX, nextY, nextDir) & MASK_SECOND) != NOWALL)
+            {
+                continue;
+            }
+            relaxRouteState(getRouteState(nextX, nextY, nextDir), prevState, 
+                    cost + straightCost + turnCost);
+        }
+    }
+}
 
-                // 東方向の更新
-                if(x_i < MAZESIZE_X-1) // 配列の範囲外アクセス防止
-                {
-                    if( (WallMap[x_i][y_i].east & mask) == NOWALL)
-                    {
-                        // 右の区画の歩数を更新
-                        if(StepMap[x_i+1][y_i] == INIT_STEPS)
-                        {
-                            StepMap[x_i+1][y_i] = StepMap[x_i][y_i] + 1;
-                            change_flag = TRUE;
-                        }
-                    }
-                }
+static int makeFastRoute(const t_goal *goal, const int slalomEnable, 
+        const t_position *mypos)
+{
+    // 現在地からゴール区画まで、既知の壁だけを使って走行時間が最小の経路を作る
+    // ゴール区画のうち、一番早く着ける区画で止まる
+    // 経路はRouteに1区画ずつ進む方角として格納する
+    // 経路がなければFALSEを返す
 
-                // 南方向の更新
-                if(y_i > 0) // 配列の範囲外アクセス防止
-                {
-                    if( (WallMap[x_i][y_i].south & mask) == NOWALL)
-                    {
-                        if(StepMap[x_i][y_i-1] == INIT_STEPS)
-                        {
-                            StepMap[x_i][y_i-1] = StepMap[x_i][y_i] + 1;
-                            change_flag = TRUE;
-                        }
-                    }
-                }
+    for(int state_i = 0; state_i < ROUTE_STATE_NUM; state_i++)
+    {
+        RouteCost[state_i] = INFINITY;
+        RoutePrev[state_i] = ROUTE_STATE_NONE;
+        RouteHeapPos[state_i] = 0;
+    }
+    RouteHeapNum = 0;
+    RouteLength = 0;
 
-                // 西方向の更新
-                if(x_i > 0) // 配列の範囲外アクセス防止
-                {
-                    if( (WallMap[x_i][y_i].west & mask) == NOWALL)
-                    {
-                        if(StepMap[x_i-1][y_i] == INIT_STEPS)
-                        {
-                            StepMap[x_i-1][y_i] = StepMap[x_i][y_i] + 1;
-                            change_flag = TRUE;
-                        }
-                    }
-                }
-            } // y_i loop
-        } // x_i loop
-    }while(change_flag == TRUE); // 全体を作り終わるまで待つ
-}
+    float goalCost = INFINITY;
+    int goalPrevState = ROUTE_STATE_NONE;
+    t_cell goalCell;
 
-int isUnknown(int x, int y)
-{
-    // 座標x,yが未探索区間か否かを調べる
+    // スタート地点ではその場で旋回してから走り出せる
+    // 現在の向きと違う方角へ出発する場合は、旋回時間を加える
+    if(isGoal(goal, mypos->x, mypos->y))
+    {
+        return TRUE;
+    }
+    for(int dir = north; dir <= west; dir++)
+    {
+        int diff = (4 + dir - mypos->dir) % 4;
+        float cost = 0;
+        if(diff == 2)
+        {
+            cost = turnTime(M_PI);
+        }
+        else if(diff != 0)
+        {
+            cost = turnTime(M_PI_2);
+        }
+        expandRouteState(mypos->x, mypos->y, dir, ROUTE_STATE_START, cost,
+                goal, slalomEnable, &goalCost, &goalPrevState, &goalCell);
+    }
+
+    // ダイクストラ法
+    while(RouteHeapNum > 0)
+    {
+        int state = popRouteHeap();
+        if(RouteCost[state] >= goalCost)
+        {
+            break; // これ以上良い経路は見つからない
+        }
+        int x = (state / 4) / MAZESIZE_Y;
+        int y = (state / 4) % MAZESIZE_Y;
+        t_direction dir = state % 4;
+        expandRouteState(x, y, dir, state, RouteCost[state],
+                goal, slalomEnable, &goalCost, &goalPrevState, &goalCell);
+    }
+
+    if(goalCost == INFINITY)
+    {
+        ESP_LOGE(TAG, "No route to goal (%d, %d)", goal->x, goal->y);
+        return FALSE;
+    }
 
-    if((WallMap[x][y].north == UNKNOWN) 
-            || (WallMap[x][y].east == UNKNOWN) 
-            || (WallMap[x][y].south == UNKNOWN) 
-            || (WallMap[x][y].west == UNKNOWN))
+    // ゴールから状態を遡り、曲がる区画の間の直進をRouteの後ろから1区画ずつ並べる
+    // 曲がる区画を一時的な配列に貯めるとTaskMainのスタックに収まらないので、
+    // 1回目で経路の長さを数え、2回目で書き込む
+    int turnNum = 0;
+    int toX = goalCell.x;
+    int toY = goalCell.y;
+    for(int state = goalPrevState; state != ROUTE_STATE_START; state = RoutePrev[state])
     {
-        return TRUE; // 未探索
+        int x = (state / 4) / MAZESIZE_Y;
+        int y = (state / 4) % MAZESIZE_Y;
+        RouteLength += abs(toX - x) + abs(toY - y);
+        toX = x;
+        toY = y;
+        turnNum++;
+    }
+    RouteLength += abs(toX - mypos->x) + abs(toY - mypos->y);
+
+    int route_i = RouteLength;
+    toX = goalCell.x;
+    toY = goalCell.y;
+    for(int state = goalPrevState; state != ROUTE_STATE_START; state = RoutePrev[state])
+    {
+        int x = (state / 4) / MAZESIZE_Y;
+        int y = (state / 4) % MAZESIZE_Y;
+        for(int cell_i = abs(toX - x) + abs(toY - y); cell_i > 0; cell_i--)
+        {
+            Route[--route_i] = state % 4;
+        }
+        toX = x;
+        toY = y;
+    }
+
+    // 最初に曲がる区画までは、現在地からの出発方向に直進する
+    t_direction startDir;
+    if(toX != mypos->x)
+    {
+        startDir = (toX > mypos->x) ? east : west;
     }
     else
     {
-        return FALSE; // 探索済
+        startDir = (toY > mypos->y) ? north : south;
+    }
+    while(route_i > 0)
+    {
+        Route[--route_i] = startDir;
     }
+
+    ESP_LOGI(TAG, "Fast route: %d cells, %d turns, %f sec", RouteLength, turnNum, goalCost);
+    return TRUE;
 }
 
-t_priority getPriority(int x, int y, t_direction dir, const t_position *mypos)
+// 最短走行のモーションコマンド
+// 経路を走り出す前に「半区画N個分の直進」「スラローム」「超信地旋回」の列に変換しておき、
+// 走行中は経路計画をせずにコマンドを順番に実行する
+//
+// 斜め走行を有効にすると、ジグザグに曲がり続ける区間を
+// 45度/135度ターンで斜めに入り、斜め直進とV90度ターンで抜けるコマンドに置き換える
+typedef enum
 {
-    // 座標x,yと、向いている方角dirから優先度を算出する
+    MOTION_STRAIGHT = 0,  // length個分の半区画を直進
+    MOTION_DIAGONAL,      // length個分の斜めの通過点の間隔(半区画*√2)を斜めに直進
+    MOTION_SLALOM90,      // 区画の入口から出口までの90度スラローム
+    MOTION_LARGE90,       // 前の区画の中心から次の区画の中心までの大回り90度スラローム
+    MOTION_SLALOM180,     // 区画の入口から隣の区画の出口までの180度スラローム
+    MOTION_SLALOM45_IN,   // 直線から斜めへの45度スラローム
+    MOTION_SLALOM45_OUT,  // 斜めから直線への45度スラローム
+    MOTION_SLALOM135_IN,  // 直線から斜めへの135度スラローム
+    MOTION_SLALOM135_OUT, // 斜めから直線への135度スラローム
+    MOTION_SLALOM_V90,    // 斜めから斜めへの90度スラローム
+    MOTION_PIVOT90,       // 区画の中心で止まってから90度旋回
+    MOTION_PIVOT180,      // 区画の中心で止まってから180度旋回
+    MOTION_END,           // ゴールで停止
+}ENUM_MOTION_TYPE;
 
-    // 未探索が一番優先度が高い.
-    // それに加え、自分の向きと、行きたい方向から、
-    // 前-> 横-> 後の順で優先度を付加する。
-
-    t_priority priority = PRIORITY_LOWEST;
+typedef struct
+{
+    unsigned char type;
+    unsigned char isTurnRight;
+    unsigned short length;
+    float endSpeed; // コマンドを終えるときの速度 m/s (ターンでは走行中ずっとこの速度)
+}t_motion_command;
+
+// 直進と旋回が交互に並ぶので、区画数の2倍+終端があれば足りる
+#define MOTION_COMMAND_MAX (ROUTE_MAX_LENGTH * 2 + 1)
+static t_motion_command MotionCommands[MOTION_COMMAND_MAX];
+static int MotionCommandNum;
+// i番目のコマンドの入口での速度の上限(planFastSpeeds()で使う)
+// 8 KB以上あるので、TaskMainのスタックに置かない
+static float SpeedLimits[MOTION_COMMAND_MAX + 1];
+
+// 経路上の各区画での動作(t_local_dir)
+static unsigned char RouteActions[ROUTE_MAX_LENGTH];
+
+static void addMotionCommand(const int type, const int isTurnRight, const int length)
+{
+    if( (type == MOTION_STRAIGHT || type == MOTION_DIAGONAL) && length == 0)
+    {
+        return; // 連続するターンの間には直進がない
+    }
+    MotionCommands[MotionCommandNum].type = type;
+    MotionCommands[MotionCommandNum].isTurnRight = isTurnRight;
+    MotionCommands[MotionCommandNum].length = length;
+    MotionCommands[MotionCommandNum].endSpeed = 0;
+    MotionCommandNum++;
+}
 
-    if(mypos->dir == dir) // 行きたい方向が現在の進行方向と同じ場合
+static int isDiagonalTurns(const int first, const int last)
+{
+    // RouteActions[first]からRouteActions[last]までの連続したターンを
+    // 斜め走行に置き換えられるか調べる
+    // 同じ向きのターンが3回続く場合(渦巻き)と、2回だけのUターンは置き換えない
+    if(last - first < 1)
     {
-        priority = PRIORITY_MID;
+        return FALSE;
     }
-    else if( ((4+mypos->dir-dir)%4) == 2) // 行きたい方向が現在の進行方向と逆の場合
+    if(last - first == 1 && RouteActions[first] == RouteActions[last])
     {
-        priority = PRIORITY_LOWEST;
+        return FALSE;
     }
-    else // それ以外(左右どちらか)の場合
+    for(int action_i = first; action_i + 2 <= last; action_i++)
     {
-        priority = PRIORITY_LOW;
+        if(RouteActions[action_i] == RouteActions[action_i+1] 
+                && RouteActions[action_i+1] == RouteActions[action_i+2])
+        {
+            return FALSE;
+        }
     }
+    return TRUE;
+}
+
+static int compileDiagonalTurns(const int first, const int last, const int halfCells)
+{
+    // 連続したターンを斜め走行のコマンドに変換する
+    // ターンする区画の間の境界の中点を斜めの通過点とし、
+    // i番目の通過点はi番目とi+1番目のターンの区画の間にあるとする
+    // 戻り値は最後のターンの後に残る半区画の数(次の直進の補正値)
 
+    int num = last - first + 1; // ターンの数
+    const unsigned char *turns = &RouteActions[first - 1]; // 1番目から数える
 
-    if(isUnknown(x,y) == TRUE)
+    // 斜めに入る
+    int node; // 今いる通過点
+    if(turns[1] != turns[2])
     {
-        priority += PRIORITY_HIGHEST; // 未探索の場合優先度をさらに付加
+        // 直前の区画の中心から45度で入る
+        addMotionCommand(MOTION_STRAIGHT, FALSE, halfCells - 2);
+        addMotionCommand(MOTION_SLALOM45_IN, (turns[1] == LOCAL_RIGHT), 0);
+        node = 1;
+    }
+    else
+    {
+        // 区画の入口から135度で入る
+        addMotionCommand(MOTION_STRAIGHT, FALSE, halfCells - 1);
+        addMotionCommand(MOTION_SLALOM135_IN, (turns[1] == LOCAL_RIGHT), 0);
+        node = 2;
     }
 
-    return priority; // 優先度を返す
+    // 斜めから出る通過点
+    int exitNode;
+    int exitIs135;
+    if(turns[num] != turns[num-1])
+    {
+        exitNode = num - 1;
+        exitIs135 = FALSE;
+    }
+    else
+    {
+        exitNode = num - 2;
+        exitIs135 = TRUE;
+    }
+
+    // 斜め直進とV90度ターン
+    int diagonalStart = node;
+    for(int turn_i = node + 1; turn_i <= exitNode; turn_i++)
+    {
+        if(turns[turn_i] == turns[turn_i+1])
+        {
+            // 同じ向きのターンが2回続くところはV90度ターン
+            addMotionCommand(MOTION_DIAGONAL, FALSE, (turn_i - 1) - diagonalStart);
+            addMotionCommand(MOTION_SLALOM_V90, (turns[turn_i] == LOCAL_RIGHT), 0);
+            diagonalStart = turn_i + 1;
+            turn_i++;
+        }
+    }
+    addMotionCommand(MOTION_DIAGONAL, FALSE, exitNode - diagonalStart);
+
+    // 直線に戻る
+    if(exitIs135)
+    {
+        // 区画の出口まで135度で出る
+        addMotionCommand(MOTION_SLALOM135_OUT, (turns[num] == LOCAL_RIGHT), 0);
+        return -1;
+    }
+    // 次の区画の中心まで45度で出る
+    addMotionCommand(MOTION_SLALOM45_OUT, (turns[num] == LOCAL_RIGHT), 0);
+    return -2;
 }
 
-t_local_dir getNextDirection(const int goalX, const int goalY, const int mask, t_direction *dir,
-        const t_position *mypos)
+static void compileFastRoute(const int slalomEnable, const int diagonalEnable, t_position *mypos)
 {
-    // ゴール座標に向かう場合、今どちらに行くべきかを判断する。
-    // 探索、最短の切り替えのためのmaskを指定、dirは方角を示す
-    
-    // stepsが少ない移動方向を探す
-    t_steps lowestSteps = INIT_STEPS;
-    t_priority priority = PRIORITY_LOWEST;
+    // makeFastRoute()で作った経路をモーションコマンドに変換する
+    // mypos は経路を走り終えた位置と向きに更新する
 
-    t_priority tmp_priority;
+    MotionCommandNum = 0;
 
-    makeStepMap(goalX, goalY, mask); // 歩数Map生成
+    // 各区画での動作を求める
+    t_direction dir = mypos->dir;
+    for(int route_i = 0; route_i < RouteLength; route_i++)
+    {
+        RouteActions[route_i] = (4 + Route[route_i] - dir) % 4;
+        dir = Route[route_i];
 
-    // TODO:ここは同じことを４回書いてるので、もっとシンプルにできる
+        int x, y;
+        getNeighbor(mypos->x, mypos->y, dir, &x, &y);
+        mypos->x = x;
+        mypos->y = y;
+    }
+    mypos->dir = dir;
 
-    if( (WallMap[mypos->x][mypos->y].north & mask) == NOWALL) // 北に壁がなければ
+    // スタート地点ではその場で旋回する
+    switch(RouteActions[0])
     {
-        // 1区画先の歩数と優先度を取得
-        int nextX = mypos->x;
-        int nextY = mypos->y+1;
-        t_steps nextSteps = StepMap[nextX][nextY];
-        tmp_priority = getPriority(nextX, nextY, north, mypos);
+        case LOCAL_RIGHT:
+        case LOCAL_LEFT:
+            addMotionCommand(MOTION_PIVOT90, RouteActions[0] == LOCAL_RIGHT, 0);
+            break;
+        case LOCAL_REAR:
+            addMotionCommand(MOTION_PIVOT180, FALSE, 0);
+            break;
+    }
 
-        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+    int halfCells = 2; // 区画の中心までに直進する半区画の数
+    for(int route_i = 1; route_i < RouteLength; route_i++)
+    {
+        t_local_dir localDir = RouteActions[route_i];
+        if(localDir == LOCAL_FRONT)
         {
-            lowestSteps = nextSteps; // ひとまず北が歩数が小さい事にする
-            *dir = north; // 方向を保存
-            priority = tmp_priority; // 優先度を保存
+            halfCells += 2; // 1区画進む
+            continue;
         }
-        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+
+        if(localDir == LOCAL_REAR || slalomEnable == FALSE)
         {
-            if(priority < tmp_priority ) // 優先度を評価
+            addMotionCommand(MOTION_STRAIGHT, FALSE, halfCells);
+            if(localDir == LOCAL_REAR)
+            {
+                addMotionCommand(MOTION_PIVOT180, FALSE, 0);
+            }
+            else
             {
-                *dir = north; // 方向を更新
-                priority = tmp_priority; // 優先度を保存
+                addMotionCommand(MOTION_PIVOT90, localDir == LOCAL_RIGHT, 0);
             }
+            halfCells = 2;
+            continue;
         }
+
+        // 連続してターンする区画を探す
+        int last = route_i;
+        while(last + 1 < RouteLength 
+                && (RouteActions[last+1] == LOCAL_RIGHT || RouteActions[last+1] == LOCAL_LEFT))
+        {
+            last++;
+        }
+
+        // 斜めから抜けた後に減速する直線が残っている場合だけ斜めに走る
+        if(diagonalEnable && last + 1 < RouteLength && RouteActions[last+1] == LOCAL_FRONT
+                && isDiagonalTurns(route_i, last))
+        {
+            halfCells = compileDiagonalTurns(route_i, last, halfCells) + 2;
+            route_i = last;
+            continue;
+        }
+
+        // 同じ向きに2回続けて曲がるときは、180度ターンの方が速ければまとめて曲がる
+        if(route_i + 1 < RouteLength && RouteActions[route_i+1] == localDir
+                && fastTurnTime(FAST_TURN_180) < 2.0 * fastTurnTime(FAST_TURN_SMALL90))
+        {
+            addMotionCommand(MOTION_STRAIGHT, FALSE, halfCells - 1);
+            addMotionCommand(MOTION_SLALOM180, localDir == LOCAL_RIGHT, 0);
+            halfCells = 1;
+            route_i++;
+            continue;
+        }
+
+        // 前後の区画が直線なら、大回りの方が速いときは大回りする
+        // 小回りのときに前後の半区画を走る時間も含めて比べる
+        if(halfCells >= 2 && route_i + 1 < RouteLength && RouteActions[route_i+1] == LOCAL_FRONT
+                && fastTurnTime(FAST_TURN_LARGE90) < fastTurnTime(FAST_TURN_SMALL90) 
+                    + pCELL_DISTANCE / fastTurnSpeed(FAST_TURN_SMALL90))
+        {
+            addMotionCommand(MOTION_STRAIGHT, FALSE, halfCells - 2);
+            addMotionCommand(MOTION_LARGE90, localDir == LOCAL_RIGHT, 0);
+            halfCells = 0;
+            continue;
+        }
+
+        // スラロームは曲がる区画の入口から出口まで走るので、前後の半区画を使う
+        addMotionCommand(MOTION_STRAIGHT, FALSE, halfCells - 1);
+        addMotionCommand(MOTION_SLALOM90, localDir == LOCAL_RIGHT, 0);
+        halfCells = 1;
     }
+    addMotionCommand(MOTION_STRAIGHT, FALSE, halfCells);
+    addMotionCommand(MOTION_END, FALSE, 0);
+}
 
-    if( (WallMap[mypos->x][mypos->y].east & mask) == NOWALL) // 東に壁がなければ
+static int getMotionFastTurn(const int type)
+{
+    // モーションコマンドで使うターンの種類を返す
+    // ターンではないコマンドなら-1を返す
+    switch(type)
     {
-        // 1区画先の歩数と優先度を取得
-        int nextX = mypos->x+1;
-        int nextY = mypos->y;
-        t_steps nextSteps = StepMap[nextX][nextY];
-        tmp_priority = getPriority(nextX, nextY, east, mypos);
+        case MOTION_SLALOM90:
+            return FAST_TURN_SMALL90;
+        case MOTION_LARGE90:
+            return FAST_TURN_LARGE90;
+        case MOTION_SLALOM180:
+            return FAST_TURN_180;
+        case MOTION_SLALOM45_IN:
+        case MOTION_SLALOM45_OUT:
+            return FAST_TURN_45;
+        case MOTION_SLALOM135_IN:
+        case MOTION_SLALOM135_OUT:
+            return FAST_TURN_135;
+        case MOTION_SLALOM_V90:
+            return FAST_TURN_V90;
+        default:
+            return -1;
+    }
+}
 
-        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+static float getMotionDistance(const t_motion_command *command)
+{
+    // 直進するコマンドの走行距離
+    if(command->type == MOTION_DIAGONAL)
+    {
+        return pHALF_CELL_DISTANCE * M_SQRT2 * command->length;
+    }
+    return pHALF_CELL_DISTANCE * command->length;
+}
+
+static void planFastSpeeds(void)
+{
+    // モーションコマンドの境界での速度を決める
+    // ターンはqueueSlalomBase()の角加速度を速度の2乗に比例させれば同じ軌跡を遅く走れるので、
+    // 各ターンの速度の上限だけを与え、前向きに加速できる速度、後ろ向きに減速できる速度で
+    // 上限を削っていく
+    // ターンの速度は、角速度の表があるSLALOM_SPEEDSのどれかに揃える
+    // 直線の途中の最高速度はstraight()のS字加減速に任せる
+
+    // 各コマンドの速度の上限
+    SpeedLimits[0] = 0; // スタートでは止まっている
+    for(int command_i = 0; command_i < MotionCommandNum; command_i++)
+    {
+        t_motion_command *command = &MotionCommands[command_i];
+        int fastTurnType = getMotionFastTurn(command->type);
+        float limit;
+        if(fastTurnType >= 0)
         {
-            lowestSteps = nextSteps; // ひとまず東が歩数が小さい事にする
-            *dir = east; // 方向を保存
-            priority = tmp_priority; // 優先度を保存
+            limit = fastTurnSpeed(fastTurnType);
         }
-        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+        else if(command->type == MOTION_STRAIGHT)
         {
-            if(priority < tmp_priority) // 優先度を評価
-            {
-                *dir = east; // 方向を保存
-                priority = tmp_priority; // 優先度を保存
-            }
+            limit = pFAST_STRAIGHT_MAX_SPEED;
+        }
+        else if(command->type == MOTION_DIAGONAL)
+        {
+            limit = pFAST_DIAGONAL_MAX_SPEED;
+        }
+        else
+        {
+            limit = 0; // 超信地旋回とゴールでは止まる
+        }
+        SpeedLimits[command_i + 1] = limit;
+        if(SpeedLimits[command_i] > limit)
+        {
+            SpeedLimits[command_i] = limit;
         }
     }
 
-    if( (WallMap[mypos->x][mypos->y].south & mask) == NOWALL) // 南に壁がなければ
+    // ターンは角速度の表(slalom_table.c)がある速度まで落として曲がる
+    // 落とすと前後の直線の加減速が変わるので、ターンの速度が変わらなくなるまで繰り返す
+    // 速度は下がる一方で、表の速度の数も限られているので、繰り返しは終わる
+    int isTurnSpeedChanged;
+    do
     {
-        // 1区画先の歩数と優先度を取得
-        int nextX = mypos->x;
-        int nextY = mypos->y-1;
-        t_steps nextSteps = StepMap[nextX][nextY];
-        tmp_priority = getPriority(nextX, nextY, south, mypos);
+        // 前向きに、加速しきれる速度まで上限を下げる
+        for(int command_i = 0; command_i < MotionCommandNum; command_i++)
+        {
+            t_motion_command *command = &MotionCommands[command_i];
+            float reachSpeed = SpeedLimits[command_i]; // ターンは速度を変えない
+            if(command->type == MOTION_STRAIGHT || command->type == MOTION_DIAGONAL)
+            {
+                reachSpeed = straightReachSpeed(getMotionDistance(command),
+                        SpeedLimits[command_i], pFAST_ACCEL);
+            }
+            if(SpeedLimits[command_i + 1] > reachSpeed)
+            {
+                SpeedLimits[command_i + 1] = reachSpeed;
+            }
+        }
 
-        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+        // 後ろ向きに、減速しきれる速度まで上限を下げる
+        for(int command_i = MotionCommandNum - 1; command_i >= 0; command_i--)
         {
-            lowestSteps = nextSteps; // ひとまず南が歩数が小さい事にする
-            *dir = south; // 方向を保存
-            priority = tmp_priority; // 優先度を保存
+            t_motion_command *command = &MotionCommands[command_i];
+            float reachSpeed = SpeedLimits[command_i + 1];
+            if(command->type == MOTION_STRAIGHT || command->type == MOTION_DIAGONAL)
+            {
+                reachSpeed = straightReachSpeed(getMotionDistance(command),
+                        SpeedLimits[command_i + 1], pFAST_ACCEL);
+            }
+            if(SpeedLimits[command_i] > reachSpeed)
+            {
+                SpeedLimits[command_i] = reachSpeed;
+            }
         }
-        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+
+        isTurnSpeedChanged = FALSE;
+        for(int command_i = 0; command_i < MotionCommandNum; command_i++)
         {
-            if(priority < tmp_priority) // 優先度を評価
+            if(getMotionFastTurn(MotionCommands[command_i].type) < 0)
+            {
+                continue;
+            }
+            float turnSpeed = slalomSpeedClass(SpeedLimits[command_i]);
+            if(turnSpeed < SpeedLimits[command_i])
             {
-                *dir = south; // 方向を保存
-                priority = tmp_priority; // 優先度を保存
+                SpeedLimits[command_i] = turnSpeed;
+                SpeedLimits[command_i + 1] = turnSpeed;
+                isTurnSpeedChanged = TRUE;
             }
         }
-    }
+    } while(isTurnSpeedChanged);
 
-    if( (WallMap[mypos->x][mypos->y].west & mask) == NOWALL) // 西に壁がなければ
+    for(int command_i = 0; command_i < MotionCommandNum; command_i++)
     {
-        // 1区画先の歩数と優先度を取得
-        int nextX = mypos->x-1;
-        int nextY = mypos->y;
-        t_steps nextSteps = StepMap[nextX][nextY];
-        tmp_priority = getPriority(nextX, nextY, west, mypos);
-
-        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+        t_motion_command *command = &MotionCommands[command_i];
+        float endSpeed = SpeedLimits[command_i + 1];
+        // 遅すぎるとstraight()が止まってしまうので、ターンには最低速度で入る
+        // スタート直後や超信地旋回の直後で加速しきれないときは、速度が飛ぶ
+        if(getMotionFastTurn(command->type) >= 0 && endSpeed < pFAST_MIN_TURN_SPEED)
         {
-            lowestSteps = nextSteps; // ひとまず西が歩数が小さい事にする
-            *dir = west; // 方向を保存
-            priority = tmp_priority; // 優先度を保存
+            endSpeed = pFAST_MIN_TURN_SPEED;
         }
-        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+        command->endSpeed = endSpeed;
+    }
+    // 直線の終わりはターンの速度に合わせる
+    for(int command_i = 0; command_i + 1 < MotionCommandNum; command_i++)
+    {
+        if(getMotionFastTurn(MotionCommands[command_i + 1].type) >= 0)
         {
-            *dir = west; // 方向を保存
-            priority = tmp_priority; // 優先度を保存
+            MotionCommands[command_i].endSpeed = MotionCommands[command_i + 1].endSpeed;
         }
     }
-
-    // TODO:ここはわかりにくい
-    return ( (int)( ( 4 + *dir - mypos->dir) % 4 ) ); // どっちに向かうべきかを返す。
 }
 
-void setWall(const t_position *mypos)
+// 探索中の次の動作の計画
+// 区画の境界で読んだ壁を計画タスクに渡し、走行制御を止めずに次の動作を待つ
+// 計画タスクは、次の動作を返したらすぐに、その次の区画の境界で読みうる壁の組み合わせごとに
+// 次の動作を先読みしておく。境界では読んだ壁に合う先読みの結果を使い、待たずに走り出す
+typedef enum
 {
-    // 自分のいる座標に壁情報を書き込む
-    
-    int n_write=NOWALL,s_write=NOWALL,e_write=NOWALL,w_write=NOWALL;
+    PLAN_MOVE, // 壁を書き込んで次の動作を決め、結果を返す
+    PLAN_COMMIT, // 先読みの結果を使ったので、壁を書き込むだけで結果は返さない
+    PLAN_SYNC, // 何もせずに返す(それまでの計画と先読みが終わったことがわかる)
+}t_plan_type;
 
-    int x = mypos->x;
-    int y = mypos->y;
+typedef struct
+{
+    t_plan_type type;
+    int sequence; // 計画の番号(先読みがどの計画のあとで作られたかを表す)
+    t_goal goal;
+    int isExploring; // TRUEなら、ゴールではなく最短経路になりうる区画に向かう
+    t_position pos; // 壁を読んだ区画と向き
+    int isWall[DIREC_NUM]; // 壁を読んだときのセンサの値
+}t_plan_request;
 
-    // 自分の方向に応じて書き込むデータを生成
-    switch(mypos->dir){
-        case north:
-            n_write = CONV_SEN2WALL(gObsIsWall[DIREC_FRONT]); // 前壁の有無を判断
-            e_write = CONV_SEN2WALL(gObsIsWall[DIREC_RIGHT]); // 右壁の有無を判断
-            w_write = CONV_SEN2WALL(gObsIsWall[DIREC_LEFT]); // 左壁の有無を判断
-            s_write = NOWALL; // 後ろは必ず壁がない
-            break;
+typedef struct
+{
+    t_local_dir localDir; // 次に向かう方向(LOCAL_UNKNOWNなら最短経路が確定した)
+    t_direction dir; // 次に向かう方角
+    int cells; // まとめて直進できる区画数
+    int isReachable; // 今いる区画からゴールに辿り着けるか
+}t_plan_result;
+
+// 先読みの結果
+// 前、左、右の壁の有無(ビット0、1、2)の組み合わせごとに次の動作を持つ
+// わかっている壁と違う組み合わせは計画しない
+#define WALL_PATTERN_NUM 8
+typedef struct
+{
+    int sequence; // 元になった計画の番号
+    t_goal goal;
+    int isExploring;
+    t_position pos; // 先読みした区画と向き
+    unsigned char isPlanned[WALL_PATTERN_NUM];
+    t_plan_result results[WALL_PATTERN_NUM];
+}t_plan_speculation;
+
+static QueueHandle_t PlanRequestQueue = NULL;
+static QueueHandle_t PlanResultQueue = NULL;
+static QueueHandle_t SpeculationQueue = NULL;
+static int PlanSequence = 0; // 最後に頼んだ計画の番号
+static t_plan_speculation Speculation; // 計画タスクがないときの先読みの結果
+
+static void planNextMove(const t_plan_request *request, t_plan_result *result)
+{
+    // 壁を書き込んで、次に向かう方向を決める
+    setWall(&request->goal, &request->pos, request->isWall);
 
-        case east:
-            e_write = CONV_SEN2WALL(gObsIsWall[DIREC_FRONT]); // 前壁の有無を判断
-            s_write = CONV_SEN2WALL(gObsIsWall[DIREC_RIGHT]); // 右壁の有無を判断
-            n_write = CONV_SEN2WALL(gObsIsWall[DIREC_LEFT]); // 左壁の有無を判断
-            w_write = NOWALL; // 後ろは必ず壁がない
-            break;
+    result->dir = request->pos.dir;
+    if(request->isExploring)
+    {
+        result->localDir = getNextCandidateDirection(&request->goal, 
+                &result->dir, &request->pos);
+    }
+    else
+    {
+        result->localDir = getNextDirection(&request->goal, MASK_SEARCH, 
+                &result->dir, &request->pos);
+    }
+    result->isReachable = (getSteps(request->pos.x, request->pos.y) != INIT_STEPS);
+    result->cells = 1;
+    if(result->localDir == LOCAL_FRONT)
+    {
+        result->cells = countKnownStraightCells(&request->pos);
+    }
+}
 
-        case south:
-            s_write = CONV_SEN2WALL(gObsIsWall[DIREC_FRONT]); // 前壁の有無を判断
-            w_write = CONV_SEN2WALL(gObsIsWall[DIREC_RIGHT]); // 右壁の有無を判断
-            e_write = CONV_SEN2WALL(gObsIsWall[DIREC_LEFT]); // 左壁の有無を判断
-            n_write = NOWALL; // 後ろは必ず壁がない
-            break;
+static int getWallPattern(const int isWall[DIREC_NUM])
+{
+    // 前、左、右の壁の有無を先読みの組み合わせの番号にする
+    return (isWall[DIREC_FRONT] ? 1 : 0) | (isWall[DIREC_LEFT] ? 2 : 0) 
+        | (isWall[DIREC_RIGHT] ? 4 : 0);
+}
 
-        case west:
-            w_write = CONV_SEN2WALL(gObsIsWall[DIREC_FRONT]); // 前壁の有無を判断
-            n_write = CONV_SEN2WALL(gObsIsWall[DIREC_RIGHT]); // 右壁の有無を判断
-            s_write = CONV_SEN2WALL(gObsIsWall[DIREC_LEFT]); // 左壁の有無を判断
-            e_write = NOWALL; // 後ろは必ず壁がない
-            break;
+static int isPossibleWallPattern(const t_position *pos, const int pattern)
+{
+    // わかっている壁と矛盾しない組み合わせならTRUEを返す
+    // 仮想壁は実際の壁の有無がわからないので、どちらも読みうる
+    const t_direction sides[3] = {pos->dir, (pos->dir + 3) % 4, (pos->dir + 1) % 4}; // 前、左、右
+    for(int side_i = 0; side_i < 3; side_i++)
+    {
+        int wall = getWall(pos->x, pos->y, sides[side_i]);
+        int isWall = (pattern >> side_i) & 1;
+        if((wall == WALL && isWall == FALSE) || (wall == NOWALL && isWall == TRUE))
+        {
+            return FALSE;
+        }
     }
-    WallMap[x][y].north = n_write;
-    WallMap[x][y].south = s_write;
-    WallMap[x][y].east  = e_write;
-    WallMap[x][y].west  = w_write;
+    return TRUE;
+}
 
-    // 周りの区画の壁情報も更新する
-    if(y < MAZESIZE_Y-1) // 配列の範囲外アクセス防止
+static void speculateNextMove(const t_plan_request *request, const t_plan_result *result,
+        t_plan_speculation *speculation)
+{
+    // resultの動作で着く次の区画の境界で読みうる壁の組み合わせごとに、次の動作を計画しておく
+    // 仮の壁を書き込んで計画するので、終わったら迷路の状態を元に戻す
+    speculation->sequence = request->sequence;
+    speculation->goal = request->goal;
+    speculation->isExploring = request->isExploring;
+    for(int pattern = 0; pattern < WALL_PATTERN_NUM; pattern++)
     {
-        WallMap[x][y+1].south = n_write;
+        speculation->isPlanned[pattern] = FALSE;
     }
-    if(x < MAZESIZE_X-1)
+    if(result->localDir == LOCAL_UNKNOWN)
     {
-        WallMap[x+1][y].west = e_write;
+        return; // 最短経路が確定したので次の動作はない
     }
-    if(y > 0)
+
+    t_position pos = request->pos;
+    pos.dir = result->dir;
+    for(int cell_i = 0; cell_i < result->cells; cell_i++)
     {
-        WallMap[x][y-1].north = s_write;
+        int nextX, nextY;
+        getNeighbor(pos.x, pos.y, pos.dir, &nextX, &nextY);
+        pos.x = nextX;
+        pos.y = nextY;
     }
-    if(x > 0)
+    speculation->pos = pos;
+    if(request->isExploring == FALSE && isGoal(&request->goal, pos.x, pos.y))
     {
-        WallMap[x-1][y].east = w_write;
+        return; // ゴールに着いたら止まる
     }
-}
 
-void initMaze(void)
-{
-    // 迷路情報の初期化
-    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+    t_plan_request nextRequest = *request;
+    nextRequest.pos = pos;
+    saveMazeState();
+    for(int pattern = 0; pattern < WALL_PATTERN_NUM; pattern++)
     {
-        for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+        if(isPossibleWallPattern(&pos, pattern) == FALSE)
         {
-            WallMap[x_i][y_i].north = 
-                WallMap[x_i][y_i].east = 
-                WallMap[x_i][y_i].south = 
-                WallMap[x_i][y_i].west = UNKNOWN; // 迷路の全体がわからない事を設定する
+            continue;
         }
+        nextRequest.isWall[DIREC_FRONT] = (pattern >> 0) & 1;
+        nextRequest.isWall[DIREC_LEFT] = (pattern >> 1) & 1;
+        nextRequest.isWall[DIREC_RIGHT] = (pattern >> 2) & 1;
+        planNextMove(&nextRequest, &speculation->results[pattern]);
+        speculation->isPlanned[pattern] = TRUE;
+        restoreMazeState();
     }
+}
 
-    // 一番外側の壁を追加する
-    // 上下
-    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+static int findSpeculation(const t_plan_speculation *speculation, const t_plan_request *request,
+        t_plan_result *result)
+{
+    // 今読んだ壁に合う先読みの結果があれば、resultに入れてTRUEを返す
+    int pattern = getWallPattern(request->isWall);
+    if(speculation->sequence != PlanSequence
+            || speculation->isPlanned[pattern] == FALSE
+            || speculation->isExploring != request->isExploring
+            || memcmp(&speculation->goal, &request->goal, sizeof(t_goal)) != 0
+            || speculation->pos.x != request->pos.x || speculation->pos.y != request->pos.y
+            || speculation->pos.dir != request->pos.dir)
     {
-        WallMap[x_i][0].south = WALL; // 四方の壁を追加する(南)
-        WallMap[x_i][MAZESIZE_Y-1].north = WALL; // 四方の壁を追加する(北)
+        return FALSE;
     }
+    *result = speculation->results[pattern];
+    return TRUE;
+}
 
-    // 左右
-    for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+static void TaskPlanner(void *arg)
+{
+    // 走行制御と別のコアで次の動作を計画する
+    // 結果を返したあと、次の区画の境界までに次の動作を先読みしておく
+    (void)arg;
+    t_plan_request request;
+    t_plan_result result = {0};
+    static t_plan_speculation speculation;
+
+    while(1)
     {
-        WallMap[0][y_i].west = WALL; // 四方の壁を追加する(西)
-        WallMap[MAZESIZE_X-1][y_i].east = WALL; // 四方の壁を追加する(東)
+        if(xQueueReceive(PlanRequestQueue, &request, portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+        if(request.type == PLAN_SYNC)
+        {
+            xQueueSend(PlanResultQueue, &result, portMAX_DELAY);
+            continue;
+        }
+        planNextMove(&request, &result);
+        if(request.type == PLAN_MOVE)
+        {
+            xQueueSend(PlanResultQueue, &result, portMAX_DELAY);
+        }
+        speculateNextMove(&request, &result, &speculation);
+        xQueueOverwrite(SpeculationQueue, &speculation);
     }
-
-    // スタート地点の右の壁を追加
-    WallMap[0][0].east = WallMap[1][0].west = WALL; // スタート地点の右の壁を追加する
 }
 
-void searchAdachi(const int goalX, const int goalY, const int slalomEnable, 
-        const int doInitKetsuate,
-        t_position *mypos){
-    //引数goalX,goalYに向かって足立法で迷路を探索する
-    float endSpeed = pSEARCH_MAX_SPEED;
+void startPlanner(void)
+{
+    // 計画タスクをコア0で起動する
+    // 走行制御はコア1で動かす
+    PlanRequestQueue = xQueueCreate(1, sizeof(t_plan_request));
+    PlanResultQueue = xQueueCreate(1, sizeof(t_plan_result));
+    SpeculationQueue = xQueueCreate(1, sizeof(t_plan_speculation));
+    xTaskCreatePinnedToCore(TaskPlanner, "TaskPlanner", 4096, NULL, 5, NULL, 0);
+}
 
-    t_direction glob_nextdir; // 次に向かう方向を記録する変数
+static void waitPlanner(void)
+{
+    // 計画タスクの計画と先読みが終わるまで待つ
+    // このあとは、計画タスクに頼まずに迷路を読み書きしてよい
+    PlanSequence++; // 迷路が書き換わるかもしれないので、今までの先読みは使わない
+    if(PlanRequestQueue == NULL)
+    {
+        return;
+    }
+    t_plan_request request;
+    t_plan_result result;
+    request.type = PLAN_SYNC;
+    request.sequence = PlanSequence;
+    xQueueSend(PlanRequestQueue, &request, portMAX_DELAY);
+    xQueueReceive(PlanResultQueue, &result, portMAX_DELAY);
+}
 
-    // 移動距離を初期化
-    gObsMovingDistance = 0;
+static void getNextMove(const t_goal *goal, const int isExploring, const t_position *mypos,
+        t_plan_result *result)
+{
+    // 今読んだ壁から次の動作を決める
+    // 先読みの結果があればそれを使い、壁の書き込みは計画タスクに任せて待たない
+    // なければ、計画タスクが計画している間も、今の速度のまま走行制御を続ける
+    t_plan_request request;
+    request.goal = *goal;
+    request.isExploring = isExploring;
+    request.pos = *mypos;
+    for(int direc_i = 0; direc_i < DIREC_NUM; direc_i++)
+    {
+        request.isWall[direc_i] = gObsIsWall[direc_i];
+    }
 
-    gMotorState = MOTOR_ON;
+    if(PlanRequestQueue == NULL)
+    {
+        // 計画タスクがなければその場で計画し、次の動作も先読みする
+        // 先読みの結果が実際の計画と違えば警告する
+        t_plan_result speculated;
+        int isSpeculated = findSpeculation(&Speculation, &request, &speculated);
+        request.sequence = ++PlanSequence;
+        planNextMove(&request, result);
+        if(isSpeculated && memcmp(&speculated, result, sizeof(t_plan_result)) != 0)
+        {
+            ESP_LOGW(TAG, "Speculated move differs at (%d, %d)", mypos->x, mypos->y);
+        }
+        speculateNextMove(&request, result, &Speculation);
+        return;
+    }
 
-    // スタート直後のけつあて調整
-    if(doInitKetsuate){
-        ketsuate(endSpeed);
+    t_plan_speculation speculation;
+    int isSpeculated = (xQueueReceive(SpeculationQueue, &speculation, 0) == pdTRUE
+            && findSpeculation(&speculation, &request, result));
+    request.type = isSpeculated ? PLAN_COMMIT : PLAN_MOVE;
+    request.sequence = ++PlanSequence;
+    xQueueSend(PlanRequestQueue, &request, portMAX_DELAY);
+    if(isSpeculated)
+    {
+        return;
+    }
+    while(xQueueReceive(PlanResultQueue, result, 0) != pdTRUE)
+    {
+        keepSpeed();
     }
+}
 
-    switch(getNextDirection(goalX,goalY,MASK_SEARCH,&glob_nextdir,mypos)) // 次に行く方向を戻り値とする関数を呼ぶ
+static void startSearchMove(const t_local_dir localDir, const float endSpeed){
+    // 区画の中心で止まっている状態から、localDirの方向を向いて区画の境界まで進む
+    // 旋回と直進をキューに入れ、つなぎ目で止まらずに走る
+    int ticket = 0;
+    switch(localDir)
     {
         case LOCAL_FRONT:
 
-            searchStraight(pHALF_CELL_DISTANCE, endSpeed);
+            ticket = queueSearchStraight(pHALF_CELL_DISTANCE, endSpeed);
             break;
 
         case LOCAL_RIGHT:
-            turn(-M_PI_2, pSEARCH_TIMEOUT);
-            searchStraight(pHALF_CELL_DISTANCE, endSpeed);
+            queueTurn(-M_PI_2, pSEARCH_TIMEOUT);
+            ticket = queueSearchStraight(pHALF_CELL_DISTANCE, endSpeed);
             break;
 
         case LOCAL_LEFT:
-            turn(M_PI_2, pSEARCH_TIMEOUT);
-            searchStraight(pHALF_CELL_DISTANCE, endSpeed);
+            queueTurn(M_PI_2, pSEARCH_TIMEOUT);
+            ticket = queueSearchStraight(pHALF_CELL_DISTANCE, endSpeed);
             break;
 
         case LOCAL_REAR:
-            turn(M_PI, pSEARCH_TIMEOUT);
-            searchStraight(pHALF_CELL_DISTANCE, endSpeed);
+            queueTurn(M_PI, pSEARCH_TIMEOUT);
+            ticket = queueSearchStraight(pHALF_CELL_DISTANCE, endSpeed);
             break;
     }
+    motionWait(ticket);
+}
 
-    mypos->dir = glob_nextdir; // 方向を更新
+static void moveSearchPosition(const t_direction dir, t_position *mypos){
+    mypos->dir = dir; // 方向を更新
 
     // 向いた方向によって自分の座標を更新する
     switch(mypos->dir)
@@ -489,107 +1046,102 @@ void searchAdachi(const int goalX, const int goalY, const int slalomEnable,
             mypos->x--; // 西を向いたときはX座標を減らす
             break;
     }
+}
 
-
+static void moveSearch(const t_plan_result *nextMove, const int slalomEnable, 
+        const float endSpeed, const int toggleBlink, t_position *mypos){
+    // 区画の境界から、nextMoveの方向に進んで次の区画の境界まで走る
+    // まとめて直進できるときは、その区画数だけ進む
+    // 動作をキューに入れ、つなぎ目で止まらずに走る
     int doHipAdjust = 0; // けつあて補正
-    int toggleBlink = 0; // １区画ごとに点灯と点滅を切り替える
-    while((mypos->x != goalX) || (mypos->y != goalY)){ // ゴールするまで繰り返す
-
-        setWall(mypos); // 壁をセット
-
-        // 次に行く方向を戻り値とする関数を呼ぶ
-        switch(getNextDirection(goalX,goalY,MASK_SEARCH,&glob_nextdir,mypos)) 
-        {
-            case LOCAL_FRONT:
-                gIndicatorValue = 0 + 3*toggleBlink; // デバッグ用のLED点灯
-                searchStraight(pCELL_DISTANCE, endSpeed);
-                break;
+    int ticket = 0;
 
-            case LOCAL_RIGHT:
-                gIndicatorValue = 0 + 3*toggleBlink; // デバッグ用のLED点灯
-                if(slalomEnable){
-                    slalom(TRUE, endSpeed, pSEARCH_TIMEOUT);
-                }else{
-                    if(gObsIsWall[DIREC_LEFT] == 1){
-                        // 左に壁があればけつあて
-                        doHipAdjust = 1;
-                    }
-                    searchStraight(pHALF_CELL_DISTANCE, 0.0);
-                    turn(-M_PI_2, pSEARCH_TIMEOUT);
-                    if(doHipAdjust){
-                        ketsuate(endSpeed);
-                        doHipAdjust = 0;
+    switch(nextMove->localDir)
+    {
+        case LOCAL_FRONT:
+            gIndicatorValue = 0 + 3*toggleBlink; // デバッグ用のLED点灯
+            {
+                int cells = nextMove->cells;
+                if(cells > 1){
+                    // 探索済みの区画は最短走行の速度でまとめて走る
+                    ticket = queueSearchKnownStraight(pCELL_DISTANCE * cells, endSpeed);
+                    // 最後の1区画分は下で進める
+                    for(int cell_i = 1; cell_i < cells; cell_i++){
+                        int nextX, nextY;
+                        getNeighbor(mypos->x, mypos->y, mypos->dir, &nextX, &nextY);
+                        mypos->x = nextX;
+                        mypos->y = nextY;
                     }
-                    searchStraight(pHALF_CELL_DISTANCE, endSpeed);
-                }
-                break;
-
-            case LOCAL_LEFT:
-                gIndicatorValue = 0 + 3*toggleBlink; // デバッグ用のLED点灯
-                if(slalomEnable){
-                    slalom(FALSE, endSpeed, pSEARCH_TIMEOUT);
                 }else{
-                    if(gObsIsWall[DIREC_RIGHT] == 1){
-                        // 右に壁があればけつあて
-                        doHipAdjust = 1;
-                    }
-                    searchStraight(pHALF_CELL_DISTANCE, 0.0);
-                    turn(M_PI_2, pSEARCH_TIMEOUT);
-                    if(doHipAdjust){
-                        ketsuate(endSpeed);
-                        doHipAdjust = 0;
-                    }
-                    searchStraight(pHALF_CELL_DISTANCE, endSpeed);
+                    ticket = queueSearchStraight(pCELL_DISTANCE, endSpeed);
                 }
-                break;
+            }
+            break;
 
-            case LOCAL_REAR:
-                gIndicatorValue = 6; // デバッグ用のLED点灯
-                if(gObsIsWall[DIREC_FRONT] == 1){
-                    // 前に壁があればけつあて
+        case LOCAL_RIGHT:
+            gIndicatorValue = 0 + 3*toggleBlink; // デバッグ用のLED点灯
+            if(slalomEnable){
+                ticket = queueSlalom(TRUE, endSpeed, pSEARCH_TIMEOUT);
+            }else{
+                if(gObsIsWall[DIREC_LEFT] == 1){
+                    // 左に壁があればけつあて
                     doHipAdjust = 1;
                 }
-                searchStraight(pHALF_CELL_DISTANCE, 0.0);
-                turn(M_PI, pSEARCH_TIMEOUT);
+                queueSearchStraight(pHALF_CELL_DISTANCE, 0.0);
+                queueTurn(-M_PI_2, pSEARCH_TIMEOUT);
                 if(doHipAdjust){
+                    // けつあては旋回が終わるのを待ってから始まる
                     ketsuate(endSpeed);
                     doHipAdjust = 0;
                 }
-                searchStraight(pHALF_CELL_DISTANCE, endSpeed);
-                break;
-        }
-
-        mypos->dir = glob_nextdir; // 方向を更新
-
-        // 向いた方向によって自分の座標を更新する
-        switch(mypos->dir)
-        {
-            case north:
-                mypos->y++; // 北を向いた時はY座標を増やす
-                break;
-
-            case east:
-                mypos->x++; // 東を向いた時はX座標を増やす
-                break;
-
-            case south:
-                mypos->y--; // 南を向いた時はY座標を減らす
-                break;
+                ticket = queueSearchStraight(pHALF_CELL_DISTANCE, endSpeed);
+            }
+            break;
 
-            case west:
-                mypos->x--; // 西を向いたときはX座標を減らす
-                break;
-        }
+        case LOCAL_LEFT:
+            gIndicatorValue = 0 + 3*toggleBlink; // デバッグ用のLED点灯
+            if(slalomEnable){
+                ticket = queueSlalom(FALSE, endSpeed, pSEARCH_TIMEOUT);
+            }else{
+                if(gObsIsWall[DIREC_RIGHT] == 1){
+                    // 右に壁があればけつあて
+                    doHipAdjust = 1;
+                }
+                queueSearchStraight(pHALF_CELL_DISTANCE, 0.0);
+                queueTurn(M_PI_2, pSEARCH_TIMEOUT);
+                if(doHipAdjust){
+                    ketsuate(endSpeed);
+                    doHipAdjust = 0;
+                }
+                ticket = queueSearchStraight(pHALF_CELL_DISTANCE, endSpeed);
+            }
+            break;
 
-        // LEDの点灯と点滅を切り替える
-        if(toggleBlink==0){
-            toggleBlink=1;
-        }else{
-            toggleBlink=0;
-        }
+        case LOCAL_REAR:
+            gIndicatorValue = 6; // デバッグ用のLED点灯
+            if(gObsIsWall[DIREC_FRONT] == 1){
+                // 前に壁があればけつあて
+                doHipAdjust = 1;
+            }
+            queueSearchStraight(pHALF_CELL_DISTANCE, 0.0);
+            queueTurn(M_PI, pSEARCH_TIMEOUT);
+            if(doHipAdjust){
+                ketsuate(endSpeed);
+                doHipAdjust = 0;
+            }
+            ticket = queueSearchStraight(pHALF_CELL_DISTANCE, endSpeed);
+            break;
     }
 
-    setWall(mypos); // 壁をセット
+    // 次の区画の境界で壁を読むので、走り終わるまで待つ
+    motionWait(ticket);
+    moveSearchPosition(nextMove->dir, mypos);
+}
+
+static void stopSearch(const t_goal *goal, t_position *mypos){
+    // 区画の境界から区画の中心まで進んで止まる
+    waitPlanner(); // 計画タスクが迷路を書き換え終わってから壁をセットする
+    setWall(goal, mypos, gObsIsWall); // 壁をセット
     searchStraight(pHALF_CELL_DISTANCE, 0.0);
     // straight(HALF_SECTION,SEARCH_ACCEL,SEARCH_SPEED,0);	
     // 制御終了状態
@@ -599,11 +1151,21 @@ void searchAdachi(const int goalX, const int goalY, const int slalomEnable,
     gMotorState = MOTOR_OFF;
 }
 
-void fastRun(const int goalX, const int goalY, const int slalomEnable, 
-        const int doInitKetsuate, t_position *mypos){
+static int saveWallAsync(void){
+    // 今の壁情報をコピーして、保存を書き込みタスクに頼む
+    // SPIフラッシュに書き込む間は両方のコアで命令キャッシュが止まり、1 msの制御周期が遅れるので、
+    // 止まっているときだけ呼び、走り出す前にloggingWaitWrite()で書き終わるのを待つこと
+    static t_wall wallMap[MAZESIZE_X][MAZESIZE_Y];
+    getWallMap(wallMap);
+    return loggingSaveWallAsync(MAZESIZE_X, MAZESIZE_Y, wallMap);
+}
 
-    //引数goalX,goalYに向かって最短走行する
-    float endSpeed = pFAST_MAX_SPEED;
+void searchAdachi(const t_goal *goal, const int slalomEnable, 
+        const int doInitKetsuate,
+        t_position *mypos){
+    //引数goalのゴール区画に向かって足立法で迷路を探索する
+    // ゴール区画のどこかに入ったら終わる
+    float endSpeed = pSEARCH_MAX_SPEED;
 
     t_direction glob_nextdir; // 次に向かう方向を記録する変数
 
@@ -617,125 +1179,140 @@ void fastRun(const int goalX, const int goalY, const int slalomEnable,
         ketsuate(endSpeed);
     }
 
-    float straightCount=0; // 直進区画を連続走行するためのカウンタ
+    // 次に行く方向を戻り値とする関数を呼ぶ
+    startSearchMove(getNextDirection(goal,MASK_SEARCH,&glob_nextdir,mypos), endSpeed);
+    moveSearchPosition(glob_nextdir, mypos);
 
-    // 現在の向きから、次に行くべき方向を向く
-    switch(getNextDirection(goalX,goalY,MASK_SECOND,&glob_nextdir,mypos)) // 次に行く方向を戻り値とする関数を呼ぶ
-    {
-        case LOCAL_FRONT:
-            // すぐに前進はせず、あとでまとめて前進する
-            straightCount++;
-            break;
+    int toggleBlink = 0; // １区画ごとに点灯と点滅を切り替える
+    while(isGoal(goal, mypos->x, mypos->y) == FALSE){ // ゴールするまで繰り返す
+
+        // 壁をセットして次に行く方向を決める
+        // 計画を待つ間も止まらずに進み、その距離は次の動作で差し引かれる
+        t_plan_result nextMove;
+        getNextMove(goal, FALSE, mypos, &nextMove);
+        if(nextMove.isReachable == FALSE){
+            break; // 壁に囲まれてゴールに行けなくなった
+        }
+        moveSearch(&nextMove, slalomEnable, endSpeed, toggleBlink, mypos);
 
-        case LOCAL_RIGHT:
-            turn(-M_PI_2, pFAST_TIMEOUT);
-            straightCount = 1;
-            break;
+        // LEDの点灯と点滅を切り替える
+        if(toggleBlink==0){
+            toggleBlink=1;
+        }else{
+            toggleBlink=0;
+        }
+    }
 
-        case LOCAL_LEFT:
-            turn(M_PI_2, pFAST_TIMEOUT);
-            straightCount = 1;
-            break;
+    stopSearch(goal, mypos);
+}
 
-        case LOCAL_REAR:
-            turn(M_PI, pFAST_TIMEOUT);
-            straightCount = 1;
-            break;
+void searchShortestRoute(const t_goal *goal, const int slalomEnable, t_position *mypos){
+    // 引数goalのゴール区画までの最短経路が確定するまで、
+    // 最短経路になりうる未探索の区画のうち、一番近い区画に向かって探索する
+    // 区画に入るたびに向かう区画を選び直すので、止まらずに次の候補へ向かう
+    // 確定したら区画の中心で止まる
+    float endSpeed = pSEARCH_MAX_SPEED;
+
+    t_direction glob_nextdir = mypos->dir; // 次に向かう方向を記録する変数
+    t_local_dir localDir = getNextCandidateDirection(goal, &glob_nextdir, mypos);
+    if(localDir == LOCAL_UNKNOWN){
+        return; // もう探索しなくてよい
     }
 
-    mypos->dir = glob_nextdir; // 方向を更新
+    // 移動距離を初期化
+    gObsMovingDistance = 0;
 
-    // 向いた方向によって自分の座標を更新する
-    switch(mypos->dir)
-    {
-        case north:
-            mypos->y++; // 北を向いた時はY座標を増やす
-            break;
+    gMotorState = MOTOR_ON;
 
-        case east:
-            mypos->x++; // 東を向いた時はX座標を増やす
-            break;
+    startSearchMove(localDir, endSpeed);
+    moveSearchPosition(glob_nextdir, mypos);
 
-        case south:
-            mypos->y--; // 南を向いた時はY座標を減らす
-            break;
+    int toggleBlink = 0; // １区画ごとに点灯と点滅を切り替える
+    while(1){
+        t_plan_result nextMove;
+        getNextMove(goal, TRUE, mypos, &nextMove);
+        if(nextMove.localDir == LOCAL_UNKNOWN){
+            break; // 最短経路が確定した
+        }
+        moveSearch(&nextMove, slalomEnable, endSpeed, toggleBlink, mypos);
 
-        case west:
-            mypos->x--; // 西を向いたときはX座標を減らす
-            break;
+        // LEDの点灯と点滅を切り替える
+        if(toggleBlink==0){
+            toggleBlink=1;
+        }else{
+            toggleBlink=0;
+        }
     }
 
-    while((mypos->x != goalX) || (mypos->y != goalY)){ // ゴールするまで繰り返す
+    stopSearch(goal, mypos);
+}
 
-        // 次に行く方向を戻り値とする関数を呼ぶ
-        switch(getNextDirection(goalX,goalY,MASK_SECOND,&glob_nextdir,mypos)) 
-        {
-            case LOCAL_FRONT:
-                straightCount++;
-                break;
+void fastRun(const t_goal *goal, const int slalomEnable, 
+        const int diagonalEnable, const int doInitKetsuate, t_position *mypos){
 
-            case LOCAL_RIGHT:
-                if(slalomEnable){
-                    straightCount -= 0.5; // 半区画分調整
-                    fastStraight(pCELL_DISTANCE * straightCount, endSpeed);
-                    fastSlalom(TRUE, endSpeed, pFAST_TIMEOUT);
-                    straightCount = 0.5; // 半区画分調整
-                }else{
-                    fastStraight(pCELL_DISTANCE * straightCount, 0.0);
-                    turn(-M_PI_2, pFAST_TIMEOUT);
-                    straightCount = 1; // 直線走行距離をリセット
-                }
-                break;
+    //引数goalのゴール区画に向かって最短走行する
+    // 走り出す前に、走行時間が最小の経路を作ってモーションコマンドに変換しておく
+    float endSpeed = pFAST_MAX_SPEED;
 
-            case LOCAL_LEFT:
-                if(slalomEnable){
-                    straightCount -= 0.5; // 半区画分調整
-                    fastStraight(pCELL_DISTANCE * straightCount, endSpeed);
-                    fastSlalom(FALSE, endSpeed, pFAST_TIMEOUT);
-                    straightCount = 0.5; // 半区画分調整
-                }else{
-                    fastStraight(pCELL_DISTANCE * straightCount, 0.0);
-                    turn(M_PI_2, pFAST_TIMEOUT);
-                    straightCount = 1; // 直線走行距離をリセット
-                }
-                break;
+    if(makeFastRoute(goal, slalomEnable, mypos) == FALSE || RouteLength == 0){
+        return;
+    }
+    compileFastRoute(slalomEnable, diagonalEnable, mypos);
+    planFastSpeeds();
+
+    // 移動距離を初期化
+    gObsMovingDistance = 0;
+
+    gMotorState = MOTOR_ON;
 
-            case LOCAL_REAR:
-                fastStraight(pCELL_DISTANCE * straightCount, 0.0);
-                turn(M_PI, pFAST_TIMEOUT);
-                straightCount = 1; // 直線走行距離をリセット
+    // スタート直後のけつあて調整
+    if(doInitKetsuate){
+        ketsuate(endSpeed);
+    }
+
+    // 全てのコマンドをキューに入れ、つなぎ目で止まらずに走る
+    // キューがいっぱいなら、空くまで待ってから入れる
+    int ticket = 0;
+    for(int command_i = 0; command_i < MotionCommandNum; command_i++){
+        t_motion_command *command = &MotionCommands[command_i];
+
+        switch(command->type){
+            case MOTION_STRAIGHT:
+                ticket = queueFastStraight(getMotionDistance(command), command->endSpeed);
                 break;
-        }
 
-        mypos->dir = glob_nextdir; // 方向を更新
+            case MOTION_DIAGONAL:
+                ticket = queueDiagonalStraight(getMotionDistance(command), command->endSpeed);
+                break;
 
-        // 向いた方向によって自分の座標を更新する
-        switch(mypos->dir)
-        {
-            case north:
-                mypos->y++; // 北を向いた時はY座標を増やす
+            case MOTION_PIVOT90:
+                ticket = queueTurn(command->isTurnRight ? -M_PI_2 : M_PI_2, pFAST_TIMEOUT);
                 break;
 
-            case east:
-                mypos->x++; // 東を向いた時はX座標を増やす
+            case MOTION_PIVOT180:
+                ticket = queueTurn(M_PI, pFAST_TIMEOUT);
                 break;
 
-            case south:
-                mypos->y--; // 南を向いた時はY座標を減らす
+            case MOTION_END:
                 break;
 
-            case west:
-                mypos->x--; // 西を向いたときはX座標を減らす
+            default:
+                {
+                    int isExit = (command->type == MOTION_SLALOM45_OUT 
+                            || command->type == MOTION_SLALOM135_OUT);
+                    ticket = queueFastTurn(getMotionFastTurn(command->type), command->isTurnRight, 
+                            isExit, command->endSpeed, pFAST_TIMEOUT);
+                }
                 break;
         }
     }
-    fastStraight(pCELL_DISTANCE * straightCount, 0.0);
+    motionWait(ticket);
 
     gMotorState = MOTOR_OFF;
 }
 
 
-void search(const int goalX, const int goalY, const int slalomEnable, 
+void search(const t_goal *goal, const int slalomEnable, 
         const int goHomeEnable){
 
     int doInitKetsuate = TRUE;
@@ -748,9 +1325,9 @@ void search(const int goalX, const int goalY, const int slalomEnable,
     vTaskDelay(3000 / portTICK_PERIOD_MS);
     gIndicatorValue = 9;
 
-    searchAdachi(goalX,goalY,slalomEnable,doInitKetsuate,&myPos);
-    // loggingSaveWall(WallMap,MAZESIZE_X,MAZESIZE_Y);
-    // loggingSaveWall(MAZESIZE_X,MAZESIZE_Y,WallMap);
+    searchAdachi(goal,slalomEnable,doInitKetsuate,&myPos);
+    // ゴールで止まっている間に壁情報を保存する
+    int saveTicket = saveWallAsync();
 
     // ゴールしたらLEDを点灯
     gIndicatorValue = 6;
@@ -759,11 +1336,19 @@ void search(const int goalX, const int goalY, const int slalomEnable,
         vTaskDelay(1 / portTICK_PERIOD_MS);
     }
     gIndicatorValue = 0;
+    loggingWaitWrite(saveTicket, FLASH_WRITE_TIMEOUT_MSEC); // 走り出す前に書き終える
 
     // スタート地点に戻る
+    // 最短経路が確定するまでは、最短経路になりうる区画だけを探索しながら戻る
+    // 確定したら探索をやめて、既知の壁で一番速い経路で帰る
     if(goHomeEnable){
         doInitKetsuate = FALSE;
-        searchAdachi(0,0,slalomEnable,doInitKetsuate,&myPos);
+        searchShortestRoute(goal,slalomEnable,&myPos);
+        // 最短経路が確定して止まったところで壁情報を保存し、書き終えてから帰る
+        saveTicket = saveWallAsync();
+        loggingWaitWrite(saveTicket, FLASH_WRITE_TIMEOUT_MSEC);
+        ESP_LOGI(TAG, "Shortest route is fixed");
+        fastRun(&START_GOAL, slalomEnable, FALSE, doInitKetsuate, &myPos);
     }
 
     // LEDを点灯するからこの間にEspecialを持ち上げてね
@@ -776,8 +1361,8 @@ void search(const int goalX, const int goalY, const int slalomEnable,
 }
 
 
-void run(const int goalX, const int goalY, const int slalomEnable, 
-        const int goHomeEnable){
+void run(const t_goal *goal, const int slalomEnable, 
+        const int diagonalEnable, const int goHomeEnable){
 
     int doInitKetsuate = TRUE;
 
@@ -790,7 +1375,7 @@ void run(const int goalX, const int goalY, const int slalomEnable,
     vTaskDelay(3000 / portTICK_PERIOD_MS);
     gIndicatorValue = 9;
 
-    fastRun(goalX, goalX, slalomEnable, doInitKetsuate, &myPos);
+    fastRun(goal, slalomEnable, diagonalEnable, doInitKetsuate, &myPos);
 
     // ゴールしたらLEDを点灯
     gIndicatorValue = 6;
@@ -803,7 +1388,7 @@ void run(const int goalX, const int goalY, const int slalomEnable,
     // スタート地点に戻る
     if(goHomeEnable){
         doInitKetsuate = FALSE;
-        fastRun(0, 0, slalomEnable, doInitKetsuate, &myPos);
+        fastRun(&START_GOAL, slalomEnable, diagonalEnable, doInitKetsuate, &myPos);
     }
 
     // LEDを点灯するからこの間にEspecialを持ち上げてね
@@ -1,10 +1,14 @@
 #ifndef MAZE_H 
 #define MAZE_H
 
-extern void initMaze(void);
-extern void search(const int goalX, const int goalY, const int slalomEnable, 
-        const int goHomeEnable);
-extern void run(const int goalX, const int goalY, const int slalomEnable, 
+#include "maze_planner.h"
+
+extern void loadMaze(void);
+extern void resetMaze(void);
+extern void startPlanner(void);
+extern void search(const t_goal *goal, const int slalomEnable, 
         const int goHomeEnable);
+extern void run(const t_goal *goal, const int slalomEnable, 
+        const int diagonalEnable, const int goHomeEnable);
 
 #endif
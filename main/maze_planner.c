@@ -0,0 +1,1155 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "maze_planner.h"
+#include "variables.h"
+
+// 探索の計画
+// 壁情報と歩数Mapを持ち、読んだ壁を書き込んで次に向かう方向を決める
+// FreeRTOSやセンサに依存しないので、PC上でもビルドできる
+
+typedef enum
+{
+    PRIORITY_LOWEST = 0,
+    PRIORITY_LOW,
+    PRIORITY_MID,
+    PRIORITY_HIGH,
+    PRIORITY_HIGHEST,
+}ENUM_PRIORITY;
+typedef unsigned int t_priority;
+
+const t_steps INIT_STEPS = STEPS_MAX; // 未到達の区画の歩数
+const t_steps MIN_STEP = 0;
+static t_steps StepMap[MAZESIZE_X][MAZESIZE_Y]; // 歩数マップ
+_Static_assert((MAZESIZE_X * MAZESIZE_Y - 1) < STEPS_MAX, "t_steps cannot hold every step count");
+static t_wall WallMap[MAZESIZE_X][MAZESIZE_Y];
+
+// 壁情報のビットボード表現
+// 方角ごと、Y座標(行)ごとに32bitのマスクを持ち、bit xが座標x,yの壁を表す
+// WallMapと同じ内容を持ち、updateWall()とinitMaze()で同期する
+typedef uint32_t t_wall_row;
+_Static_assert(MAZESIZE_X <= 32, "MAZESIZE_X must fit in t_wall_row");
+#define WALL_ROW_MASK ((t_wall_row)(0xFFFFFFFFUL >> (32 - MAZESIZE_X)))
+static t_wall_row WallKnownRows[4][MAZESIZE_Y]; // 壁の有無がわかっている
+static t_wall_row WallPresentRows[4][MAZESIZE_Y]; // 壁がある(仮想壁を含む)
+
+// 歩数Map作成用のリングキュー
+// 同じ区画が同時に2回入ることはないので、区画数分の大きさがあれば溢れない
+#define STEP_QUEUE_SIZE (MAZESIZE_X * MAZESIZE_Y)
+static t_cell StepQueue[STEP_QUEUE_SIZE];
+static unsigned int StepQueueHead;
+static unsigned int StepQueueCount;
+static unsigned char StepQueued[MAZESIZE_X][MAZESIZE_Y]; // キューに入っている区画はTRUE
+
+static void clearStepQueue(void)
+{
+    StepQueueHead = StepQueueCount = 0;
+}
+
+static void pushStepQueue(int x, int y)
+{
+    unsigned int tail = (StepQueueHead + StepQueueCount) % STEP_QUEUE_SIZE;
+    StepQueue[tail].x = x;
+    StepQueue[tail].y = y;
+    StepQueueCount++;
+    StepQueued[x][y] = TRUE;
+}
+
+static t_cell popStepQueue(void)
+{
+    t_cell cell = StepQueue[StepQueueHead];
+    StepQueueHead = (StepQueueHead + 1) % STEP_QUEUE_SIZE;
+    StepQueueCount--;
+    StepQueued[cell.x][cell.y] = FALSE;
+    return cell;
+}
+
+// スタート区画に戻るときのゴール
+const t_goal START_GOAL = {0, 0, 1, 1};
+
+// 歩数Mapのキャッシュ情報
+// 前回作成した歩数Mapのゴールとマスクを覚えておき、
+// 同じ条件なら壁が変わった区画の周りだけ歩数を修正する
+static int StepMapValid = FALSE;
+static t_goal StepMapGoal;
+static int StepMapMask;
+
+// 前回の歩数Map作成後に書き換わった壁
+// setWall()1回で変わる壁は4枚と、行き止まりを塞いだ仮想壁なので、溢れたら歩数Mapを作り直す
+#define WALL_CHANGE_MAX 16
+typedef struct
+{
+    unsigned char x;
+    unsigned char y;
+    unsigned char dir;
+    unsigned char oldWall; // 書き換え前の壁情報
+}t_wall_change;
+static t_wall_change WallChanges[WALL_CHANGE_MAX];
+static int WallChangeNum;
+
+int isGoal(const t_goal *goal, int x, int y)
+{
+    // 座標x,yがゴール区画に含まれるか調べる
+    return (x >= goal->x && x < goal->x + goal->sizeX 
+            && y >= goal->y && y < goal->y + goal->sizeY);
+}
+
+static int isSameGoal(const t_goal *goal1, const t_goal *goal2)
+{
+    return (goal1->x == goal2->x && goal1->y == goal2->y 
+            && goal1->sizeX == goal2->sizeX && goal1->sizeY == goal2->sizeY);
+}
+
+static t_wall_row getOpenRow(int dir, int y, int mask)
+{
+    // Y座標yの行で、方角dirに壁がない(maskを通して見て通れる)区画のマスクを返す
+    t_wall_row blocked = 0;
+    if(mask & WALL)
+    {
+        blocked |= WallPresentRows[dir][y]; // 壁がある
+    }
+    if(mask & UNKNOWN)
+    {
+        blocked |= ~WallKnownRows[dir][y]; // 未探索
+    }
+    return (~blocked) & WALL_ROW_MASK;
+}
+
+static void getGoalRows(const t_goal *goal, t_wall_row rows[MAZESIZE_Y])
+{
+    // ゴール区画を、行ごとに区画のbitを立てたマスクにする
+    t_wall_row goalRow = ((((t_wall_row)1 << goal->sizeX) - 1) << goal->x) & WALL_ROW_MASK;
+    for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+    {
+        if(y_i >= goal->y && y_i < goal->y + goal->sizeY)
+        {
+            rows[y_i] = goalRow;
+        }
+        else
+        {
+            rows[y_i] = 0;
+        }
+    }
+}
+
+static void floodStepMap(t_steps map[MAZESIZE_X][MAZESIZE_Y], 
+        const t_wall_row seeds[MAZESIZE_Y], int mask)
+{
+    // seedsの区画の歩数をMIN_STEPとして、幅優先探索(BFS)で歩数を広げてmapに書き込む。
+    // 壁のビットボードを使い、1歩分の探索の最前線(frontier)を1行ずつまとめて広げる
+    // 辿り着けない区画はINIT_STEPSのままになる
+
+    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+    {
+        for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+        {
+            if(seeds[y_i] & ((t_wall_row)1 << x_i))
+            {
+                map[x_i][y_i] = MIN_STEP;
+            }
+            else
+            {
+                map[x_i][y_i] = INIT_STEPS;
+            }
+        }
+    }
+
+    t_wall_row openRows[4][MAZESIZE_Y];
+    for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+    {
+        for(int dir = north; dir <= west; dir++)
+        {
+            openRows[dir][y_i] = getOpenRow(dir, y_i, mask);
+        }
+    }
+
+    t_wall_row reached[MAZESIZE_Y]; // 歩数が決まった区画
+    t_wall_row frontier[MAZESIZE_Y]; // 直前に歩数が決まった区画
+    t_wall_row next[MAZESIZE_Y];
+    int minY = MAZESIZE_Y, maxY = -1; // frontierがある行の範囲
+    for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+    {
+        reached[y_i] = frontier[y_i] = seeds[y_i];
+        if(seeds[y_i] == 0)
+        {
+            continue;
+        }
+        if(y_i < minY)
+        {
+            minY = y_i;
+        }
+        maxY = y_i;
+    }
+
+    t_steps steps = MIN_STEP;
+    while(minY <= maxY) // frontierがなくなるまで繰り返す
+    {
+        steps++;
+        // 1つ外側の行まで広がる可能性がある
+        int fromY = (minY > 0) ? minY - 1 : 0;
+        int toY = (maxY < MAZESIZE_Y-1) ? maxY + 1 : MAZESIZE_Y-1;
+        for(int y_i = fromY; y_i <= toY; y_i++)
+        {
+            // 東西方向はシフトで、南北方向は隣の行から広げる
+            t_wall_row row = ((frontier[y_i] & openRows[east][y_i]) << 1)
+                | ((frontier[y_i] & openRows[west][y_i]) >> 1);
+            if(y_i > 0)
+            {
+                row |= frontier[y_i-1] & openRows[north][y_i-1];
+            }
+            if(y_i < MAZESIZE_Y-1)
+            {
+                row |= frontier[y_i+1] & openRows[south][y_i+1];
+            }
+            next[y_i] = row & ~reached[y_i] & WALL_ROW_MASK;
+        }
+
+        minY = MAZESIZE_Y;
+        maxY = -1;
+        for(int y_i = fromY; y_i <= toY; y_i++)
+        {
+            frontier[y_i] = next[y_i];
+            if(next[y_i] == 0)
+            {
+                continue;
+            }
+            reached[y_i] |= next[y_i];
+            if(y_i < minY)
+            {
+                minY = y_i;
+            }
+            maxY = y_i;
+
+            // 新しく辿り着いた区画に歩数を書き込む
+            t_wall_row bits = next[y_i];
+            while(bits)
+            {
+                int x_i = __builtin_ctz(bits);
+                map[x_i][y_i] = steps;
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+void makeStepMap(const t_goal *goal, int mask) //歩数マップを作成する
+{
+    // ゴール区画の全ての区画から同時に広げた歩数Mapを作成する。
+    // maskの値(MASK_SEARCH or MASK_SECOND)によって、
+    // 探索用の歩数Mapを作るか、最短走行の歩数Mapを作るかが切り替わる
+    // 作成した歩数Mapは、updateStepMap()で壁が変わった分だけ修正して使い回す
+
+    t_wall_row goalRows[MAZESIZE_Y];
+    getGoalRows(goal, goalRows);
+    floodStepMap(StepMap, goalRows, mask);
+
+    // 歩数Mapのキャッシュ情報を更新
+    StepMapValid = TRUE;
+    StepMapGoal = *goal;
+    StepMapMask = mask;
+    WallChangeNum = 0;
+}
+
+int getWall(int x, int y, t_direction dir)
+{
+    // 座標x,yの方角dirの壁情報を返す
+    switch(dir)
+    {
+        case north:
+            return WallMap[x][y].north;
+        case east:
+            return WallMap[x][y].east;
+        case south:
+            return WallMap[x][y].south;
+        default:
+            return WallMap[x][y].west;
+    }
+}
+
+static void updateWallRows(int x, int y, t_direction dir, int wall)
+{
+    // ビットボードの座標x,yの方角dirの壁情報を書き換える
+    if((unsigned int)dir > west)
+    {
+        return; // 配列の範囲外アクセス防止
+    }
+    t_wall_row bit = (t_wall_row)1 << x;
+
+    if(wall == UNKNOWN)
+    {
+        WallKnownRows[dir][y] &= ~bit;
+    }
+    else
+    {
+        WallKnownRows[dir][y] |= bit;
+    }
+
+    if(wall & WALL)
+    {
+        WallPresentRows[dir][y] |= bit;
+    }
+    else
+    {
+        WallPresentRows[dir][y] &= ~bit;
+    }
+}
+
+int getNeighbor(int x, int y, t_direction dir, int *nextX, int *nextY)
+{
+    // 座標x,yから方角dirに1区画進んだ座標を求める
+    // 迷路の外に出る場合はFALSEを返す
+    *nextX = x;
+    *nextY = y;
+    switch(dir)
+    {
+        case north:
+            (*nextY)++;
+            break;
+        case east:
+            (*nextX)++;
+            break;
+        case south:
+            (*nextY)--;
+            break;
+        case west:
+            (*nextX)--;
+            break;
+    }
+
+    if(*nextX < 0 || *nextX >= MAZESIZE_X || *nextY < 0 || *nextY >= MAZESIZE_Y)
+    {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void updateWall(int x, int y, t_direction dir, int wall)
+{
+    // 座標x,yの方角dirの壁情報を書き換える
+    // 隣の区画の壁情報も合わせて書き換え、変化があれば歩数Map修正用に記録する
+
+    int oldWall = getWall(x, y, dir);
+
+    switch(dir)
+    {
+        case north:
+            WallMap[x][y].north = wall;
+            break;
+        case east:
+            WallMap[x][y].east = wall;
+            break;
+        case south:
+            WallMap[x][y].south = wall;
+            break;
+        case west:
+            WallMap[x][y].west = wall;
+            break;
+    }
+    updateWallRows(x, y, dir, wall);
+
+    // 周りの区画の壁情報も更新する
+    int nextX, nextY;
+    if(getNeighbor(x, y, dir, &nextX, &nextY) == FALSE) // 配列の範囲外アクセス防止
+    {
+        return;
+    }
+    switch(dir)
+    {
+        case north:
+            WallMap[nextX][nextY].south = wall;
+            break;
+        case east:
+            WallMap[nextX][nextY].west = wall;
+            break;
+        case south:
+            WallMap[nextX][nextY].north = wall;
+            break;
+        case west:
+            WallMap[nextX][nextY].east = wall;
+            break;
+    }
+    updateWallRows(nextX, nextY, (t_direction)((dir + 2) % 4), wall);
+
+    if(oldWall == wall)
+    {
+        return; // 変化なし
+    }
+    if(WallChangeNum < WALL_CHANGE_MAX)
+    {
+        WallChanges[WallChangeNum].x = x;
+        WallChanges[WallChangeNum].y = y;
+        WallChanges[WallChangeNum].dir = dir;
+        WallChanges[WallChangeNum].oldWall = oldWall;
+    }
+    WallChangeNum++;
+}
+
+static void collectStepMapDescendants(int x, int y, int mask)
+{
+    // 歩数Map上で座標x,yを経由している(歩数が1つずつ増えていく)区画を集める
+    // 集めた区画はキューに入り、StepQueuedがTRUEになる
+
+    if(StepQueued[x][y] == TRUE)
+    {
+        return;
+    }
+    unsigned int head = (StepQueueHead + StepQueueCount) % STEP_QUEUE_SIZE;
+    pushStepQueue(x, y);
+
+    while(head != (StepQueueHead + StepQueueCount) % STEP_QUEUE_SIZE)
+    {
+        t_cell cell = StepQueue[head];
+        head = (head + 1) % STEP_QUEUE_SIZE;
+
+        for(int dir = north; dir <= west; dir++)
+        {
+            int nextX, nextY;
+            if( (getWall(cell.x, cell.y, dir) & mask) != NOWALL 
+                    || getNeighbor(cell.x, cell.y, dir, &nextX, &nextY) == FALSE)
+            {
+                continue;
+            }
+            if(StepQueued[nextX][nextY] == FALSE 
+                    && StepMap[nextX][nextY] != INIT_STEPS
+                    && StepMap[nextX][nextY] == StepMap[cell.x][cell.y] + 1)
+            {
+                pushStepQueue(nextX, nextY);
+            }
+        }
+    }
+}
+
+void updateStepMap(const t_goal *goal, int mask)
+{
+    // ゴール区画までの歩数Mapを用意する。
+    //
+    // 前回と同じゴール、マスクであれば、前回作成後に書き換わった壁の周りだけを修正する(LPA*風)
+    //   1. 壁で塞がれた通路の先にある区画(歩数が増えるかもしれない区画)を集めてINIT_STEPSに戻す
+    //   2. 戻した区画を周りの区画の歩数から埋め直し、開いた通路の両側と合わせてキューに入れる
+    //   3. 歩数が小さくなった区画から周りへ伝搬させる
+    // 修正にかかる時間は、歩数が変わる区画の数にだけ依存する
+
+    if(StepMapValid == FALSE || isSameGoal(&StepMapGoal, goal) == FALSE
+            || StepMapMask != mask || WallChangeNum > WALL_CHANGE_MAX)
+    {
+        makeStepMap(goal, mask); // 作り直し
+        return;
+    }
+    if(WallChangeNum == 0)
+    {
+        return; // 壁が変わっていないのでそのまま使える
+    }
+
+    clearStepQueue();
+
+    // 1. 塞がれた通路の先の区画を集める
+    for(int change_i = 0; change_i < WallChangeNum; change_i++)
+    {
+        t_wall_change *change = &WallChanges[change_i];
+        int nextX, nextY;
+        getNeighbor(change->x, change->y, change->dir, &nextX, &nextY);
+
+        int wasOpen = (change->oldWall & mask) == NOWALL;
+        int isOpen = (getWall(change->x, change->y, change->dir) & mask) == NOWALL;
+        if(wasOpen == FALSE || isOpen == TRUE)
+        {
+            continue;
+        }
+
+        t_steps steps = StepMap[change->x][change->y];
+        t_steps nextSteps = StepMap[nextX][nextY];
+        if(steps != INIT_STEPS && nextSteps == steps + 1)
+        {
+            collectStepMapDescendants(nextX, nextY, mask);
+        }
+        else if(nextSteps != INIT_STEPS && steps == nextSteps + 1)
+        {
+            collectStepMapDescendants(change->x, change->y, mask);
+        }
+    }
+
+    // 集めた区画の歩数をリセットし、周りの区画から埋め直す
+    for(unsigned int queue_i = 0; queue_i < StepQueueCount; queue_i++)
+    {
+        t_cell cell = StepQueue[(StepQueueHead + queue_i) % STEP_QUEUE_SIZE];
+        StepMap[cell.x][cell.y] = INIT_STEPS;
+    }
+    for(unsigned int queue_i = 0; queue_i < StepQueueCount; queue_i++)
+    {
+        t_cell cell = StepQueue[(StepQueueHead + queue_i) % STEP_QUEUE_SIZE];
+        for(int dir = north; dir <= west; dir++)
+        {
+            int nextX, nextY;
+            if( (getWall(cell.x, cell.y, dir) & mask) != NOWALL 
+                    || getNeighbor(cell.x, cell.y, dir, &nextX, &nextY) == FALSE)
+            {
+                continue;
+            }
+            t_steps nextSteps = StepMap[nextX][nextY];
+            if(nextSteps != INIT_STEPS && nextSteps + 1 < StepMap[cell.x][cell.y])
+            {
+                StepMap[cell.x][cell.y] = nextSteps + 1;
+            }
+        }
+    }
+
+    // 2. 開いた通路の両側をキューに入れる
+    for(int change_i = 0; change_i < WallChangeNum; change_i++)
+    {
+        t_wall_change *change = &WallChanges[change_i];
+        int nextX, nextY;
+        getNeighbor(change->x, change->y, change->dir, &nextX, &nextY);
+
+        int wasOpen = (change->oldWall & mask) == NOWALL;
+        int isOpen = (getWall(change->x, change->y, change->dir) & mask) == NOWALL;
+        if(wasOpen == TRUE || isOpen == FALSE)
+        {
+            continue;
+        }
+        if(StepQueued[change->x][change->y] == FALSE)
+        {
+            pushStepQueue(change->x, change->y);
+        }
+        if(StepQueued[nextX][nextY] == FALSE)
+        {
+            pushStepQueue(nextX, nextY);
+        }
+    }
+
+    // 3. 歩数が小さくなった区画から周りへ伝搬させる
+    while(StepQueueCount > 0)
+    {
+        t_cell cell = popStepQueue();
+        t_steps steps = StepMap[cell.x][cell.y];
+        if(steps == INIT_STEPS)
+        {
+            continue; // まだ辿り着けない区画
+        }
+
+        for(int dir = north; dir <= west; dir++)
+        {
+            int nextX, nextY;
+            if( (getWall(cell.x, cell.y, dir) & mask) != NOWALL 
+                    || getNeighbor(cell.x, cell.y, dir, &nextX, &nextY) == FALSE)
+            {
+                continue;
+            }
+            if(steps + 1 < StepMap[nextX][nextY])
+            {
+                StepMap[nextX][nextY] = steps + 1;
+                if(StepQueued[nextX][nextY] == FALSE)
+                {
+                    pushStepQueue(nextX, nextY);
+                }
+            }
+        }
+    }
+
+    WallChangeNum = 0;
+}
+
+int isUnknown(int x, int y)
+{
+    // 座標x,yが未探索区間か否かを調べる
+
+    if((WallMap[x][y].north == UNKNOWN) 
+            || (WallMap[x][y].east == UNKNOWN) 
+            || (WallMap[x][y].south == UNKNOWN) 
+            || (WallMap[x][y].west == UNKNOWN))
+    {
+        return TRUE; // 未探索
+    }
+    else
+    {
+        return FALSE; // 探索済
+    }
+}
+
+// 最短経路が確定したかを調べるための歩数Map
+// 未探索の壁をないものとした歩数(下限)と、あるものとした歩数(上限)を比べる
+static t_steps StartStepMap[MAZESIZE_X][MAZESIZE_Y]; // スタートからの歩数
+static t_steps GoalStepMap[MAZESIZE_X][MAZESIZE_Y]; // ゴールからの歩数
+
+static void makeBoundStepMaps(const t_goal *goal, t_steps *lower, t_steps *upper)
+{
+    // スタートからゴールまでの歩数の下限lowerと上限upperを求める
+    // StartStepMap, GoalStepMapには、未探索の壁をないものとした歩数が残る
+    t_wall_row startRows[MAZESIZE_Y];
+    t_wall_row goalRows[MAZESIZE_Y];
+    getGoalRows(&START_GOAL, startRows);
+    getGoalRows(goal, goalRows);
+
+    floodStepMap(GoalStepMap, goalRows, MASK_SECOND); // 既知の壁だけで通れる経路
+    *upper = GoalStepMap[START_GOAL.x][START_GOAL.y];
+
+    floodStepMap(GoalStepMap, goalRows, MASK_SEARCH);
+    floodStepMap(StartStepMap, startRows, MASK_SEARCH);
+    *lower = GoalStepMap[START_GOAL.x][START_GOAL.y];
+}
+
+static int getCandidateRows(const t_goal *goal, t_wall_row rows[MAZESIZE_Y])
+{
+    // 最短経路になりうる未探索の区画を、行ごとのマスクにしてその区画数を返す
+    // 未探索の壁をないものとしたときの最短経路(下限)上の区画だけを選ぶ
+    // 下限はこれらの区画の壁がわからない限り上がらないので、それ以外は後回しでよい
+    // 0なら既知の壁だけで最短経路が確定している
+    t_steps lower, upper;
+    makeBoundStepMaps(goal, &lower, &upper);
+
+    int candidateNum = 0;
+    for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+    {
+        rows[y_i] = 0;
+        if(lower == upper)
+        {
+            continue; // 上限と下限が一致したら、もう短い経路は見つからない
+        }
+        for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+        {
+            if(StartStepMap[x_i][y_i] == INIT_STEPS || GoalStepMap[x_i][y_i] == INIT_STEPS)
+            {
+                continue;
+            }
+            if(isUnknown(x_i, y_i) == TRUE 
+                    && (int)StartStepMap[x_i][y_i] + GoalStepMap[x_i][y_i] == (int)lower)
+            {
+                rows[y_i] |= (t_wall_row)1 << x_i;
+                candidateNum++;
+            }
+        }
+    }
+    return candidateNum;
+}
+
+t_priority getPriority(int x, int y, t_direction dir, const t_position *mypos)
+{
+    // 座標x,yと、向いている方角dirから優先度を算出する
+
+    // 未探索が一番優先度が高い.
+    // それに加え、自分の向きと、行きたい方向から、
+    // 前-> 横-> 後の順で優先度を付加する。
+
+    t_priority priority = PRIORITY_LOWEST;
+
+    if(mypos->dir == dir) // 行きたい方向が現在の進行方向と同じ場合
+    {
+        priority = PRIORITY_MID;
+    }
+    else if( ((4+mypos->dir-dir)%4) == 2) // 行きたい方向が現在の進行方向と逆の場合
+    {
+        priority = PRIORITY_LOWEST;
+    }
+    else // それ以外(左右どちらか)の場合
+    {
+        priority = PRIORITY_LOW;
+    }
+
+
+    if(isUnknown(x,y) == TRUE)
+    {
+        priority += PRIORITY_HIGHEST; // 未探索の場合優先度をさらに付加
+    }
+
+    return priority; // 優先度を返す
+}
+
+static t_local_dir selectNextDirection(const int mask, t_direction *dir,
+        const t_position *mypos)
+{
+    // 今の歩数Mapで、今どちらに行くべきかを判断する。
+    // 探索、最短の切り替えのためのmaskを指定、dirは方角を示す
+    
+    // stepsが少ない移動方向を探す
+    t_steps lowestSteps = INIT_STEPS;
+    t_priority priority = PRIORITY_LOWEST;
+
+    t_priority tmp_priority;
+
+    // TODO:ここは同じことを４回書いてるので、もっとシンプルにできる
+
+    if( (WallMap[mypos->x][mypos->y].north & mask) == NOWALL) // 北に壁がなければ
+    {
+        // 1区画先の歩数と優先度を取得
+        int nextX = mypos->x;
+        int nextY = mypos->y+1;
+        t_steps nextSteps = StepMap[nextX][nextY];
+        tmp_priority = getPriority(nextX, nextY, north, mypos);
+
+        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+        {
+            lowestSteps = nextSteps; // ひとまず北が歩数が小さい事にする
+            *dir = north; // 方向を保存
+            priority = tmp_priority; // 優先度を保存
+        }
+        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+        {
+            if(priority < tmp_priority ) // 優先度を評価
+            {
+                *dir = north; // 方向を更新
+                priority = tmp_priority; // 優先度を保存
+            }
+        }
+    }
+
+    if( (WallMap[mypos->x][mypos->y].east & mask) == NOWALL) // 東に壁がなければ
+    {
+        // 1区画先の歩数と優先度を取得
+        int nextX = mypos->x+1;
+        int nextY = mypos->y;
+        t_steps nextSteps = StepMap[nextX][nextY];
+        tmp_priority = getPriority(nextX, nextY, east, mypos);
+
+        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+        {
+            lowestSteps = nextSteps; // ひとまず東が歩数が小さい事にする
+            *dir = east; // 方向を保存
+            priority = tmp_priority; // 優先度を保存
+        }
+        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+        {
+            if(priority < tmp_priority) // 優先度を評価
+            {
+                *dir = east; // 方向を保存
+                priority = tmp_priority; // 優先度を保存
+            }
+        }
+    }
+
+    if( (WallMap[mypos->x][mypos->y].south & mask) == NOWALL) // 南に壁がなければ
+    {
+        // 1区画先の歩数と優先度を取得
+        int nextX = mypos->x;
+        int nextY = mypos->y-1;
+        t_steps nextSteps = StepMap[nextX][nextY];
+        tmp_priority = getPriority(nextX, nextY, south, mypos);
+
+        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+        {
+            lowestSteps = nextSteps; // ひとまず南が歩数が小さい事にする
+            *dir = south; // 方向を保存
+            priority = tmp_priority; // 優先度を保存
+        }
+        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+        {
+            if(priority < tmp_priority) // 優先度を評価
+            {
+                *dir = south; // 方向を保存
+                priority = tmp_priority; // 優先度を保存
+            }
+        }
+    }
+
+    if( (WallMap[mypos->x][mypos->y].west & mask) == NOWALL) // 西に壁がなければ
+    {
+        // 1区画先の歩数と優先度を取得
+        int nextX = mypos->x-1;
+        int nextY = mypos->y;
+        t_steps nextSteps = StepMap[nextX][nextY];
+        tmp_priority = getPriority(nextX, nextY, west, mypos);
+
+        if(nextSteps < lowestSteps) // 一番歩数が小さい方向を見つける
+        {
+            lowestSteps = nextSteps; // ひとまず西が歩数が小さい事にする
+            *dir = west; // 方向を保存
+            priority = tmp_priority; // 優先度を保存
+        }
+        else if(nextSteps == lowestSteps) // 歩数が同じ場合は優先度から判断する
+        {
+            *dir = west; // 方向を保存
+            priority = tmp_priority; // 優先度を保存
+        }
+    }
+
+    // TODO:ここはわかりにくい
+    return ( (int)( ( 4 + *dir - mypos->dir) % 4 ) ); // どっちに向かうべきかを返す。
+}
+
+t_local_dir getNextDirection(const t_goal *goal, const int mask, t_direction *dir,
+        const t_position *mypos)
+{
+    // ゴール座標に向かう場合、今どちらに行くべきかを判断する。
+    // 探索、最短の切り替えのためのmaskを指定、dirは方角を示す
+    updateStepMap(goal, mask); // 歩数Map生成(壁が変わった分だけ修正)
+    return selectNextDirection(mask, dir, mypos);
+}
+
+t_local_dir getNextCandidateDirection(const t_goal *goal, t_direction *dir,
+        const t_position *mypos)
+{
+    // 最短経路になりうる未探索の区画のうち、一番近い区画に向かう場合、
+    // 今どちらに行くべきかを判断する。
+    // 壁を読むたびに候補を選び直すので、途中で関係なくなった区画には寄らない
+    // 最短経路が確定していればLOCAL_UNKNOWNを返す
+    t_wall_row candidateRows[MAZESIZE_Y];
+    if(getCandidateRows(goal, candidateRows) == 0)
+    {
+        return LOCAL_UNKNOWN;
+    }
+
+    // 全ての候補区画から同時に広げた歩数Mapなら、一番近い候補区画に向かう
+    floodStepMap(StepMap, candidateRows, MASK_SEARCH);
+    StepMapValid = FALSE; // ゴールまでの歩数Mapではなくなったので、次は作り直す
+    if(StepMap[mypos->x][mypos->y] == INIT_STEPS)
+    {
+        return LOCAL_UNKNOWN;
+    }
+    return selectNextDirection(MASK_SEARCH, dir, mypos);
+}
+
+static int isPrunable(const t_goal *goal, const t_position *mypos, int x, int y)
+{
+    // 座標x,yを仮想壁で塞いでよいか調べる
+    // スタート、ゴール、今いる区画は行き止まりでも塞がない
+    if(isGoal(goal, x, y) || isGoal(&START_GOAL, x, y))
+    {
+        return FALSE;
+    }
+    if(x == mypos->x && y == mypos->y)
+    {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void pruneDeadEnds(const t_goal *goal, const t_position *mypos)
+{
+    // 今いる区画とその周りから、行き止まりの区画の入口を仮想壁(VWALL)で塞ぐ
+    // 塞いだ先の区画が新しく行き止まりになれば、続けて塞いでいく
+    // 未探索の壁は通れるものとして数えるので、最短経路が通りうる区画は塞がない
+    // 行き止まりを辿るのにStepQueueを借りる
+    clearStepQueue();
+    pushStepQueue(mypos->x, mypos->y);
+    for(int dir = north; dir <= west; dir++)
+    {
+        int nextX, nextY;
+        if(getNeighbor(mypos->x, mypos->y, dir, &nextX, &nextY) == TRUE)
+        {
+            pushStepQueue(nextX, nextY);
+        }
+    }
+
+    while(StepQueueCount > 0)
+    {
+        t_cell cell = popStepQueue();
+        if(isPrunable(goal, mypos, cell.x, cell.y) == FALSE)
+        {
+            continue;
+        }
+
+        // 通れる方向が1つだけなら行き止まり
+        int openNum = 0;
+        t_direction openDir = north;
+        for(int dir = north; dir <= west; dir++)
+        {
+            if( (getWall(cell.x, cell.y, dir) & MASK_SEARCH) == NOWALL)
+            {
+                openNum++;
+                openDir = dir;
+            }
+        }
+        if(openNum != 1)
+        {
+            continue;
+        }
+
+        updateWall(cell.x, cell.y, openDir, VWALL);
+        int nextX, nextY;
+        if(getNeighbor(cell.x, cell.y, openDir, &nextX, &nextY) == TRUE)
+        {
+            pushStepQueue(nextX, nextY);
+        }
+    }
+}
+
+static void pruneEnclosedCells(const t_position *mypos, int x, int y)
+{
+    // スタートから辿り着けない未探索の区画は、壁に囲まれていて最短経路には関係ない
+    // その区画の未探索の壁を仮想壁にして、探索済みとして扱う
+    //
+    // 新しく見つけた壁で囲まれうるのは、壁の向こう側の区画x,yから辿れる範囲だけなので、
+    // そこから辿って、今いる区画かスタートに着いたら囲まれていないとしてやめる
+    // 今いる区画はスタートから辿り着けるので、迷路全体を辿らなくてよい
+    // 辿るのにStepQueueを借りる。辿った区画はキューに残し、StepQueuedで覚える
+    clearStepQueue();
+    pushStepQueue(x, y);
+
+    int isEnclosed = TRUE;
+    unsigned int queue_i = 0;
+    while(queue_i < StepQueueCount)
+    {
+        t_cell cell = StepQueue[(StepQueueHead + queue_i) % STEP_QUEUE_SIZE];
+        queue_i++;
+        if((cell.x == mypos->x && cell.y == mypos->y) || isGoal(&START_GOAL, cell.x, cell.y))
+        {
+            isEnclosed = FALSE;
+            break;
+        }
+        for(int dir = north; dir <= west; dir++)
+        {
+            int nextX, nextY;
+            if( (getWall(cell.x, cell.y, dir) & MASK_SEARCH) != NOWALL 
+                    || getNeighbor(cell.x, cell.y, dir, &nextX, &nextY) == FALSE)
+            {
+                continue;
+            }
+            if(StepQueued[nextX][nextY] == FALSE)
+            {
+                pushStepQueue(nextX, nextY);
+            }
+        }
+    }
+
+    // 辿った区画をキューから出し、囲まれていれば未探索の壁を仮想壁にする
+    while(StepQueueCount > 0)
+    {
+        t_cell cell = popStepQueue();
+        if(isEnclosed == FALSE || isUnknown(cell.x, cell.y) == FALSE)
+        {
+            continue;
+        }
+        for(int dir = north; dir <= west; dir++)
+        {
+            if(getWall(cell.x, cell.y, dir) == UNKNOWN)
+            {
+                updateWall(cell.x, cell.y, dir, VWALL);
+            }
+        }
+    }
+}
+
+static int writeWallSide(int x, int y, t_direction dir, int wall)
+{
+    // センサで読んだ壁を1枚書き込む
+    // 仮想壁は、壁がないと読んでもそのまま残す
+    // 未探索だったところに壁を見つけたらTRUEを返す
+    int oldWall = getWall(x, y, dir);
+    if(oldWall == VWALL && wall == NOWALL)
+    {
+        return FALSE;
+    }
+    updateWall(x, y, dir, wall);
+    return (oldWall == UNKNOWN && wall == WALL);
+}
+
+void setWall(const t_goal *goal, const t_position *mypos, 
+        const int isWall[DIREC_NUM])
+{
+    // 自分のいる座標に、センサで読んだ壁情報を書き込む
+    // isWallはDIREC_FRONT, DIREC_LEFT, DIREC_RIGHTの向きに壁があればTRUE
+    // 書き込んだあと、行き止まりと囲まれた区画を仮想壁で塞ぐ
+    
+    int n_write=NOWALL,s_write=NOWALL,e_write=NOWALL,w_write=NOWALL;
+
+    int x = mypos->x;
+    int y = mypos->y;
+
+    // 自分の方向に応じて書き込むデータを生成
+    switch(mypos->dir){
+        case north:
+            n_write = CONV_SEN2WALL(isWall[DIREC_FRONT]); // 前壁の有無を判断
+            e_write = CONV_SEN2WALL(isWall[DIREC_RIGHT]); // 右壁の有無を判断
+            w_write = CONV_SEN2WALL(isWall[DIREC_LEFT]); // 左壁の有無を判断
+            s_write = NOWALL; // 後ろは必ず壁がない
+            break;
+
+        case east:
+            e_write = CONV_SEN2WALL(isWall[DIREC_FRONT]); // 前壁の有無を判断
+            s_write = CONV_SEN2WALL(isWall[DIREC_RIGHT]); // 右壁の有無を判断
+            n_write = CONV_SEN2WALL(isWall[DIREC_LEFT]); // 左壁の有無を判断
+            w_write = NOWALL; // 後ろは必ず壁がない
+            break;
+
+        case south:
+            s_write = CONV_SEN2WALL(isWall[DIREC_FRONT]); // 前壁の有無を判断
+            w_write = CONV_SEN2WALL(isWall[DIREC_RIGHT]); // 右壁の有無を判断
+            e_write = CONV_SEN2WALL(isWall[DIREC_LEFT]); // 左壁の有無を判断
+            n_write = NOWALL; // 後ろは必ず壁がない
+            break;
+
+        case west:
+            w_write = CONV_SEN2WALL(isWall[DIREC_FRONT]); // 前壁の有無を判断
+            n_write = CONV_SEN2WALL(isWall[DIREC_RIGHT]); // 右壁の有無を判断
+            s_write = CONV_SEN2WALL(isWall[DIREC_LEFT]); // 左壁の有無を判断
+            e_write = NOWALL; // 後ろは必ず壁がない
+            break;
+    }
+    // 周りの区画の壁情報も合わせて更新する
+    int isClosed[4]; // 方角ごとに、新しく見つけた壁か
+    isClosed[north] = writeWallSide(x, y, north, n_write);
+    isClosed[east] = writeWallSide(x, y, east, e_write);
+    isClosed[south] = writeWallSide(x, y, south, s_write);
+    isClosed[west] = writeWallSide(x, y, west, w_write);
+
+    pruneDeadEnds(goal, mypos);
+    for(int dir = north; dir <= west; dir++)
+    {
+        // 壁が増えたときだけ、その向こう側に囲まれた区画ができうる
+        int nextX, nextY;
+        if(isClosed[dir] && getNeighbor(x, y, dir, &nextX, &nextY) == TRUE)
+        {
+            pruneEnclosedCells(mypos, nextX, nextY);
+        }
+    }
+}
+
+static void syncWallRows(void)
+{
+    // ビットボードをWallMapに合わせる
+    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+    {
+        for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+        {
+            updateWallRows(x_i, y_i, north, WallMap[x_i][y_i].north);
+            updateWallRows(x_i, y_i, east, WallMap[x_i][y_i].east);
+            updateWallRows(x_i, y_i, south, WallMap[x_i][y_i].south);
+            updateWallRows(x_i, y_i, west, WallMap[x_i][y_i].west);
+        }
+    }
+
+    // 壁情報を全部書き換えたので、歩数Mapは作り直す
+    StepMapValid = FALSE;
+    WallChangeNum = 0;
+}
+
+void initMaze(void)
+{
+    // 迷路情報の初期化
+    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+    {
+        for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+        {
+            WallMap[x_i][y_i].north = 
+                WallMap[x_i][y_i].east = 
+                WallMap[x_i][y_i].south = 
+                WallMap[x_i][y_i].west = UNKNOWN; // 迷路の全体がわからない事を設定する
+        }
+    }
+
+    // 一番外側の壁を追加する
+    // 上下
+    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+    {
+        WallMap[x_i][0].south = WALL; // 四方の壁を追加する(南)
+        WallMap[x_i][MAZESIZE_Y-1].north = WALL; // 四方の壁を追加する(北)
+    }
+
+    // 左右
+    for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+    {
+        WallMap[0][y_i].west = WALL; // 四方の壁を追加する(西)
+        WallMap[MAZESIZE_X-1][y_i].east = WALL; // 四方の壁を追加する(東)
+    }
+
+    // スタート地点の右の壁を追加
+    WallMap[0][0].east = WallMap[1][0].west = WALL; // スタート地点の右の壁を追加する
+
+    syncWallRows();
+}
+
+
+void setWallMap(t_wall wallMap[MAZESIZE_X][MAZESIZE_Y])
+{
+    // 壁情報をwallMapの内容で全て置き換える
+    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+    {
+        for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+        {
+            WallMap[x_i][y_i] = wallMap[x_i][y_i];
+        }
+    }
+    syncWallRows();
+}
+
+void getWallMap(t_wall wallMap[MAZESIZE_X][MAZESIZE_Y])
+{
+    // 今の壁情報をwallMapにコピーする
+    for(int x_i = 0; x_i < MAZESIZE_X; x_i++)
+    {
+        for(int y_i = 0; y_i < MAZESIZE_Y; y_i++)
+        {
+            wallMap[x_i][y_i] = WallMap[x_i][y_i];
+        }
+    }
+}
+
+// 先読みの計画のために控えておく迷路の状態
+// 壁情報、ビットボード、歩数Mapと、歩数Mapを直すための情報をまとめて戻す
+typedef struct
+{
+    t_wall wallMap[MAZESIZE_X][MAZESIZE_Y];
+    t_wall_row wallKnownRows[4][MAZESIZE_Y];
+    t_wall_row wallPresentRows[4][MAZESIZE_Y];
+    t_steps stepMap[MAZESIZE_X][MAZESIZE_Y];
+    int stepMapValid;
+    t_goal stepMapGoal;
+    int stepMapMask;
+    t_wall_change wallChanges[WALL_CHANGE_MAX];
+    int wallChangeNum;
+}t_maze_state;
+static t_maze_state SavedState;
+
+void saveMazeState(void)
+{
+    // 今の迷路の状態を控えておく
+    // 仮の壁を書き込んで計画したあと、restoreMazeState()で元に戻す
+    memcpy(SavedState.wallMap, WallMap, sizeof(WallMap));
+    memcpy(SavedState.wallKnownRows, WallKnownRows, sizeof(WallKnownRows));
+    memcpy(SavedState.wallPresentRows, WallPresentRows, sizeof(WallPresentRows));
+    memcpy(SavedState.stepMap, StepMap, sizeof(StepMap));
+    SavedState.stepMapValid = StepMapValid;
+    SavedState.stepMapGoal = StepMapGoal;
+    SavedState.stepMapMask = StepMapMask;
+    memcpy(SavedState.wallChanges, WallChanges, sizeof(WallChanges));
+    SavedState.wallChangeNum = WallChangeNum;
+}
+
+void restoreMazeState(void)
+{
+    // saveMazeState()で控えた状態に戻す
+    memcpy(WallMap, SavedState.wallMap, sizeof(WallMap));
+    memcpy(WallKnownRows, SavedState.wallKnownRows, sizeof(WallKnownRows));
+    memcpy(WallPresentRows, SavedState.wallPresentRows, sizeof(WallPresentRows));
+    memcpy(StepMap, SavedState.stepMap, sizeof(StepMap));
+    StepMapValid = SavedState.stepMapValid;
+    StepMapGoal = SavedState.stepMapGoal;
+    StepMapMask = SavedState.stepMapMask;
+    memcpy(WallChanges, SavedState.wallChanges, sizeof(WallChanges));
+    WallChangeNum = SavedState.wallChangeNum;
+}
+
+t_steps getSteps(int x, int y)
+{
+    // 最後に作った歩数Mapの、座標x,yの歩数を返す
+    return StepMap[x][y];
+}
+
+int countKnownStraightCells(const t_position *mypos)
+{
+    // 今いる区画から前に進むとき、何区画先までまとめて直進できるか数える
+    // 壁が全てわかっている区画では壁を読んでも迷路は変わらないので、
+    // 今の歩数Mapで前に進むと判断する限りは止まらずに走ってよい
+    t_position pos = *mypos;
+    int cells = 1;
+    while(1)
+    {
+        int nextX, nextY;
+        if(getNeighbor(pos.x, pos.y, pos.dir, &nextX, &nextY) == FALSE)
+        {
+            break;
+        }
+        pos.x = nextX;
+        pos.y = nextY;
+        if(StepMap[nextX][nextY] == MIN_STEP || isUnknown(nextX, nextY) == TRUE)
+        {
+            break; // 壁を読む区画の手前で探索速度に戻す
+        }
+
+        t_direction nextDir;
+        if(selectNextDirection(MASK_SEARCH, &nextDir, &pos) != LOCAL_FRONT)
+        {
+            break;
+        }
+        cells++;
+    }
+    return cells;
+}
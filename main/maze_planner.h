@@ -0,0 +1,86 @@
+#ifndef MAZE_PLANNER_H
+#define MAZE_PLANNER_H
+
+#include "variables.h"
+
+/*
+ * Wall Status Bits: [00] -> [isKnown isWall]
+ * Wall Mask: Search[01] -> 壁情報のみを抽出、 Second(2走目)[11] -> 知ってる かつ 壁があるところ抽出
+ *
+ */
+
+#define MASK_SEARCH 0x01 // 探索走行用マスク値.壁情報とこの値のAND値が０（NOWALL）なら壁なしor未探索区間
+#define MASK_SECOND 0x03 // 最短走行用マスク値.壁情報とこの値のAND値が０（NOWALL）なら壁なし
+#define UNKNOWN 2 // 壁があるかないか判らない状態の場合の値
+#define NOWALL  0 // 壁がないばあいの値
+#define WALL    1 // 壁がある場合の値
+#define VWALL   3 // 仮想壁の値(行き止まりを塞ぐ)
+#define CONV_SEN2WALL(w) ((w) ? WALL : NOWALL)
+
+typedef enum
+{
+    north=0,
+    east=1,
+    south=2,
+    west=3,
+}t_direction;
+
+typedef struct
+{
+    short x;
+    short y;
+    t_direction dir;
+}t_position;
+
+typedef struct
+{
+    unsigned char x;
+    unsigned char y;
+}t_cell; // 区画の座標
+
+typedef enum
+{
+    LOCAL_FRONT=0, // 前
+    LOCAL_RIGHT=1, // 右
+    LOCAL_REAR=2,  // 後
+    LOCAL_LEFT=3,  // 左
+    LOCAL_UNKNOWN, // 方向不明
+}ENUM_LOCAL_DIRECTION; // 自分から見た方向を示す列挙型
+typedef unsigned int t_local_dir;
+
+// ゴール区画
+// 左下の区画の座標と、X方向、Y方向の区画数で表す
+typedef struct
+{
+    int x;
+    int y;
+    int sizeX;
+    int sizeY;
+}t_goal;
+
+extern const t_steps INIT_STEPS; // 未到達の区画の歩数
+extern const t_steps MIN_STEP;
+extern const t_goal START_GOAL; // スタート区画に戻るときのゴール
+
+extern void initMaze(void);
+extern void setWallMap(t_wall wallMap[MAZESIZE_X][MAZESIZE_Y]);
+extern void getWallMap(t_wall wallMap[MAZESIZE_X][MAZESIZE_Y]);
+extern int isGoal(const t_goal *goal, int x, int y);
+extern int getWall(int x, int y, t_direction dir);
+extern void updateWall(int x, int y, t_direction dir, int wall);
+extern int getNeighbor(int x, int y, t_direction dir, int *nextX, int *nextY);
+extern int isUnknown(int x, int y);
+extern t_steps getSteps(int x, int y);
+extern void makeStepMap(const t_goal *goal, int mask);
+extern void updateStepMap(const t_goal *goal, int mask);
+extern void setWall(const t_goal *goal, const t_position *mypos, 
+        const int isWall[DIREC_NUM]);
+extern t_local_dir getNextDirection(const t_goal *goal, const int mask, t_direction *dir,
+        const t_position *mypos);
+extern t_local_dir getNextCandidateDirection(const t_goal *goal, t_direction *dir,
+        const t_position *mypos);
+extern int countKnownStraightCells(const t_position *mypos);
+extern void saveMazeState(void);
+extern void restoreMazeState(void);
+
+#endif
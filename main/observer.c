@@ -239,6 +239,7 @@ void dialObservation(void){
 
 void TaskObservation(void *arg){
     // 観測データを加工するタスク
+    (void)arg;
 
 
     ESP_LOGI(TAG, "Complete initialization.");
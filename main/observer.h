@@ -3,5 +3,10 @@
 
 extern void TaskObservation(void *arg);
 extern void updateWallThresholds(void);
+extern void batteryObservation(void);
+extern void movingDistanceObservation(void);
+extern void angleObservation(void);
+extern void wallObservation(void);
+extern void wallErrorObservation(void);
 
 #endif
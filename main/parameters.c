@@ -6,6 +6,30 @@
 const float pTIRE_DIAMETER = _TIRE_DIAMETER; // meters
 const float pTIRE_RADIUS = _TIRE_DIAMETER/2.0; // meters
 
+// 走行制御のフィードフォワードの計算方法
+// 0なら、速度と角速度に固定のゲインをかける(実機で合わせてある)
+// 固定のゲインでは加速度のゲインが0なので、計画上の加速度は使わない
+// 1なら、下のモータと車体のモデルで計算する。モデルの値を実機で同定してから切り替えること
+// host/sim_motionは、0のときのフィードフォワードが以前の固定ゲインと同じか確かめる
+const int pFEEDFORWARD_MODEL = 0;
+
+// モータと車体のモデル
+// 走行制御のフィードフォワードで、目標の速度と加速度からモータ電圧を計算するのに使う
+// 注意: 下の値はすべて仮の値で、host/sim_plant.cの車体モデルをそのまま写したもの
+// 実機では1つも測っていない。pFEEDFORWARD_MODELを1にする前に、
+// 実機の定数(モータのデータシート、重さ、回転の慣性、摩擦)を同定して置き換えること
+const t_motor_model pMOTOR_MODEL = {
+    .backEmfConstant = 0.008,
+    .torqueConstant = 0.008,
+    .resistance = 4.0,
+    .frictionTorque = 0.0002,
+    .viscousFriction = 0.000001,
+    .gearRatio = 1.0,
+    .mass = 0.025,
+    .inertia = 0.000008,
+    .tread = 0.028,
+};
+
 // 低電圧検知用の電圧値。下回ると低電圧。
 const float pLOW_BATTERY_VOLTAGE = 3.7; // volts
 
@@ -23,6 +47,18 @@ const float pSEARCH_ACCEL = 1.0; // m/ss
 const float pFAST_MAX_SPEED = 0.4; // m/s
 const float pFAST_TIMEOUT = 2.0; // sec
 const float pFAST_ACCEL = 1.5; // m/ss
+const float pFAST_STRAIGHT_MAX_SPEED = 1.0; // m/s 直線の最高速度
+const float pFAST_DIAGONAL_MAX_SPEED = 0.7; // m/s 斜め直線の最高速度
+const float pFAST_MIN_TURN_SPEED = 0.2; // m/s これより遅いとstraight()が止まってしまう
+
+// 加減速をなめらかにするパラメータ
+// 加速度を0から最大まで変える時間で決め、ジャークは加速度をこの時間で割った値にする
+const float pJERK_TIME = 0.02; // sec 直線と超信地旋回
+const float pSLALOM_JERK_TIME = 0.005; // sec スラローム(表の速度で走るとき)
+
+// スラロームの角度のフィードバックゲイン
+// 目標の角度とのずれ(rad)にかけて、角速度(rad/s)に足す
+const float pSLALOM_ANGLE_GAIN = 50.0; // 1/s
 
 // けつ当て用のパラメータ
 const float pKETSU_DISTANCE = 0.003; // m/s
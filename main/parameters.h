@@ -5,6 +5,24 @@
 const float pTIRE_DIAMETER; // meters
 const float pTIRE_RADIUS; // meters
 
+// 走行制御のフィードフォワードの計算方法(0:固定のゲイン 1:モータと車体のモデル)
+const int pFEEDFORWARD_MODEL;
+
+// モータと車体のモデル(走行制御のフィードフォワード用)
+// pMOTOR_MODELの値は実機で同定していない仮の値(parameters.cを参照)
+typedef struct{
+    float backEmfConstant; // 逆起電力定数 Ke V/(rad/s)
+    float torqueConstant; // トルク定数 Kt Nm/A
+    float resistance; // モータの巻線抵抗 R ohm
+    float frictionTorque; // 動摩擦トルク(モータ軸) Nm
+    float viscousFriction; // 粘性摩擦係数(モータ軸) Nm/(rad/s)
+    float gearRatio; // 減速比
+    float mass; // 車体の質量 kg
+    float inertia; // 車体の鉛直軸周りの慣性モーメント kg m^2
+    float tread; // 左右のタイヤの間隔 meters
+}t_motor_model;
+const t_motor_model pMOTOR_MODEL;
+
 // 低電圧検知用の電圧値。下回ると低電圧。
 const float pLOW_BATTERY_VOLTAGE; // volts
 
@@ -21,6 +39,16 @@ const float pSEARCH_ACCEL; // m/ss
 const float pFAST_MAX_SPEED; // m/s
 const float pFAST_TIMEOUT; // sec
 const float pFAST_ACCEL; // m/ss
+const float pFAST_STRAIGHT_MAX_SPEED; // m/s
+const float pFAST_DIAGONAL_MAX_SPEED; // m/s
+const float pFAST_MIN_TURN_SPEED; // m/s
+
+// 加減速をなめらかにするパラメータ
+const float pJERK_TIME; // sec
+const float pSLALOM_JERK_TIME; // sec
+
+// スラロームの角度のフィードバックゲイン
+const float pSLALOM_ANGLE_GAIN; // 1/s
 
 // けつ当て用のパラメータ
 const float pKETSU_DISTANCE; // m/s
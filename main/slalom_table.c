@@ -0,0 +1,1096 @@
+// スラロームの角速度の表
+// host/gen_slalom_table.cで作ったので、直接編集しないこと
+// SEARCH_SLALOM、FAST_TURNS、SLALOM_SPEEDS、pSLALOM_JERK_TIMEを変えたら作り直す
+//   $ ./host/build/gen_slalom_table > main/slalom_table.c
+// host/sim_motionで、表がslalomCurve()と一致するか確かめられる
+
+#include "trajectory.h"
+
+static const float OMEGA_SEARCH_020[295] = {
+    0.00333, 0.02333, 0.06333, 0.12333, 0.20333, 0.30000, 0.40000, 0.50000,
+    0.60000, 0.70000, 0.80000, 0.90000, 1.00000, 1.10000, 1.20000, 1.30000,
+    1.40000, 1.50000, 1.60000, 1.70000, 1.80000, 1.90000, 2.00000, 2.10000,
+    2.20000, 2.30000, 2.40000, 2.50001, 2.60000, 2.69999, 2.80001, 2.90000,
+    2.99999, 3.10000, 3.19999, 3.30000, 3.40001, 3.49999, 3.60001, 3.70000,
+    3.80001, 3.89999, 4.00001, 4.09999, 4.20000, 4.29999, 4.39999, 4.50002,
+    4.59999, 4.70001, 4.79998, 4.90002, 5.00000, 5.10000, 5.20000, 5.30002,
+    5.39999, 5.49997, 5.60004, 5.69999, 5.80001, 5.89998, 6.00003, 6.10001,
+    6.19996, 6.30000, 6.40002, 6.50001, 6.59996, 6.70001, 6.80000, 6.89997,
+    6.99915, 7.08619, 7.15339, 7.20054, 7.22778, 7.23588, 7.23603, 7.23597,
+    7.23600, 7.23603, 7.23597, 7.23603, 7.23603, 7.23600, 7.23600, 7.23600,
+    7.23603, 7.23603, 7.23597, 7.23603, 7.23600, 7.23597, 7.23603, 7.23603,
+    7.23603, 7.23594, 7.23606, 7.23600, 7.23603, 7.23597, 7.23600, 7.23606,
+    7.23594, 7.23603, 7.23603, 7.23600, 7.23600, 7.23600, 7.23606, 7.23600,
+    7.23594, 7.23606, 7.23606, 7.23594, 7.23600, 7.23606, 7.23600, 7.23600,
+    7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23606, 7.23606, 7.23600,
+    7.23588, 7.23600, 7.23606, 7.23606, 7.23600, 7.23600, 7.23600, 7.23606,
+    7.23594, 7.23600, 7.23600, 7.23600, 7.23606, 7.23606, 7.23600, 7.23588,
+    7.23606, 7.23600, 7.23606, 7.23600, 7.23600, 7.23600, 7.23600, 7.23600,
+    7.23600, 7.23600, 7.23600, 7.23612, 7.23600, 7.23600, 7.23588, 7.23612,
+    7.23600, 7.23600, 7.23600, 7.23600, 7.23612, 7.23588, 7.23600, 7.23600,
+    7.23600, 7.23612, 7.23600, 7.23600, 7.23588, 7.23600, 7.23612, 7.23600,
+    7.23600, 7.23600, 7.23600, 7.23612, 7.23588, 7.23600, 7.23600, 7.23612,
+    7.23600, 7.23600, 7.23600, 7.23588, 7.23612, 7.23600, 7.23600, 7.23600,
+    7.23600, 7.23612, 7.23588, 7.23600, 7.23600, 7.23600, 7.23612, 7.23600,
+    7.23600, 7.23600, 7.23588, 7.23612, 7.23588, 7.23624, 7.23588, 7.23612,
+    7.23588, 7.23600, 7.23612, 7.23588, 7.23612, 7.23588, 7.23612, 7.23600,
+    7.23588, 7.23362, 7.21490, 7.17676, 7.11811, 7.04002, 6.94394, 6.84416,
+    6.74391, 6.64401, 6.54411, 6.44398, 6.34420, 6.24394, 6.14417, 6.04391,
+    5.94401, 5.84412, 5.74398, 5.64420, 5.54395, 5.44417, 5.34403, 5.24390,
+    5.14412, 5.04398, 4.94421, 4.84395, 4.74417, 4.64392, 4.54402, 4.44412,
+    4.34399, 4.24409, 4.14407, 4.04418, 3.94392, 3.84414, 3.74401, 3.64411,
+    3.54397, 3.44396, 3.34418, 3.24404, 3.14403, 3.04401, 2.94411, 2.84398,
+    2.74408, 2.64406, 2.54405, 2.44415, 2.34389, 2.24411, 2.14398, 2.04420,
+    1.94407, 1.84393, 1.74403, 1.64413, 1.54400, 1.44410, 1.34397, 1.24407,
+    1.14405, 1.04415, 0.94390, 0.84412, 0.74399, 0.64409, 0.54407, 0.44405,
+    0.34404, 0.24462, 0.15616, 0.08726, 0.03850, 0.00966, 0.00036,
+};
+
+static const float OMEGA_SMALL90_020[372] = {
+    0.00083, 0.00583, 0.01583, 0.03083, 0.05083, 0.07583, 0.10583, 0.14083,
+    0.18083, 0.22583, 0.27500, 0.32500, 0.37500, 0.42500, 0.47500, 0.52500,
+    0.57500, 0.62500, 0.67500, 0.72500, 0.77500, 0.82500, 0.87500, 0.92500,
+    0.97500, 1.02500, 1.07500, 1.12500, 1.17500, 1.22500, 1.27500, 1.32500,
+    1.37500, 1.42500, 1.47500, 1.52500, 1.57500, 1.62500, 1.67500, 1.72500,
+    1.77501, 1.82499, 1.87500, 1.92500, 1.97501, 2.02499, 2.07501, 2.12500,
+    2.17499, 2.22501, 2.27500, 2.32501, 2.37498, 2.42501, 2.47501, 2.52500,
+    2.57499, 2.62500, 2.67500, 2.72498, 2.77501, 2.82501, 2.87500, 2.92501,
+    2.97499, 3.02500, 3.07500, 3.12500, 3.17499, 3.22500, 3.27501, 3.32499,
+    3.37501, 3.42500, 3.47501, 3.52497, 3.57501, 3.62501, 3.67501, 3.72498,
+    3.77500, 3.82502, 3.87497, 3.92501, 3.97500, 4.02501, 4.07498, 4.12501,
+    4.17501, 4.22500, 4.27498, 4.32500, 4.37501, 4.42497, 4.47501, 4.52502,
+    4.57501, 4.62496, 4.67502, 4.72501, 4.77500, 4.82497, 4.87502, 4.92501,
+    4.97496, 5.02503, 5.07501, 5.12499, 5.17499, 5.22500, 5.27501, 5.32502,
+    5.37497, 5.42501, 5.47501, 5.52493, 5.57503, 5.62504, 5.67499, 5.72500,
+    5.77500, 5.82501, 5.87499, 5.92497, 5.97501, 6.02505, 6.07500, 6.12503,
+    6.17489, 6.22502, 6.27503, 6.32498, 6.37504, 6.42499, 6.47497, 6.52504,
+    6.57487, 6.62506, 6.67498, 6.72504, 6.77499, 6.82500, 6.87504, 6.92490,
+    6.97500, 7.02330, 7.06685, 7.10553, 7.13909, 7.16770, 7.19118, 7.20990,
+    7.22349, 7.23207, 7.23571, 7.23606, 7.23600, 7.23606, 7.23588, 7.23606,
+    7.23600, 7.23600, 7.23606, 7.23600, 7.23606, 7.23588, 7.23600, 7.23606,
+    7.23600, 7.23606, 7.23600, 7.23600, 7.23594, 7.23606, 7.23600, 7.23600,
+    7.23600, 7.23606, 7.23600, 7.23606, 7.23588, 7.23606, 7.23600, 7.23606,
+    7.23600, 7.23600, 7.23606, 7.23588, 7.23606, 7.23600, 7.23600, 7.23606,
+    7.23600, 7.23606, 7.23588, 7.23600, 7.23606, 7.23606, 7.23600, 7.23600,
+    7.23600, 7.23606, 7.23594, 7.23600, 7.23600, 7.23600, 7.23606, 7.23606,
+    7.23600, 7.23588, 7.23606, 7.23600, 7.23606, 7.23600, 7.23600, 7.23600,
+    7.23600, 7.23541, 7.23076, 7.22110, 7.20668, 7.18689, 7.16245, 7.13277,
+    7.09808, 7.05862, 7.01404, 6.96504, 6.91497, 6.86502, 6.81508, 6.76501,
+    6.71506, 6.66499, 6.61504, 6.56497, 6.51515, 6.46508, 6.41489, 6.36506,
+    6.31499, 6.26504, 6.21510, 6.16503, 6.11508, 6.06501, 6.01494, 5.96499,
+    5.91505, 5.86510, 5.81491, 5.76520, 5.71489, 5.66518, 5.61500, 5.56505,
+    5.51498, 5.46491, 5.41520, 5.36489, 5.31518, 5.26500, 5.21505, 5.16510,
+    5.11491, 5.06508, 5.01490, 4.96519, 4.91500, 4.86505, 4.81498, 4.76515,
+    4.71497, 4.66490, 4.61519, 4.56488, 4.51517, 4.46498, 4.41515, 4.36497,
+    4.31490, 4.26507, 4.21500, 4.16517, 4.11499, 4.06504, 4.01509, 3.96490,
+    3.91507, 3.86500, 3.81517, 3.76487, 3.71516, 3.66497, 3.61502, 3.56507,
+    3.51501, 3.46506, 3.41499, 3.36504, 3.31497, 3.26502, 3.21507, 3.16501,
+    3.11506, 3.06511, 3.01504, 2.96497, 2.91491, 2.86508, 2.81501, 2.76518,
+    2.71487, 2.66516, 2.61497, 2.56503, 2.51508, 2.46501, 2.41506, 2.36499,
+    2.31504, 2.26498, 2.21515, 2.16496, 2.11501, 2.06506, 2.01499, 1.96517,
+    1.91498, 1.86503, 1.81496, 1.76501, 1.71506, 1.66500, 1.61517, 1.56498,
+    1.51503, 1.46508, 1.41490, 1.36507, 1.31512, 1.26505, 1.21498, 1.16503,
+    1.11496, 1.06502, 1.01507, 0.96500, 0.91505, 0.86510, 0.81503, 0.76497,
+    0.71502, 0.66507, 0.61500, 0.56505, 0.51510, 0.46504, 0.41497, 0.36502,
+    0.31519, 0.26500, 0.21636, 0.17262, 0.13340, 0.09942, 0.07045, 0.04649,
+    0.02742, 0.01335, 0.00453, 0.00048,
+};
+
+static const float OMEGA_SMALL90_030[248] = {
+    0.00281, 0.01969, 0.05344, 0.10406, 0.17156, 0.25594, 0.35708, 0.46875,
+    0.58125, 0.69375, 0.80625, 0.91875, 1.03125, 1.14375, 1.25625, 1.36875,
+    1.48125, 1.59375, 1.70625, 1.81875, 1.93125, 2.04375, 2.15625, 2.26875,
+    2.38125, 2.49374, 2.60626, 2.71874, 2.83125, 2.94375, 3.05625, 3.16876,
+    3.28124, 3.39376, 3.50624, 3.61874, 3.73126, 3.84374, 3.95627, 4.06874,
+    4.18125, 4.29375, 4.40626, 4.51874, 4.63126, 4.74375, 4.85624, 4.96876,
+    5.08124, 5.19376, 5.30624, 5.41876, 5.53124, 5.64375, 5.75626, 5.86876,
+    5.98124, 6.09374, 6.20624, 6.31875, 6.43128, 6.54373, 6.65627, 6.76876,
+    6.88119, 6.99377, 7.10626, 7.21876, 7.33124, 7.44374, 7.55629, 7.66870,
+    7.78127, 7.89374, 8.00628, 8.11872, 8.23125, 8.34376, 8.45629, 8.56870,
+    8.68127, 8.79377, 8.90622, 9.01872, 9.13128, 9.24376, 9.35620, 9.46876,
+    9.58127, 9.69377, 9.80622, 9.91875, 10.03131, 10.14370, 10.25626, 10.36876,
+    10.48088, 10.58424, 10.67114, 10.74111, 10.79422, 10.83040, 10.84977, 10.85406,
+    10.85395, 10.85406, 10.85401, 10.85406, 10.85395, 10.85406, 10.85401, 10.85406,
+    10.85395, 10.85406, 10.85401, 10.85395, 10.85406, 10.85406, 10.85401, 10.85401,
+    10.85401, 10.85401, 10.85406, 10.85395, 10.85406, 10.85406, 10.85401, 10.85406,
+    10.85383, 10.85413, 10.85401, 10.85401, 10.85406, 10.85406, 10.85401, 10.85406,
+    10.85383, 10.85413, 10.85401, 10.85401, 10.85406, 10.85406, 10.85401, 10.85389,
+    10.85401, 10.84816, 10.82659, 10.78820, 10.73277, 10.66053, 10.57136, 10.46622,
+    10.35380, 10.24127, 10.12886, 10.01632, 9.90379, 9.79137, 9.67860, 9.56631,
+    9.45389, 9.34124, 9.22883, 9.11629, 9.00388, 8.89122, 8.77881, 8.66628,
+    8.55386, 8.44133, 8.32868, 8.21638, 8.10373, 7.99131, 7.87878, 7.76637,
+    7.65371, 7.54142, 7.42877, 7.31623, 7.20382, 7.09128, 6.97875, 6.86634,
+    6.75380, 6.64139, 6.52874, 6.41620, 6.30391, 6.19125, 6.07884, 5.96631,
+    5.85377, 5.74136, 5.62871, 5.51629, 5.40376, 5.29134, 5.17881, 5.06628,
+    4.95386, 4.84133, 4.72867, 4.61638, 4.50385, 4.39131, 4.27878, 4.16625,
+    4.05383, 3.94130, 3.82876, 3.71623, 3.60394, 3.49116, 3.37887, 3.26633,
+    3.15380, 3.04127, 2.92885, 2.81620, 2.70379, 2.59137, 2.47884, 2.36630,
+    2.25377, 2.14124, 2.02882, 1.91629, 1.80387, 1.69134, 1.57869, 1.46616,
+    1.35398, 1.24133, 1.12867, 1.01638, 0.90373, 0.79131, 0.67878, 0.56636,
+    0.45383, 0.34261, 0.24390, 0.16153, 0.09644, 0.04792, 0.01645, 0.00191,
+};
+
+static const float OMEGA_SMALL90_040[186] = {
+    0.00667, 0.04667, 0.12667, 0.24667, 0.40667, 0.60000, 0.80000, 1.00000,
+    1.20000, 1.40000, 1.60000, 1.80000, 2.00000, 2.20000, 2.40000, 2.60000,
+    2.80000, 3.00000, 3.20000, 3.40000, 3.60000, 3.80000, 3.99999, 4.20001,
+    4.40000, 4.60001, 4.79999, 5.00001, 5.19999, 5.39999, 5.60002, 5.80001,
+    5.99999, 6.20001, 6.39999, 6.59999, 6.80001, 6.99998, 7.20002, 7.39999,
+    7.60002, 7.79998, 8.00002, 8.19999, 8.40001, 8.59998, 8.79998, 9.00003,
+    9.19998, 9.40003, 9.59997, 9.80003, 9.99999, 10.19999, 10.40000, 10.60003,
+    10.79997, 10.99995, 11.20007, 11.39998, 11.60002, 11.79996, 12.00005, 12.20003,
+    12.39991, 12.60000, 12.80004, 13.00001, 13.19993, 13.40002, 13.59999, 13.79994,
+    13.99830, 14.17237, 14.30678, 14.40108, 14.45556, 14.47177, 14.47207, 14.47195,
+    14.47201, 14.47207, 14.47195, 14.47207, 14.47207, 14.47201, 14.47201, 14.47201,
+    14.47207, 14.47207, 14.47195, 14.47207, 14.47201, 14.47195, 14.47207, 14.47207,
+    14.47207, 14.47189, 14.47213, 14.47201, 14.47207, 14.47195, 14.47201, 14.47213,
+    14.47189, 14.47207, 14.47207, 14.47201, 14.47141, 14.45186, 14.39357, 14.29522,
+    14.15670, 13.97908, 13.78000, 13.58008, 13.38005, 13.18002, 12.98022, 12.77995,
+    12.58004, 12.38012, 12.18009, 11.97994, 11.78014, 11.58011, 11.38008, 11.18004,
+    10.97989, 10.78010, 10.58018, 10.38015, 10.18000, 9.98008, 9.78005, 9.58014,
+    9.37986, 9.18007, 8.98015, 8.78012, 8.57997, 8.38017, 8.18002, 7.97999,
+    7.78008, 7.58004, 7.38013, 7.18009, 6.98006, 6.78003, 6.58000, 6.38008,
+    6.18017, 5.98001, 5.77998, 5.58019, 5.38003, 5.18000, 4.98009, 4.78005,
+    4.58002, 4.38011, 4.18007, 3.98016, 3.78001, 3.57997, 3.38006, 3.18015,
+    2.98011, 2.77996, 2.58017, 2.38001, 2.17998, 1.98007, 1.78015, 1.58000,
+    1.38009, 1.18005, 0.98014, 0.77999, 0.58019, 0.38898, 0.23282, 0.11694,
+    0.04077, 0.00501,
+};
+
+static const float OMEGA_LARGE90_020[744] = {
+    0.00015, 0.00108, 0.00293, 0.00571, 0.00941, 0.01404, 0.01960, 0.02608,
+    0.03349, 0.04182, 0.05108, 0.06127, 0.07238, 0.08441, 0.09738, 0.11111,
+    0.12500, 0.13889, 0.15278, 0.16667, 0.18056, 0.19444, 0.20833, 0.22222,
+    0.23611, 0.25000, 0.26389, 0.27778, 0.29167, 0.30556, 0.31944, 0.33333,
+    0.34722, 0.36111, 0.37500, 0.38889, 0.40278, 0.41667, 0.43056, 0.44444,
+    0.45833, 0.47222, 0.48611, 0.50000, 0.51389, 0.52778, 0.54167, 0.55556,
+    0.56944, 0.58333, 0.59722, 0.61111, 0.62500, 0.63889, 0.65278, 0.66667,
+    0.68055, 0.69444, 0.70833, 0.72222, 0.73611, 0.75000, 0.76389, 0.77778,
+    0.79166, 0.80556, 0.81944, 0.83334, 0.84722, 0.86111, 0.87500, 0.88888,
+    0.90278, 0.91667, 0.93056, 0.94444, 0.95833, 0.97223, 0.98611, 0.99999,
+    1.01389, 1.02778, 1.04166, 1.05556, 1.06945, 1.08334, 1.09721, 1.11111,
+    1.12500, 1.13889, 1.15277, 1.16667, 1.18056, 1.19444, 1.20833, 1.22223,
+    1.23611, 1.24999, 1.26389, 1.27778, 1.29167, 1.30555, 1.31945, 1.33334,
+    1.34721, 1.36111, 1.37500, 1.38889, 1.40277, 1.41667, 1.43056, 1.44444,
+    1.45832, 1.47223, 1.48612, 1.49999, 1.51390, 1.52778, 1.54167, 1.55555,
+    1.56945, 1.58333, 1.59723, 1.61110, 1.62500, 1.63889, 1.65279, 1.66667,
+    1.68053, 1.69445, 1.70834, 1.72222, 1.73612, 1.75001, 1.76388, 1.77778,
+    1.79166, 1.80556, 1.81943, 1.83335, 1.84722, 1.86111, 1.87501, 1.88886,
+    1.90279, 1.91666, 1.93056, 1.94445, 1.95833, 1.97223, 1.98609, 2.00002,
+    2.01388, 2.02779, 2.04165, 2.05557, 2.06944, 2.08335, 2.09717, 2.11112,
+    2.12499, 2.13891, 2.15277, 2.16667, 2.18056, 2.19442, 2.20834, 2.22223,
+    2.23611, 2.25002, 2.26387, 2.27779, 2.29163, 2.30557, 2.31943, 2.33336,
+    2.34723, 2.36110, 2.37502, 2.38888, 2.40274, 2.41669, 2.43054, 2.44446,
+    2.45835, 2.47222, 2.48611, 2.49997, 2.51389, 2.52780, 2.54166, 2.55555,
+    2.56948, 2.58332, 2.59717, 2.61113, 2.62500, 2.63889, 2.65279, 2.66668,
+    2.68054, 2.69446, 2.70829, 2.72226, 2.73609, 2.75001, 2.76390, 2.77779,
+    2.79164, 2.80556, 2.81942, 2.83334, 2.84722, 2.86114, 2.87500, 2.88889,
+    2.90272, 2.91672, 2.93055, 2.94441, 2.95836, 2.97225, 2.98610, 3.00002,
+    3.01376, 3.02696, 3.03918, 3.05048, 3.06085, 3.07029, 3.07882, 3.08636,
+    3.09306, 3.09882, 3.10361, 3.10752, 3.11050, 3.11249, 3.11360, 3.11387,
+    3.11390, 3.11390, 3.11390, 3.11390, 3.11387, 3.11390, 3.11387, 3.11387,
+    3.11390, 3.11390, 3.11384, 3.11396, 3.11384, 3.11393, 3.11384, 3.11396,
+    3.11384, 3.11384, 3.11396, 3.11384, 3.11393, 3.11384, 3.11396, 3.11384,
+    3.11387, 3.11393, 3.11384, 3.11396, 3.11384, 3.11393, 3.11384, 3.11396,
+    3.11384, 3.11384, 3.11396, 3.11384, 3.11393, 3.11384, 3.11396, 3.11384,
+    3.11387, 3.11393, 3.11381, 3.11399, 3.11381, 3.11393, 3.11387, 3.11387,
+    3.11393, 3.11381, 3.11399, 3.11381, 3.11393, 3.11387, 3.11387, 3.11393,
+    3.11381, 3.11399, 3.11387, 3.11387, 3.11387, 3.11387, 3.11393, 3.11387,
+    3.11393, 3.11387, 3.11393, 3.11381, 3.11387, 3.11393, 3.11387, 3.11393,
+    3.11387, 3.11393, 3.11381, 3.11399, 3.11381, 3.11387, 3.11393, 3.11387,
+    3.11393, 3.11381, 3.11399, 3.11381, 3.11387, 3.11393, 3.11387, 3.11393,
+    3.11381, 3.11399, 3.11387, 3.11381, 3.11393, 3.11387, 3.11393, 3.11381,
+    3.11399, 3.11387, 3.11381, 3.11393, 3.11387, 3.11393, 3.11381, 3.11399,
+    3.11387, 3.11381, 3.11393, 3.11387, 3.11393, 3.11381, 3.11399, 3.11387,
+    3.11381, 3.11393, 3.11387, 3.11393, 3.11381, 3.11399, 3.11387, 3.11387,
+    3.11387, 3.11387, 3.11393, 3.11387, 3.11393, 3.11387, 3.11393, 3.11381,
+    3.11387, 3.11393, 3.11387, 3.11393, 3.11387, 3.11393, 3.11381, 3.11387,
+    3.11399, 3.11381, 3.11393, 3.11387, 3.11393, 3.11381, 3.11387, 3.11399,
+    3.11381, 3.11393, 3.11387, 3.11393, 3.11381, 3.11387, 3.11399, 3.11381,
+    3.11393, 3.11387, 3.11393, 3.11381, 3.11399, 3.11387, 3.11381, 3.11393,
+    3.11387, 3.11393, 3.11387, 3.11393, 3.11387, 3.11381, 3.11393, 3.11387,
+    3.11393, 3.11387, 3.11393, 3.11387, 3.11381, 3.11393, 3.11387, 3.11393,
+    3.11387, 3.11393, 3.11387, 3.11381, 3.11393, 3.11387, 3.11393, 3.11387,
+    3.11393, 3.11387, 3.11381, 3.11399, 3.11381, 3.11393, 3.11387, 3.11393,
+    3.11387, 3.11381, 3.11399, 3.11381, 3.11393, 3.11387, 3.11393, 3.11387,
+    3.11387, 3.11399, 3.11375, 3.11399, 3.11375, 3.11399, 3.11387, 3.11387,
+    3.11399, 3.11375, 3.11399, 3.11375, 3.11399, 3.11387, 3.11387, 3.11399,
+    3.11375, 3.11399, 3.11375, 3.11399, 3.11387, 3.11387, 3.11399, 3.11375,
+    3.11399, 3.11375, 3.11399, 3.11387, 3.11387, 3.11399, 3.11375, 3.11399,
+    3.11375, 3.11399, 3.11387, 3.11387, 3.11399, 3.11375, 3.11399, 3.11375,
+    3.11399, 3.11387, 3.11387, 3.11399, 3.11387, 3.11387, 3.11375, 3.11399,
+    3.11387, 3.11399, 3.11387, 3.11375, 3.11399, 3.11375, 3.11399, 3.11399,
+    3.11375, 3.11387, 3.11410, 3.11375, 3.11387, 3.11387, 3.11399, 3.11387,
+    3.11387, 3.11327, 3.11208, 3.10946, 3.10624, 3.10194, 3.09682, 3.09098,
+    3.08383, 3.07596, 3.06702, 3.05724, 3.04675, 3.03495, 3.02243, 3.00896,
+    2.99525, 2.98119, 2.96736, 2.95341, 2.93946, 2.92587, 2.91169, 2.89786,
+    2.88403, 2.87008, 2.85637, 2.84231, 2.82836, 2.81453, 2.80082, 2.78676,
+    2.77293, 2.75898, 2.74503, 2.73132, 2.71738, 2.70343, 2.68948, 2.67589,
+    2.66171, 2.64788, 2.63393, 2.62010, 2.60639, 2.59233, 2.57838, 2.56455,
+    2.55060, 2.53701, 2.52283, 2.50900, 2.49505, 2.48134, 2.46727, 2.45345,
+    2.43962, 2.42555, 2.41196, 2.39789, 2.38395, 2.37012, 2.35617, 2.34246,
+    2.32840, 2.31457, 2.30062, 2.28691, 2.27284, 2.25902, 2.24507, 2.23124,
+    2.21741, 2.20346, 2.18952, 2.17569, 2.16174, 2.14803, 2.13397, 2.12002,
+    2.10631, 2.09236, 2.07841, 2.06459, 2.05064, 2.03681, 2.02298, 2.00891,
+    1.99521, 1.98114, 1.96743, 1.95348, 1.93954, 1.92571, 1.91164, 1.89805,
+    1.88398, 1.87016, 1.85609, 1.84238, 1.82855, 1.81460, 1.80054, 1.78683,
+    1.77300, 1.75893, 1.74510, 1.73116, 1.71745, 1.70350, 1.68955, 1.67561,
+    1.66178, 1.64795, 1.63412, 1.62005, 1.60623, 1.59228, 1.57857, 1.56450,
+    1.55067, 1.53673, 1.52290, 1.50907, 1.49512, 1.48118, 1.46735, 1.45352,
+    1.43957, 1.42562, 1.41180, 1.39797, 1.38402, 1.37007, 1.35624, 1.34230,
+    1.32847, 1.31464, 1.30069, 1.28675, 1.27292, 1.25897, 1.24514, 1.23131,
+    1.21725, 1.20342, 1.18971, 1.17564, 1.16169, 1.14799, 1.13404, 1.12009,
+    1.10626, 1.09231, 1.07849, 1.06454, 1.05071, 1.03676, 1.02293, 1.00899,
+    0.99516, 0.98121, 0.96726, 0.95356, 0.93961, 0.92554, 0.91171, 0.89788,
+    0.88406, 0.87023, 0.85628, 0.84221, 0.82850, 0.81456, 0.80073, 0.78678,
+    0.77295, 0.75889, 0.74518, 0.73123, 0.71728, 0.70357, 0.68951, 0.67568,
+    0.66185, 0.64778, 0.63407, 0.62013, 0.60618, 0.59247, 0.57840, 0.56458,
+    0.55063, 0.53680, 0.52285, 0.50902, 0.49520, 0.48113, 0.46742, 0.45347,
+    0.43952, 0.42570, 0.41175, 0.39792, 0.38397, 0.37014, 0.35632, 0.34225,
+    0.32842, 0.31471, 0.30065, 0.28682, 0.27287, 0.25892, 0.24521, 0.23127,
+    0.21720, 0.20349, 0.18954, 0.17571, 0.16177, 0.14794, 0.13411, 0.12016,
+    0.10610, 0.09274, 0.08011, 0.06843, 0.05758, 0.04768, 0.03874, 0.03088,
+    0.02372, 0.01752, 0.01228, 0.00799, 0.00465, 0.00215, 0.00072, 0.00000,
+};
+
+static const float OMEGA_LARGE90_030[496] = {
+    0.00052, 0.00365, 0.00990, 0.01927, 0.03177, 0.04740, 0.06615, 0.08802,
+    0.11302, 0.14115, 0.17188, 0.20312, 0.23438, 0.26563, 0.29687, 0.32813,
+    0.35938, 0.39062, 0.42188, 0.45312, 0.48438, 0.51562, 0.54687, 0.57812,
+    0.60938, 0.64063, 0.67187, 0.70313, 0.73437, 0.76563, 0.79688, 0.82813,
+    0.85937, 0.89063, 0.92187, 0.95312, 0.98438, 1.01562, 1.04688, 1.07812,
+    1.10938, 1.14062, 1.17188, 1.20313, 1.23438, 1.26562, 1.29687, 1.32813,
+    1.35937, 1.39063, 1.42188, 1.45313, 1.48437, 1.51563, 1.54688, 1.57813,
+    1.60937, 1.64063, 1.67188, 1.70312, 1.73438, 1.76563, 1.79688, 1.82813,
+    1.85937, 1.89062, 1.92188, 1.95312, 1.98437, 2.01563, 2.04688, 2.07812,
+    2.10938, 2.14063, 2.17188, 2.20311, 2.23438, 2.26562, 2.29689, 2.32811,
+    2.35938, 2.39063, 2.42186, 2.45313, 2.48437, 2.51564, 2.54685, 2.57813,
+    2.60937, 2.64064, 2.67185, 2.70313, 2.73439, 2.76561, 2.79688, 2.82812,
+    2.85940, 2.89060, 2.92188, 2.95313, 2.98439, 3.01561, 3.04687, 3.07815,
+    3.10935, 3.14063, 3.17188, 3.20314, 3.23436, 3.26562, 3.29688, 3.32814,
+    3.35936, 3.39062, 3.42189, 3.45311, 3.48438, 3.51563, 3.54688, 3.57811,
+    3.60937, 3.64064, 3.67188, 3.70310, 3.73438, 3.76564, 3.79689, 3.82811,
+    3.85933, 3.89065, 3.92187, 3.95313, 3.98439, 4.01562, 4.04686, 4.07815,
+    4.10932, 4.14062, 4.17191, 4.20314, 4.23437, 4.26561, 4.29690, 4.32804,
+    4.35939, 4.39066, 4.42189, 4.45312, 4.48439, 4.51559, 4.54500, 4.57153,
+    4.59489, 4.61507, 4.63217, 4.64612, 4.65697, 4.66466, 4.66916, 4.67080,
+    4.67083, 4.67086, 4.67083, 4.67083, 4.67083, 4.67077, 4.67083, 4.67086,
+    4.67083, 4.67083, 4.67083, 4.67086, 4.67074, 4.67086, 4.67083, 4.67083,
+    4.67083, 4.67083, 4.67086, 4.67083, 4.67077, 4.67083, 4.67083, 4.67086,
+    4.67083, 4.67083, 4.67086, 4.67074, 4.67086, 4.67080, 4.67086, 4.67086,
+    4.67080, 4.67086, 4.67074, 4.67086, 4.67080, 4.67086, 4.67086, 4.67080,
+    4.67086, 4.67080, 4.67080, 4.67080, 4.67086, 4.67086, 4.67086, 4.67080,
+    4.67086, 4.67074, 4.67086, 4.67080, 4.67086, 4.67086, 4.67080, 4.67086,
+    4.67080, 4.67080, 4.67080, 4.67086, 4.67086, 4.67086, 4.67080, 4.67080,
+    4.67080, 4.67080, 4.67086, 4.67086, 4.67086, 4.67080, 4.67080, 4.67080,
+    4.67086, 4.67080, 4.67086, 4.67086, 4.67080, 4.67086, 4.67080, 4.67080,
+    4.67080, 4.67086, 4.67086, 4.67086, 4.67080, 4.67080, 4.67080, 4.67080,
+    4.67086, 4.67086, 4.67074, 4.67092, 4.67080, 4.67086, 4.67080, 4.67092,
+    4.67074, 4.67074, 4.67098, 4.67074, 4.67086, 4.67080, 4.67092, 4.67074,
+    4.67074, 4.67098, 4.67074, 4.67086, 4.67086, 4.67086, 4.67074, 4.67098,
+    4.67074, 4.67074, 4.67086, 4.67086, 4.67086, 4.67074, 4.67098, 4.67074,
+    4.67074, 4.67086, 4.67086, 4.67086, 4.67074, 4.67098, 4.67074, 4.67074,
+    4.67098, 4.67074, 4.67086, 4.67074, 4.67098, 4.67074, 4.67074, 4.67098,
+    4.67074, 4.67086, 4.67074, 4.67098, 4.67074, 4.67074, 4.67098, 4.67074,
+    4.67086, 4.67074, 4.67098, 4.67074, 4.67074, 4.67098, 4.67074, 4.67086,
+    4.67086, 4.67086, 4.67074, 4.67098, 4.67074, 4.67074, 4.67086, 4.67086,
+    4.67086, 4.67074, 4.67098, 4.67074, 4.67074, 4.67086, 4.67086, 4.67086,
+    4.67074, 4.67098, 4.67074, 4.67074, 4.67098, 4.67074, 4.67086, 4.67074,
+    4.67074, 4.66835, 4.66311, 4.65477, 4.64308, 4.62854, 4.61054, 4.58980,
+    4.56548, 4.53842, 4.50838, 4.47702, 4.44591, 4.41444, 4.38344, 4.35197,
+    4.32074, 4.28963, 4.25828, 4.22716, 4.19569, 4.16470, 4.13322, 4.10211,
+    4.07076, 4.03953, 4.00841, 3.97694, 3.94583, 3.91459, 3.88336, 3.85201,
+    3.82078, 3.78966, 3.75819, 3.72708, 3.69585, 3.66461, 3.63326, 3.60203,
+    3.57080, 3.53956, 3.50833, 3.47698, 3.44586, 3.41463, 3.38316, 3.35217,
+    3.32081, 3.28958, 3.25823, 3.22711, 3.19576, 3.16453, 3.13342, 3.10194,
+    3.07095, 3.03948, 3.00837, 2.97701, 2.94590, 2.91443, 2.88332, 2.85208,
+    2.82085, 2.78962, 2.75826, 2.72703, 2.69580, 2.66457, 2.63333, 2.60198,
+    2.57087, 2.53952, 2.50840, 2.47693, 2.44582, 2.41458, 2.38335, 2.35212,
+    2.32077, 2.28953, 2.25830, 2.22707, 2.19584, 2.16448, 2.13337, 2.10202,
+    2.07078, 2.03955, 2.00832, 1.97721, 1.94573, 1.91450, 1.88339, 1.85204,
+    1.82080, 1.78957, 1.75834, 1.72698, 1.69587, 1.66452, 1.63341, 1.60193,
+    1.57094, 1.53947, 1.50836, 1.47700, 1.44577, 1.41466, 1.38330, 1.35207,
+    1.32072, 1.28949, 1.25837, 1.22714, 1.19579, 1.16456, 1.13332, 1.10209,
+    1.07074, 1.03951, 1.00827, 0.97716, 0.94581, 0.91457, 0.88322, 0.85211,
+    0.82088, 0.78940, 0.75841, 0.72706, 0.69582, 0.66447, 0.63336, 0.60213,
+    0.57077, 0.53954, 0.50831, 0.47708, 0.44572, 0.41461, 0.38326, 0.35214,
+    0.32079, 0.28956, 0.25833, 0.22709, 0.19574, 0.16463, 0.13423, 0.10693,
+    0.08261, 0.06151, 0.04339, 0.02861, 0.01681, 0.00811, 0.00262, 0.00024,
+};
+
+static const float OMEGA_LARGE90_040[372] = {
+    0.00123, 0.00864, 0.02346, 0.04568, 0.07531, 0.11235, 0.15679, 0.20849,
+    0.26389, 0.31944, 0.37500, 0.43056, 0.48611, 0.54167, 0.59722, 0.65278,
+    0.70833, 0.76389, 0.81944, 0.87500, 0.93056, 0.98611, 1.04167, 1.09722,
+    1.15278, 1.20833, 1.26389, 1.31944, 1.37500, 1.43055, 1.48611, 1.54167,
+    1.59722, 1.65278, 1.70833, 1.76389, 1.81945, 1.87500, 1.93056, 1.98610,
+    2.04167, 2.09722, 2.15278, 2.20833, 2.26390, 2.31944, 2.37500, 2.43056,
+    2.48611, 2.54167, 2.59722, 2.65279, 2.70832, 2.76390, 2.81944, 2.87500,
+    2.93055, 2.98610, 3.04168, 3.09721, 3.15278, 3.20833, 3.26389, 3.31946,
+    3.37498, 3.43056, 3.48613, 3.54166, 3.59721, 3.65278, 3.70833, 3.76387,
+    3.81945, 3.87502, 3.93055, 3.98611, 4.04167, 4.09722, 4.15279, 4.20830,
+    4.26391, 4.31944, 4.37498, 4.43056, 4.48613, 4.54167, 4.59720, 4.65278,
+    4.70833, 4.76390, 4.81942, 4.87500, 4.93057, 4.98608, 5.04169, 5.09721,
+    5.15281, 5.20830, 5.26390, 5.31948, 5.37500, 5.43055, 5.48610, 5.54168,
+    5.59720, 5.65276, 5.70837, 5.76389, 5.81944, 5.87496, 5.93060, 5.98612,
+    6.04072, 6.08966, 6.13114, 6.16518, 6.19188, 6.21113, 6.22299, 6.22746,
+    6.22779, 6.22779, 6.22776, 6.22773, 6.22779, 6.22779, 6.22776, 6.22779,
+    6.22767, 6.22779, 6.22776, 6.22779, 6.22779, 6.22779, 6.22776, 6.22779,
+    6.22767, 6.22779, 6.22776, 6.22779, 6.22779, 6.22779, 6.22773, 6.22773,
+    6.22773, 6.22779, 6.22779, 6.22779, 6.22779, 6.22773, 6.22773, 6.22779,
+    6.22779, 6.22773, 6.22779, 6.22779, 6.22779, 6.22779, 6.22767, 6.22779,
+    6.22773, 6.22779, 6.22779, 6.22779, 6.22779, 6.22767, 6.22779, 6.22773,
+    6.22785, 6.22773, 6.22779, 6.22779, 6.22767, 6.22779, 6.22773, 6.22785,
+    6.22773, 6.22779, 6.22779, 6.22773, 6.22773, 6.22779, 6.22779, 6.22773,
+    6.22779, 6.22779, 6.22779, 6.22767, 6.22779, 6.22779, 6.22773, 6.22785,
+    6.22773, 6.22779, 6.22767, 6.22779, 6.22779, 6.22773, 6.22785, 6.22773,
+    6.22779, 6.22779, 6.22767, 6.22779, 6.22779, 6.22779, 6.22773, 6.22779,
+    6.22779, 6.22767, 6.22779, 6.22779, 6.22779, 6.22779, 6.22773, 6.22779,
+    6.22767, 6.22779, 6.22779, 6.22779, 6.22785, 6.22773, 6.22773, 6.22773,
+    6.22773, 6.22773, 6.22785, 6.22785, 6.22773, 6.22773, 6.22773, 6.22773,
+    6.22773, 6.22785, 6.22785, 6.22773, 6.22773, 6.22773, 6.22773, 6.22773,
+    6.22785, 6.22785, 6.22773, 6.22773, 6.22785, 6.22761, 6.22773, 6.22797,
+    6.22761, 6.22785, 6.22773, 6.22785, 6.22714, 6.22153, 6.20818, 6.18780,
+    6.15978, 6.12426, 6.08170, 6.03139, 5.97644, 5.92077, 5.86534, 5.80955,
+    5.75411, 5.69868, 5.64289, 5.58758, 5.53191, 5.47636, 5.42080, 5.36537,
+    5.30958, 5.25403, 5.19872, 5.14293, 5.08761, 5.03182, 4.97639, 4.92072,
+    4.86517, 4.80986, 4.75407, 4.69863, 4.64296, 4.58753, 4.53186, 4.47631,
+    4.42088, 4.36521, 4.30977, 4.25398, 4.19867, 4.14300, 4.08745, 4.03190,
+    3.97635, 3.92091, 3.86524, 3.80969, 3.75414, 3.69847, 3.64316, 3.58737,
+    3.53193, 3.47626, 3.42095, 3.36516, 3.30973, 3.25418, 3.19850, 3.14307,
+    3.08740, 3.03197, 2.97630, 2.92087, 2.86520, 2.80976, 2.75409, 2.69854,
+    2.64311, 2.58744, 2.53189, 2.47645, 2.42066, 2.36535, 2.30968, 2.25413,
+    2.19858, 2.14303, 2.08747, 2.03192, 1.97637, 1.92082, 1.86515, 1.80960,
+    1.75428, 1.69849, 1.64306, 1.58751, 1.53184, 1.47641, 1.42086, 1.36518,
+    1.30963, 1.25420, 1.19865, 1.14298, 1.08743, 1.03188, 0.97632, 0.92089,
+    0.86522, 0.80967, 0.75412, 0.69857, 0.64313, 0.58746, 0.53179, 0.47648,
+    0.42069, 0.36526, 0.30971, 0.25427, 0.19884, 0.14853, 0.10526, 0.06962,
+    0.04125, 0.02027, 0.00679, 0.00072,
+};
+
+static const float OMEGA_LARGE90_050[298] = {
+    0.00241, 0.01688, 0.04581, 0.08922, 0.14709, 0.21943, 0.30382, 0.39063,
+    0.47743, 0.56424, 0.65104, 0.73785, 0.82465, 0.91146, 0.99826, 1.08507,
+    1.17187, 1.25868, 1.34549, 1.43229, 1.51910, 1.60590, 1.69271, 1.77951,
+    1.86632, 1.95312, 2.03993, 2.12673, 2.21354, 2.30035, 2.38715, 2.47397,
+    2.56076, 2.64757, 2.73437, 2.82118, 2.90799, 2.99478, 3.08160, 3.16840,
+    3.25521, 3.34202, 3.42882, 3.51562, 3.60245, 3.68922, 3.77604, 3.86286,
+    3.94964, 4.03647, 4.12325, 4.21008, 4.29687, 4.38368, 4.47048, 4.55730,
+    4.64409, 4.73090, 4.81772, 4.90449, 4.99134, 5.07811, 5.16495, 5.25174,
+    5.33852, 5.42536, 5.51215, 5.59896, 5.68576, 5.77259, 5.85939, 5.94613,
+    6.03300, 6.11982, 6.20660, 6.29336, 6.38023, 6.46703, 6.55384, 6.64058,
+    6.72743, 6.81424, 6.90103, 6.98787, 7.07465, 7.16147, 7.24822, 7.33510,
+    7.42188, 7.50861, 7.58997, 7.65774, 7.71099, 7.74968, 7.77406, 7.78395,
+    7.78472, 7.78466, 7.78475, 7.78472, 7.78472, 7.78466, 7.78472, 7.78472,
+    7.78466, 7.78472, 7.78472, 7.78472, 7.78466, 7.78472, 7.78472, 7.78475,
+    7.78466, 7.78472, 7.78472, 7.78466, 7.78472, 7.78472, 7.78472, 7.78466,
+    7.78472, 7.78472, 7.78472, 7.78466, 7.78472, 7.78472, 7.78472, 7.78472,
+    7.78466, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472,
+    7.78461, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78461,
+    7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78461, 7.78472,
+    7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78461, 7.78472,
+    7.78472, 7.78472, 7.78472, 7.78472, 7.78472, 7.78461, 7.78472, 7.78472,
+    7.78472, 7.78472, 7.78472, 7.78472, 7.78461, 7.78472, 7.78472, 7.78472,
+    7.78472, 7.78472, 7.78472, 7.78472, 7.78461, 7.78472, 7.78472, 7.78472,
+    7.78484, 7.78472, 7.78472, 7.78461, 7.78472, 7.78472, 7.78472, 7.78472,
+    7.78472, 7.78472, 7.78461, 7.78472, 7.78472, 7.78472, 7.78472, 7.78472,
+    7.78472, 7.78461, 7.78031, 7.76267, 7.73060, 7.68399, 7.62296, 7.54750,
+    7.46179, 7.37476, 7.28822, 7.20143, 7.11453, 7.02775, 6.94096, 6.85406,
+    6.76727, 6.68049, 6.59382, 6.50692, 6.42002, 6.33335, 6.24645, 6.15978,
+    6.07276, 5.98609, 5.89931, 5.81241, 5.72574, 5.63884, 5.55205, 5.46515,
+    5.37848, 5.29158, 5.20480, 5.11813, 5.03111, 4.94444, 4.85754, 4.77087,
+    4.68397, 4.59719, 4.51040, 4.42362, 4.33671, 4.24993, 4.16315, 4.07636,
+    3.98958, 3.90279, 3.81577, 3.72922, 3.64232, 3.55554, 3.46863, 3.38197,
+    3.29506, 3.20828, 3.12150, 3.03459, 2.94805, 2.86102, 2.77424, 2.68745,
+    2.60067, 2.51389, 2.42698, 2.34032, 2.25341, 2.16663, 2.07984, 1.99294,
+    1.90628, 1.81937, 1.73259, 1.64580, 1.55890, 1.47223, 1.38545, 1.29843,
+    1.21188, 1.12486, 1.03819, 0.95141, 0.86451, 0.77772, 0.69094, 0.60415,
+    0.51737, 0.43046, 0.34368, 0.25737, 0.17846, 0.11408, 0.06402, 0.02837,
+    0.00715, 0.00024,
+};
+
+static const float OMEGA_LARGE90_060[248] = {
+    0.00417, 0.02917, 0.07917, 0.15417, 0.25417, 0.37500, 0.50000, 0.62500,
+    0.75000, 0.87500, 1.00000, 1.12500, 1.25000, 1.37500, 1.50000, 1.62500,
+    1.75000, 1.87500, 2.00000, 2.12500, 2.25000, 2.37500, 2.50000, 2.62501,
+    2.74999, 2.87500, 2.99999, 3.12501, 3.24999, 3.37500, 3.50000, 3.62501,
+    3.75000, 3.87501, 3.99999, 4.12499, 4.25001, 4.37499, 4.50001, 4.62499,
+    4.75001, 4.87499, 5.00002, 5.12499, 5.25001, 5.37498, 5.50000, 5.62500,
+    5.75000, 5.87501, 6.00000, 6.12502, 6.24998, 6.37501, 6.49998, 6.62503,
+    6.74999, 6.87499, 7.00001, 7.12499, 7.25001, 7.37499, 7.50002, 7.62500,
+    7.74997, 7.87500, 8.00002, 8.12501, 8.24994, 8.37505, 8.49998, 8.62494,
+    8.75005, 8.87501, 8.99997, 9.11653, 9.20996, 9.27830, 9.32163, 9.33996,
+    9.34169, 9.34166, 9.34160, 9.34169, 9.34166, 9.34169, 9.34160, 9.34166,
+    9.34166, 9.34169, 9.34160, 9.34169, 9.34166, 9.34160, 9.34166, 9.34172,
+    9.34166, 9.34160, 9.34166, 9.34166, 9.34166, 9.34160, 9.34172, 9.34166,
+    9.34160, 9.34166, 9.34172, 9.34166, 9.34160, 9.34166, 9.34172, 9.34160,
+    9.34160, 9.34172, 9.34166, 9.34160, 9.34166, 9.34172, 9.34166, 9.34160,
+    9.34166, 9.34172, 9.34160, 9.34160, 9.34172, 9.34166, 9.34166, 9.34172,
+    9.34148, 9.34172, 9.34166, 9.34166, 9.34172, 9.34160, 9.34172, 9.34172,
+    9.34148, 9.34172, 9.34160, 9.34172, 9.34160, 9.34172, 9.34172, 9.34148,
+    9.34172, 9.34160, 9.34172, 9.34172, 9.34160, 9.34172, 9.34148, 9.34172,
+    9.34160, 9.34172, 9.34172, 9.34160, 9.34172, 9.34172, 9.34148, 9.34172,
+    9.34160, 9.34172, 9.34160, 9.34172, 9.34172, 9.34148, 9.34172, 9.34160,
+    9.33909, 9.31787, 9.27162, 9.20033, 9.10389, 8.98540, 8.86035, 8.73542,
+    8.61037, 8.48544, 8.36039, 8.23534, 8.11028, 7.98535, 7.86042, 7.73537,
+    7.61044, 7.48527, 7.36046, 7.23529, 7.11036, 6.98531, 6.86049, 6.73532,
+    6.61039, 6.48534, 6.36029, 6.23536, 6.11043, 5.98538, 5.86033, 5.73540,
+    5.61047, 5.48530, 5.36036, 5.23531, 5.11038, 4.98533, 4.86040, 4.73547,
+    4.61030, 4.48537, 4.36032, 4.23539, 4.11034, 3.98552, 3.86024, 3.73542,
+    3.61037, 3.48532, 3.36039, 3.23534, 3.11041, 2.98536, 2.86043, 2.73538,
+    2.61021, 2.48551, 2.36034, 2.23541, 2.11024, 1.98543, 1.86038, 1.73533,
+    1.61028, 1.48547, 1.36030, 1.23549, 1.11032, 0.98538, 0.86033, 0.73540,
+    0.61035, 0.48542, 0.36037, 0.24116, 0.14412, 0.07200, 0.02491, 0.00286,
+};
+
+static const float OMEGA_TURN180_020[860] = {
+    0.00039, 0.00275, 0.00746, 0.01452, 0.02394, 0.03572, 0.04985, 0.06634,
+    0.08518, 0.10638, 0.12993, 0.15584, 0.18405, 0.21344, 0.24288, 0.27232,
+    0.30176, 0.33120, 0.36064, 0.39008, 0.41952, 0.44896, 0.47840, 0.50784,
+    0.53728, 0.56672, 0.59616, 0.62560, 0.65504, 0.68448, 0.71392, 0.74336,
+    0.77280, 0.80224, 0.83168, 0.86112, 0.89056, 0.92000, 0.94944, 0.97888,
+    1.00832, 1.03776, 1.06720, 1.09664, 1.12608, 1.15552, 1.18496, 1.21440,
+    1.24384, 1.27328, 1.30272, 1.33216, 1.36160, 1.39104, 1.42048, 1.44992,
+    1.47935, 1.50880, 1.53824, 1.56768, 1.59713, 1.62655, 1.65601, 1.68544,
+    1.71487, 1.74432, 1.77377, 1.80320, 1.83263, 1.86208, 1.89152, 1.92095,
+    1.95041, 1.97984, 2.00928, 2.03870, 2.06817, 2.09760, 2.12704, 2.15647,
+    2.18592, 2.21538, 2.24477, 2.27426, 2.30367, 2.33313, 2.36256, 2.39199,
+    2.42145, 2.45088, 2.48031, 2.50977, 2.53920, 2.56863, 2.59808, 2.62753,
+    2.65697, 2.68638, 2.71586, 2.74529, 2.77472, 2.80415, 2.83360, 2.86305,
+    2.89246, 2.92194, 2.95135, 2.98081, 3.01021, 3.03969, 3.06913, 3.09856,
+    3.12798, 3.15745, 3.18688, 3.21631, 3.24576, 3.27522, 3.30463, 3.33408,
+    3.36353, 3.39296, 3.42241, 3.45182, 3.48128, 3.51073, 3.54016, 3.56960,
+    3.59900, 3.62849, 3.65792, 3.68737, 3.71680, 3.74626, 3.77570, 3.80512,
+    3.83452, 3.86399, 3.89346, 3.92285, 3.95235, 3.98177, 4.01121, 4.04060,
+    4.07007, 4.09952, 4.12899, 4.15838, 4.18785, 4.21730, 4.24668, 4.27616,
+    4.30563, 4.33505, 4.36407, 4.39116, 4.41587, 4.43822, 4.45816, 4.47586,
+    4.49118, 4.50408, 4.51469, 4.52289, 4.52879, 4.53222, 4.53350, 4.53356,
+    4.53356, 4.53353, 4.53356, 4.53356, 4.53347, 4.53356, 4.53356, 4.53353,
+    4.53356, 4.53356, 4.53356, 4.53353, 4.53350, 4.53353, 4.53356, 4.53356,
+    4.53353, 4.53356, 4.53356, 4.53347, 4.53356, 4.53356, 4.53353, 4.53356,
+    4.53356, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53359, 4.53353,
+    4.53359, 4.53353, 4.53347, 4.53359, 4.53353, 4.53353, 4.53359, 4.53353,
+    4.53359, 4.53341, 4.53359, 4.53353, 4.53359, 4.53353, 4.53353, 4.53359,
+    4.53347, 4.53353, 4.53359, 4.53353, 4.53353, 4.53359, 4.53353, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53359, 4.53359, 4.53353, 4.53347,
+    4.53359, 4.53353, 4.53353, 4.53353, 4.53359, 4.53353, 4.53347, 4.53353,
+    4.53359, 4.53359, 4.53353, 4.53353, 4.53353, 4.53359, 4.53347, 4.53353,
+    4.53353, 4.53359, 4.53347, 4.53365, 4.53347, 4.53359, 4.53353, 4.53359,
+    4.53347, 4.53353, 4.53359, 4.53347, 4.53365, 4.53347, 4.53359, 4.53353,
+    4.53347, 4.53359, 4.53353, 4.53359, 4.53347, 4.53365, 4.53347, 4.53359,
+    4.53353, 4.53347, 4.53359, 4.53353, 4.53359, 4.53347, 4.53365, 4.53347,
+    4.53347, 4.53365, 4.53347, 4.53365, 4.53347, 4.53359, 4.53353, 4.53347,
+    4.53359, 4.53347, 4.53365, 4.53347, 4.53365, 4.53347, 4.53347, 4.53365,
+    4.53347, 4.53359, 4.53353, 4.53359, 4.53347, 4.53347, 4.53365, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53365,
+    4.53341, 4.53377, 4.53341, 4.53365, 4.53353, 4.53341, 4.53365, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353,
+    4.53353, 4.53365, 4.53341, 4.53353, 4.53365, 4.53341, 4.53377, 4.53341,
+    4.53365, 4.53353, 4.53341, 4.53365, 4.53353, 4.53353, 4.53353, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53365, 4.53341,
+    4.53353, 4.53365, 4.53341, 4.53377, 4.53341, 4.53365, 4.53353, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53365, 4.53341,
+    4.53353, 4.53353, 4.53353, 4.53365, 4.53341, 4.53377, 4.53341, 4.53341,
+    4.53377, 4.53341, 4.53365, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353,
+    4.53377, 4.53329, 4.53377, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353, 4.53353,
+    4.53353, 4.53353, 4.53377, 4.53329, 4.53353, 4.53377, 4.53329, 4.53377,
+    4.53329, 4.53377, 4.53353, 4.53353, 4.53353, 4.53329, 4.53377, 4.53353,
+    4.53353, 4.53353, 4.53353, 4.53377, 4.53329, 4.53353, 4.53353, 4.53377,
+    4.53353, 4.53329, 4.53353, 4.53353, 4.53377, 4.53353, 4.53353, 4.53329,
+    4.53377, 4.53353, 4.53353, 4.53353, 4.53353, 4.53377, 4.53329, 4.53353,
+    4.53353, 4.53353, 4.53377, 4.53353, 4.53329, 4.53353, 4.53377, 4.53353,
+    4.53353, 4.53329, 4.53353, 4.53377, 4.53353, 4.53353, 4.53353, 4.53329,
+    4.53377, 4.53353, 4.53353, 4.53353, 4.53377, 4.53353, 4.53329, 4.53353,
+    4.53353, 4.53377, 4.53353, 4.53329, 4.53353, 4.53353, 4.53377, 4.53353,
+    4.53353, 4.53329, 4.53377, 4.53353, 4.53353, 4.53353, 4.53353, 4.53377,
+    4.53329, 4.53353, 4.53353, 4.53377, 4.53353, 4.53353, 4.53329, 4.53353,
+    4.53377, 4.53353, 4.53353, 4.53329, 4.53353, 4.53353, 4.53377, 4.53353,
+    4.53353, 4.53329, 4.53377, 4.53353, 4.53353, 4.53353, 4.53353, 4.53377,
+    4.53329, 4.53353, 4.53353, 4.53353, 4.53377, 4.53353, 4.53329, 4.53353,
+    4.53377, 4.53353, 4.53353, 4.53329, 4.53353, 4.53377, 4.53353, 4.53353,
+    4.53353, 4.53329, 4.53377, 4.53353, 4.53353, 4.53353, 4.53377, 4.53353,
+    4.53329, 4.53353, 4.53353, 4.53377, 4.53353, 4.53353, 4.53329, 4.53377,
+    4.53353, 4.53353, 4.53353, 4.53329, 4.53377, 4.53353, 4.53353, 4.53353,
+    4.53353, 4.53377, 4.53329, 4.53353, 4.53353, 4.53377, 4.53353, 4.53353,
+    4.53329, 4.53353, 4.53377, 4.53353, 4.53353, 4.53353, 4.53329, 4.53377,
+    4.53353, 4.53353, 4.53353, 4.53377, 4.53329, 4.53353, 4.53353, 4.53353,
+    4.53377, 4.53353, 4.53329, 4.53353, 4.53353, 4.53377, 4.53353, 4.53353,
+    4.53329, 4.53377, 4.53353, 4.53353, 4.53353, 4.53329, 4.53377, 4.53353,
+    4.53353, 4.53353, 4.53377, 4.53353, 4.53329, 4.53353, 4.53353, 4.53377,
+    4.53353, 4.53353, 4.53329, 4.53353, 4.53377, 4.53353, 4.53353, 4.53329,
+    4.53377, 4.53353, 4.53353, 4.53353, 4.53329, 4.53377, 4.53353, 4.53353,
+    4.53353, 4.53353, 4.53377, 4.53329, 4.53353, 4.53353, 4.53377, 4.53353,
+    4.53329, 4.53353, 4.53353, 4.53377, 4.53353, 4.53353, 4.53329, 4.53377,
+    4.53353, 4.53353, 4.53353, 4.53353, 4.53377, 4.53329, 4.53353, 4.53353,
+    4.53353, 4.53377, 4.53353, 4.53329, 4.53353, 4.53377, 4.53353, 4.53353,
+    4.53329, 4.53353, 4.53377, 4.53353, 4.53353, 4.53353, 4.53329, 4.53377,
+    4.53353, 4.53353, 4.53353, 4.53377, 4.53353, 4.53329, 4.53353, 4.53353,
+    4.53377, 4.53353, 4.53353, 4.53329, 4.53377, 4.53353, 4.53353, 4.53353,
+    4.53329, 4.53377, 4.53353, 4.53353, 4.53353, 4.53353, 4.53377, 4.53329,
+    4.53353, 4.53353, 4.53377, 4.53353, 4.53353, 4.53329, 4.53353, 4.53377,
+    4.53353, 4.53353, 4.53353, 4.53329, 4.53401, 4.53305, 4.53043, 4.52590,
+    4.51899, 4.50921, 4.49729, 4.48322, 4.46653, 4.44794, 4.42624, 4.40264,
+    4.37689, 4.34852, 4.31919, 4.28963, 4.26030, 4.23074, 4.20141, 4.17185,
+    4.14252, 4.11296, 4.08363, 4.05431, 4.02474, 3.99518, 3.96562, 3.93677,
+    3.90673, 3.87764, 3.84808, 3.81851, 3.78942, 3.75962, 3.73030, 3.70073,
+    3.67141, 3.64232, 3.61252, 3.58295, 3.55363, 3.52454, 3.49474, 3.46518,
+    3.43585, 3.40652, 3.37720, 3.34764, 3.31807, 3.28851, 3.25942, 3.22986,
+    3.20053, 3.17073, 3.14164, 3.11208, 3.08275, 3.05319, 3.02362, 2.99430,
+    2.96497, 2.93541, 2.90585, 2.87652, 2.84743, 2.81763, 2.78807, 2.75874,
+    2.72942, 2.70009, 2.67053, 2.64096, 2.61164, 2.58207, 2.55275, 2.52318,
+    2.49386, 2.46429, 2.43521, 2.40541, 2.37608, 2.34652, 2.31719, 2.28786,
+    2.25830, 2.22898, 2.19941, 2.16985, 2.14076, 2.11096, 2.08187, 2.05207,
+    2.02298, 1.99318, 1.96409, 1.93429, 1.90520, 1.87564, 1.84608, 1.81675,
+    1.78719, 1.75786, 1.72830, 1.69897, 1.66965, 1.64008, 1.61076, 1.58095,
+    1.55187, 1.52230, 1.49274, 1.46365, 1.43385, 1.40452, 1.37520, 1.34563,
+    1.31631, 1.28675, 1.25742, 1.22786, 1.19853, 1.16897, 1.13964, 1.11008,
+    1.08075, 1.05143, 1.02186, 0.99230, 0.96297, 0.93365, 0.90408, 0.87452,
+    0.84519, 0.81563, 0.78654, 0.75674, 0.72742, 0.69809, 0.66853, 0.63920,
+    0.60964, 0.58031, 0.55075, 0.52142, 0.49186, 0.46253, 0.43297, 0.40364,
+    0.37408, 0.34475, 0.31519, 0.28586, 0.25654, 0.22697, 0.19741, 0.16856,
+    0.14138, 0.11706, 0.09465, 0.07463, 0.05722, 0.04172, 0.02909, 0.01860,
+    0.01049, 0.00453, 0.00119, 0.00000,
+};
+
+static const float OMEGA_TURN180_030[573] = {
+    0.00132, 0.00927, 0.02517, 0.04902, 0.08081, 0.12056, 0.16825, 0.22389,
+    0.28709, 0.35328, 0.41952, 0.48576, 0.55200, 0.61824, 0.68448, 0.75072,
+    0.81696, 0.88320, 0.94944, 1.01568, 1.08192, 1.14816, 1.21440, 1.28064,
+    1.34688, 1.41312, 1.47936, 1.54560, 1.61184, 1.67808, 1.74432, 1.81056,
+    1.87680, 1.94304, 2.00928, 2.07552, 2.14177, 2.20799, 2.27425, 2.34048,
+    2.40673, 2.47296, 2.53921, 2.60543, 2.67168, 2.73792, 2.80415, 2.87040,
+    2.93664, 3.00288, 3.06913, 3.13536, 3.20159, 3.26785, 3.33408, 3.40033,
+    3.46655, 3.53279, 3.59906, 3.66527, 3.73153, 3.79775, 3.86402, 3.93024,
+    3.99646, 4.06273, 4.12896, 4.19521, 4.26142, 4.32768, 4.39394, 4.46014,
+    4.52639, 4.59266, 4.65888, 4.72510, 4.79138, 4.85760, 4.92387, 4.99006,
+    5.05631, 5.12260, 5.18876, 5.25504, 5.32131, 5.38752, 5.45374, 5.52002,
+    5.58624, 5.65250, 5.71869, 5.78497, 5.85121, 5.91740, 5.98371, 6.04993,
+    6.11615, 6.18237, 6.24865, 6.31487, 6.38115, 6.44734, 6.51354, 6.57675,
+    6.63227, 6.68001, 6.71968, 6.75145, 6.77520, 6.79111, 6.79901, 6.80032,
+    6.80029, 6.80032, 6.80032, 6.80026, 6.80032, 6.80032, 6.80032, 6.80029,
+    6.80032, 6.80032, 6.80032, 6.80026, 6.80032, 6.80035, 6.80029, 6.80035,
+    6.80020, 6.80032, 6.80035, 6.80029, 6.80035, 6.80029, 6.80035, 6.80035,
+    6.80017, 6.80035, 6.80029, 6.80035, 6.80029, 6.80035, 6.80035, 6.80017,
+    6.80035, 6.80029, 6.80035, 6.80029, 6.80035, 6.80035, 6.80017, 6.80035,
+    6.80035, 6.80029, 6.80029, 6.80035, 6.80035, 6.80029, 6.80023, 6.80035,
+    6.80029, 6.80029, 6.80035, 6.80035, 6.80029, 6.80023, 6.80035, 6.80029,
+    6.80029, 6.80035, 6.80035, 6.80029, 6.80023, 6.80035, 6.80029, 6.80029,
+    6.80035, 6.80035, 6.80029, 6.80035, 6.80023, 6.80029, 6.80029, 6.80035,
+    6.80035, 6.80029, 6.80035, 6.80023, 6.80029, 6.80035, 6.80029, 6.80035,
+    6.80029, 6.80035, 6.80023, 6.80029, 6.80035, 6.80029, 6.80035, 6.80029,
+    6.80035, 6.80029, 6.80023, 6.80029, 6.80041, 6.80029, 6.80029, 6.80041,
+    6.80017, 6.80029, 6.80029, 6.80041, 6.80029, 6.80029, 6.80041, 6.80029,
+    6.80017, 6.80029, 6.80041, 6.80029, 6.80029, 6.80041, 6.80029, 6.80029,
+    6.80017, 6.80041, 6.80029, 6.80029, 6.80041, 6.80029, 6.80029, 6.80017,
+    6.80041, 6.80029, 6.80029, 6.80041, 6.80029, 6.80029, 6.80017, 6.80041,
+    6.80029, 6.80029, 6.80041, 6.80029, 6.80029, 6.80041, 6.80017, 6.80029,
+    6.80029, 6.80041, 6.80017, 6.80041, 6.80017, 6.80041, 6.80029, 6.80041,
+    6.80029, 6.80017, 6.80041, 6.80017, 6.80041, 6.80041, 6.80041, 6.80017,
+    6.80017, 6.80041, 6.80017, 6.80041, 6.80041, 6.80041, 6.80017, 6.80041,
+    6.80017, 6.80017, 6.80041, 6.80041, 6.80041, 6.80017, 6.80041, 6.80017,
+    6.80017, 6.80041, 6.80041, 6.80041, 6.80017, 6.80041, 6.80017, 6.80017,
+    6.80041, 6.80041, 6.80041, 6.80017, 6.80041, 6.80017, 6.80017, 6.80041,
+    6.80041, 6.80041, 6.80017, 6.80041, 6.80017, 6.80017, 6.80041, 6.80041,
+    6.80041, 6.80017, 6.80041, 6.80017, 6.80017, 6.80041, 6.80041, 6.80041,
+    6.80017, 6.80041, 6.80017, 6.80041, 6.80017, 6.80041, 6.80041, 6.80017,
+    6.80041, 6.80017, 6.80041, 6.80017, 6.80041, 6.80041, 6.80017, 6.80041,
+    6.80017, 6.80041, 6.80017, 6.80041, 6.80041, 6.80017, 6.80041, 6.80017,
+    6.80041, 6.80017, 6.80041, 6.80041, 6.80017, 6.80041, 6.80017, 6.80041,
+    6.80017, 6.80041, 6.80041, 6.80017, 6.80041, 6.80017, 6.80041, 6.80041,
+    6.80017, 6.80041, 6.80017, 6.80041, 6.80017, 6.80041, 6.80041, 6.80041,
+    6.79994, 6.80041, 6.80041, 6.80041, 6.80017, 6.80017, 6.80065, 6.80017,
+    6.80017, 6.80041, 6.80017, 6.80065, 6.80017, 6.80017, 6.80017, 6.80041,
+    6.80041, 6.80041, 6.80017, 6.80017, 6.80065, 6.80017, 6.80017, 6.80041,
+    6.80017, 6.80065, 6.80017, 6.80017, 6.80017, 6.80041, 6.80065, 6.80017,
+    6.80017, 6.80017, 6.80065, 6.80017, 6.80017, 6.80041, 6.80017, 6.80065,
+    6.80017, 6.80017, 6.80017, 6.80065, 6.80041, 6.80017, 6.80017, 6.80017,
+    6.80065, 6.80017, 6.80017, 6.80017, 6.80041, 6.80065, 6.80017, 6.80017,
+    6.80017, 6.80065, 6.80017, 6.80041, 6.80017, 6.80017, 6.80065, 6.80017,
+    6.80017, 6.80017, 6.80041, 6.80065, 6.80017, 6.80017, 6.80017, 6.80065,
+    6.80017, 6.80041, 6.80017, 6.80017, 6.80065, 6.80017, 6.80017, 6.80041,
+    6.80041, 6.80041, 6.80017, 6.80017, 6.80017, 6.80065, 6.80017, 6.80041,
+    6.80017, 6.80017, 6.80065, 6.80017, 6.80017, 6.80041, 6.80041, 6.80041,
+    6.80017, 6.80017, 6.80017, 6.80065, 6.80017, 6.80041, 6.79874, 6.79064,
+    6.77514, 6.75058, 6.71864, 6.67858, 6.63114, 6.57511, 6.51169, 6.44541,
+    6.37937, 6.31332, 6.24681, 6.18052, 6.11424, 6.04796, 5.98216, 5.91564,
+    5.84936, 5.78308, 5.71704, 5.65076, 5.58424, 5.51820, 5.45192, 5.38588,
+    5.31936, 5.25308, 5.18703, 5.12099, 5.05447, 4.98819, 4.92191, 4.85587,
+    4.78983, 4.72307, 4.65703, 4.59075, 4.52471, 4.45819, 4.39239, 4.32587,
+    4.25959, 4.19331, 4.12726, 4.06098, 3.99446, 3.92842, 3.86214, 3.79610,
+    3.72982, 3.66330, 3.59726, 3.53098, 3.46494, 3.39842, 3.33214, 3.26610,
+    3.19982, 3.13354, 3.06726, 3.00121, 2.93469, 2.86865, 2.80237, 2.73609,
+    2.66981, 2.60377, 2.53749, 2.47097, 2.40493, 2.33865, 2.27261, 2.20609,
+    2.14005, 2.07353, 2.00748, 1.94144, 1.87492, 1.80864, 1.74260, 1.67632,
+    1.61004, 1.54376, 1.47748, 1.41144, 1.34492, 1.27888, 1.21260, 1.14632,
+    1.08027, 1.01376, 0.94771, 0.88143, 0.81515, 0.74887, 0.68259, 0.61655,
+    0.55027, 0.48375, 0.41771, 0.35167, 0.28515, 0.22221, 0.16689, 0.11945,
+    0.07987, 0.04816, 0.02480, 0.00882, 0.00119,
+};
+
+static const float OMEGA_TURN180_040[430] = {
+    0.00314, 0.02198, 0.05967, 0.11619, 0.19156, 0.28576, 0.39749, 0.51520,
+    0.63296, 0.75072, 0.86848, 0.98624, 1.10400, 1.22176, 1.33952, 1.45728,
+    1.57504, 1.69280, 1.81056, 1.92832, 2.04608, 2.16384, 2.28160, 2.39936,
+    2.51712, 2.63488, 2.75264, 2.87040, 2.98816, 3.10592, 3.22368, 3.34145,
+    3.45919, 3.57698, 3.69471, 3.81247, 3.93025, 4.04798, 4.16577, 4.28352,
+    4.40130, 4.51903, 4.63680, 4.75455, 4.87233, 4.99007, 5.10783, 5.22561,
+    5.34335, 5.46114, 5.57886, 5.69665, 5.81440, 5.93217, 6.04990, 6.16770,
+    6.28543, 6.40319, 6.52097, 6.63871, 6.75650, 6.87423, 6.99201, 7.10976,
+    7.22750, 7.34529, 7.46305, 7.58082, 7.69851, 7.81631, 7.93412, 8.05181,
+    8.16959, 8.28737, 8.40515, 8.52284, 8.64068, 8.75524, 8.85409, 8.93402,
+    8.99527, 9.03758, 9.06101, 9.06706, 9.06709, 9.06712, 9.06703, 9.06709,
+    9.06712, 9.06709, 9.06703, 9.06712, 9.06709, 9.06703, 9.06712, 9.06709,
+    9.06709, 9.06706, 9.06706, 9.06712, 9.06712, 9.06706, 9.06706, 9.06712,
+    9.06700, 9.06712, 9.06712, 9.06712, 9.06700, 9.06712, 9.06712, 9.06706,
+    9.06706, 9.06706, 9.06718, 9.06700, 9.06712, 9.06706, 9.06712, 9.06700,
+    9.06718, 9.06706, 9.06712, 9.06700, 9.06712, 9.06712, 9.06706, 9.06712,
+    9.06700, 9.06706, 9.06712, 9.06712, 9.06706, 9.06712, 9.06712, 9.06706,
+    9.06700, 9.06712, 9.06706, 9.06712, 9.06712, 9.06712, 9.06706, 9.06700,
+    9.06706, 9.06712, 9.06712, 9.06712, 9.06706, 9.06712, 9.06694, 9.06718,
+    9.06706, 9.06706, 9.06706, 9.06718, 9.06718, 9.06706, 9.06694, 9.06718,
+    9.06706, 9.06706, 9.06706, 9.06706, 9.06718, 9.06694, 9.06706, 9.06718,
+    9.06718, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706,
+    9.06718, 9.06718, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706,
+    9.06706, 9.06718, 9.06718, 9.06682, 9.06718, 9.06718, 9.06706, 9.06706,
+    9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06730, 9.06706, 9.06706,
+    9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06730, 9.06706,
+    9.06706, 9.06706, 9.06682, 9.06730, 9.06706, 9.06730, 9.06682, 9.06730,
+    9.06682, 9.06706, 9.06730, 9.06682, 9.06730, 9.06706, 9.06730, 9.06682,
+    9.06706, 9.06730, 9.06682, 9.06730, 9.06682, 9.06730, 9.06706, 9.06682,
+    9.06730, 9.06706, 9.06730, 9.06682, 9.06730, 9.06682, 9.06706, 9.06730,
+    9.06682, 9.06730, 9.06706, 9.06730, 9.06682, 9.06730, 9.06706, 9.06682,
+    9.06730, 9.06682, 9.06706, 9.06730, 9.06682, 9.06730, 9.06706, 9.06730,
+    9.06682, 9.06706, 9.06730, 9.06682, 9.06730, 9.06682, 9.06730, 9.06706,
+    9.06682, 9.06730, 9.06706, 9.06730, 9.06682, 9.06730, 9.06706, 9.06706,
+    9.06706, 9.06682, 9.06730, 9.06706, 9.06730, 9.06682, 9.06730, 9.06706,
+    9.06682, 9.06730, 9.06706, 9.06706, 9.06706, 9.06730, 9.06682, 9.06706,
+    9.06730, 9.06682, 9.06730, 9.06706, 9.06706, 9.06706, 9.06682, 9.06730,
+    9.06706, 9.06730, 9.06682, 9.06730, 9.06706, 9.06682, 9.06730, 9.06682,
+    9.06730, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06730,
+    9.06682, 9.06730, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06706,
+    9.06730, 9.06682, 9.06730, 9.06706, 9.06682, 9.06730, 9.06706, 9.06706,
+    9.06706, 9.06730, 9.06682, 9.06706, 9.06730, 9.06682, 9.06730, 9.06706,
+    9.06706, 9.06706, 9.06706, 9.06706, 9.06706, 9.06730, 9.06682, 9.06730,
+    9.06706, 9.06682, 9.06706, 9.05633, 9.02820, 8.98051, 8.91447, 8.82888,
+    8.72540, 8.60882, 8.49104, 8.37326, 8.25548, 8.13794, 8.01992, 7.90238,
+    7.78437, 7.66659, 7.54905, 7.43103, 7.31373, 7.19547, 7.07817, 6.95992,
+    6.84237, 6.72483, 6.60658, 6.48928, 6.37126, 6.25372, 6.13594, 6.01792,
+    5.90038, 5.78237, 5.66506, 5.54681, 5.42951, 5.31149, 5.19371, 5.07593,
+    4.95815, 4.84061, 4.72260, 4.60505, 4.48728, 4.36926, 4.25172, 4.13394,
+    4.01616, 3.89838, 3.78084, 3.66282, 3.54505, 3.42727, 3.30973, 3.19171,
+    3.07417, 2.95639, 2.83837, 2.72083, 2.60305, 2.48528, 2.36750, 2.24972,
+    2.13218, 2.01416, 1.89662, 1.77860, 1.66082, 1.54328, 1.42550, 1.30773,
+    1.18995, 1.07217, 0.95439, 0.83661, 0.71883, 0.60105, 0.48351, 0.36597,
+    0.25845, 0.16928, 0.09894, 0.04768, 0.01502, 0.00119,
+};
+
+static const float OMEGA_TURN180_050[344] = {
+    0.00613, 0.04293, 0.11653, 0.22693, 0.37413, 0.55200, 0.73600, 0.92000,
+    1.10400, 1.28800, 1.47200, 1.65600, 1.84000, 2.02400, 2.20800, 2.39200,
+    2.57600, 2.75999, 2.94400, 3.12800, 3.31200, 3.49601, 3.67999, 3.86401,
+    4.04799, 4.23201, 4.41599, 4.60001, 4.78398, 4.96800, 5.15201, 5.33601,
+    5.51999, 5.70402, 5.88799, 6.07199, 6.25601, 6.43999, 6.62402, 6.80798,
+    6.99201, 7.17598, 7.36003, 7.54398, 7.72801, 7.91199, 8.09598, 8.28001,
+    8.46401, 8.64802, 8.83196, 9.01604, 9.19996, 9.38404, 9.56796, 9.75204,
+    9.93598, 10.12000, 10.30400, 10.48797, 10.67200, 10.85559, 11.02349, 11.15584,
+    11.25136, 11.31019, 11.33257, 11.33385, 11.33379, 11.33388, 11.33388, 11.33379,
+    11.33388, 11.33385, 11.33388, 11.33379, 11.33388, 11.33388, 11.33388, 11.33376,
+    11.33388, 11.33388, 11.33376, 11.33388, 11.33388, 11.33388, 11.33382, 11.33382,
+    11.33388, 11.33388, 11.33382, 11.33382, 11.33394, 11.33376, 11.33388, 11.33382,
+    11.33394, 11.33376, 11.33388, 11.33382, 11.33394, 11.33376, 11.33388, 11.33388,
+    11.33376, 11.33388, 11.33388, 11.33388, 11.33376, 11.33388, 11.33388, 11.33388,
+    11.33376, 11.33388, 11.33388, 11.33382, 11.33388, 11.33382, 11.33388, 11.33382,
+    11.33388, 11.33388, 11.33382, 11.33382, 11.33394, 11.33382, 11.33382, 11.33394,
+    11.33370, 11.33382, 11.33382, 11.33394, 11.33394, 11.33382, 11.33382, 11.33394,
+    11.33370, 11.33394, 11.33370, 11.33394, 11.33394, 11.33382, 11.33382, 11.33370,
+    11.33394, 11.33394, 11.33382, 11.33382, 11.33394, 11.33382, 11.33370, 11.33382,
+    11.33394, 11.33394, 11.33370, 11.33394, 11.33394, 11.33394, 11.33370, 11.33370,
+    11.33394, 11.33394, 11.33394, 11.33370, 11.33394, 11.33370, 11.33394, 11.33370,
+    11.33394, 11.33394, 11.33394, 11.33370, 11.33370, 11.33394, 11.33394, 11.33370,
+    11.33394, 11.33394, 11.33394, 11.33370, 11.33370, 11.33394, 11.33394, 11.33394,
+    11.33370, 11.33394, 11.33394, 11.33370, 11.33370, 11.33394, 11.33394, 11.33394,
+    11.33370, 11.33394, 11.33370, 11.33394, 11.33370, 11.33394, 11.33394, 11.33394,
+    11.33370, 11.33394, 11.33370, 11.33394, 11.33394, 11.33370, 11.33394, 11.33394,
+    11.33370, 11.33370, 11.33394, 11.33394, 11.33394, 11.33370, 11.33394, 11.33394,
+    11.33370, 11.33370, 11.33394, 11.33394, 11.33394, 11.33370, 11.33394, 11.33394,
+    11.33370, 11.33394, 11.33370, 11.33394, 11.33394, 11.33370, 11.33394, 11.33370,
+    11.33394, 11.33394, 11.33370, 11.33394, 11.33394, 11.33370, 11.33370, 11.33394,
+    11.33394, 11.33394, 11.33370, 11.33394, 11.33394, 11.33370, 11.33370, 11.33394,
+    11.33394, 11.33370, 11.33370, 11.33418, 11.33370, 11.33394, 11.33370, 11.33418,
+    11.33370, 11.33370, 11.33394, 11.33370, 11.33418, 11.33370, 11.33394, 11.33370,
+    11.33370, 11.33418, 11.33370, 11.33394, 11.33370, 11.33394, 11.33370, 11.33418,
+    11.33370, 11.33370, 11.33394, 11.33370, 11.33418, 11.33037, 11.30080, 11.23357,
+    11.13033, 10.99014, 10.81586, 10.63251, 10.44798, 10.26440, 10.08010, 9.89604,
+    9.71246, 9.52792, 9.34434, 9.16028, 8.97622, 8.79216, 8.60810, 8.42428,
+    8.23998, 8.05640, 7.87210, 7.68828, 7.50422, 7.31993, 7.13634, 6.95205,
+    6.76847, 6.58417, 6.40035, 6.21605, 6.03199, 5.84841, 5.66411, 5.48029,
+    5.29599, 5.11241, 4.92811, 4.74429, 4.56023, 4.37617, 4.19211, 4.00805,
+    3.82447, 3.64017, 3.45612, 3.27206, 3.08824, 2.90442, 2.72012, 2.53606,
+    2.35224, 2.16818, 1.98412, 1.80030, 1.61624, 1.43218, 1.24812, 1.06430,
+    0.88024, 0.69594, 0.51236, 0.33927, 0.19979, 0.09751, 0.03195, 0.00286,
+};
+
+static const float OMEGA_TURN45_020[266] = {
+    0.00083, 0.00583, 0.01583, 0.03083, 0.05083, 0.07583, 0.10583, 0.14083,
+    0.18083, 0.22583, 0.27500, 0.32500, 0.37500, 0.42500, 0.47500, 0.52500,
+    0.57500, 0.62500, 0.67500, 0.72500, 0.77500, 0.82500, 0.87500, 0.92500,
+    0.97500, 1.02500, 1.07500, 1.12500, 1.17500, 1.22500, 1.27500, 1.32500,
+    1.37500, 1.42500, 1.47500, 1.52500, 1.57500, 1.62500, 1.67500, 1.72500,
+    1.77501, 1.82499, 1.87500, 1.92500, 1.97501, 2.02499, 2.07501, 2.12500,
+    2.17499, 2.22501, 2.27500, 2.32501, 2.37498, 2.42501, 2.47501, 2.52500,
+    2.57499, 2.62500, 2.67500, 2.72498, 2.77501, 2.82501, 2.87500, 2.92501,
+    2.97499, 3.02500, 3.07500, 3.12500, 3.17499, 3.22500, 3.27501, 3.32499,
+    3.37501, 3.42500, 3.47501, 3.52497, 3.57501, 3.62501, 3.67501, 3.72498,
+    3.77500, 3.82502, 3.87497, 3.92501, 3.97500, 4.02501, 4.07498, 4.12501,
+    4.17501, 4.22500, 4.27498, 4.32500, 4.37501, 4.42497, 4.47501, 4.52502,
+    4.57501, 4.62496, 4.67502, 4.72501, 4.77500, 4.82497, 4.87477, 4.92139,
+    4.96304, 4.99970, 5.03141, 5.05805, 5.07966, 5.09638, 5.10806, 5.11470,
+    5.11658, 5.11664, 5.11664, 5.11661, 5.11664, 5.11664, 5.11664, 5.11661,
+    5.11664, 5.11664, 5.11664, 5.11661, 5.11664, 5.11664, 5.11664, 5.11664,
+    5.11655, 5.11664, 5.11667, 5.11664, 5.11664, 5.11664, 5.11664, 5.11664,
+    5.11655, 5.11664, 5.11664, 5.11667, 5.11664, 5.11664, 5.11664, 5.11655,
+    5.11664, 5.11664, 5.11664, 5.11667, 5.11664, 5.11664, 5.11655, 5.11664,
+    5.11664, 5.11658, 5.11390, 5.10645, 5.09387, 5.07647, 5.05382, 5.02640,
+    4.99392, 4.95636, 4.91393, 4.86648, 4.81659, 4.76652, 4.71658, 4.66663,
+    4.61656, 4.56661, 4.51660, 4.46659, 4.41653, 4.36658, 4.31663, 4.26656,
+    4.21661, 4.16660, 4.11654, 4.06659, 4.01658, 3.96657, 3.91656, 3.86661,
+    3.81660, 3.76660, 3.71659, 3.66652, 3.61663, 3.56656, 3.51661, 3.46655,
+    3.41660, 3.36665, 3.31652, 3.26657, 3.21662, 3.16656, 3.11661, 3.06654,
+    3.01659, 2.96664, 2.91651, 2.86657, 2.81662, 2.76655, 2.71666, 2.66659,
+    2.61652, 2.56658, 2.51663, 2.46656, 2.41661, 2.36654, 2.31659, 2.26665,
+    2.21652, 2.16657, 2.11662, 2.06661, 2.01654, 1.96660, 1.91659, 1.86658,
+    1.81657, 1.76662, 1.71655, 1.66661, 1.61660, 1.56659, 1.51652, 1.46663,
+    1.41656, 1.36662, 1.31655, 1.26660, 1.21653, 1.16658, 1.11657, 1.06663,
+    1.01656, 0.96661, 0.91660, 0.86659, 0.81652, 0.76663, 0.71657, 0.66656,
+    0.61661, 0.56660, 0.51659, 0.46653, 0.41664, 0.36657, 0.31656, 0.26661,
+    0.21791, 0.17375, 0.13459, 0.10043, 0.07129, 0.04709, 0.02801, 0.01377,
+    0.00465, 0.00048,
+};
+
+static const float OMEGA_TURN45_030[178] = {
+    0.00281, 0.01969, 0.05344, 0.10406, 0.17156, 0.25594, 0.35708, 0.46875,
+    0.58125, 0.69375, 0.80625, 0.91875, 1.03125, 1.14375, 1.25625, 1.36875,
+    1.48125, 1.59375, 1.70625, 1.81875, 1.93125, 2.04375, 2.15625, 2.26875,
+    2.38125, 2.49374, 2.60626, 2.71874, 2.83125, 2.94375, 3.05625, 3.16876,
+    3.28124, 3.39376, 3.50624, 3.61874, 3.73126, 3.84374, 3.95627, 4.06874,
+    4.18125, 4.29375, 4.40626, 4.51874, 4.63126, 4.74375, 4.85624, 4.96876,
+    5.08124, 5.19376, 5.30624, 5.41876, 5.53124, 5.64375, 5.75626, 5.86876,
+    5.98124, 6.09374, 6.20624, 6.31875, 6.43128, 6.54373, 6.65627, 6.76876,
+    6.88119, 6.99377, 7.10626, 7.21876, 7.32991, 7.42927, 7.51176, 7.57733,
+    7.62615, 7.65798, 7.67300, 7.67490, 7.67499, 7.67496, 7.67496, 7.67490,
+    7.67496, 7.67496, 7.67490, 7.67499, 7.67496, 7.67496, 7.67490, 7.67496,
+    7.67496, 7.67496, 7.67493, 7.67493, 7.67499, 7.67490, 7.67496, 7.67496,
+    7.67496, 7.67493, 7.67493, 7.67499, 7.67496, 7.67490, 7.67416, 7.66271,
+    7.63458, 7.58964, 7.52771, 7.44897, 7.35331, 7.24363, 7.13116, 7.01863,
+    6.90609, 6.79362, 6.68114, 6.56861, 6.45614, 6.34360, 6.23119, 6.11860,
+    6.00612, 5.89365, 5.78111, 5.66858, 5.55617, 5.44363, 5.33116, 5.21863,
+    5.10603, 4.99368, 4.88114, 4.76861, 4.65614, 4.54360, 4.43113, 4.31871,
+    4.20600, 4.09365, 3.98117, 3.86858, 3.75617, 3.64363, 3.53110, 3.41862,
+    3.30609, 3.19368, 3.08114, 2.96861, 2.85608, 2.74372, 2.63107, 2.51859,
+    2.40612, 2.29365, 2.18117, 2.06864, 1.95611, 1.84363, 1.73110, 1.61862,
+    1.50609, 1.39368, 1.28114, 1.16861, 1.05613, 0.94360, 0.83113, 0.71865,
+    0.60612, 0.49365, 0.38135, 0.27686, 0.18877, 0.11754, 0.06318, 0.02569,
+    0.00507, 0.00006,
+};
+
+static const float OMEGA_TURN45_040[133] = {
+    0.00667, 0.04667, 0.12667, 0.24667, 0.40667, 0.60000, 0.80000, 1.00000,
+    1.20000, 1.40000, 1.60000, 1.80000, 2.00000, 2.20000, 2.40000, 2.60000,
+    2.80000, 3.00000, 3.20000, 3.40000, 3.60000, 3.80000, 3.99999, 4.20001,
+    4.40000, 4.60001, 4.79999, 5.00001, 5.19999, 5.39999, 5.60002, 5.80001,
+    5.99999, 6.20001, 6.39999, 6.59999, 6.80001, 6.99998, 7.20002, 7.39999,
+    7.60002, 7.79998, 8.00002, 8.19999, 8.40001, 8.59998, 8.79998, 9.00003,
+    9.19998, 9.40003, 9.59997, 9.79616, 9.96274, 10.08946, 10.17603, 10.22276,
+    10.23322, 10.23325, 10.23328, 10.23325, 10.23328, 10.23325, 10.23328, 10.23328,
+    10.23319, 10.23331, 10.23328, 10.23328, 10.23319, 10.23331, 10.23328, 10.23319,
+    10.23328, 10.23331, 10.23328, 10.23319, 10.23322, 10.22035, 10.17034, 10.08022,
+    9.95028, 9.78041, 9.58312, 9.38320, 9.18317, 8.98319, 8.78310, 8.58319,
+    8.38321, 8.18312, 7.98315, 7.78317, 7.58320, 7.38311, 7.18319, 6.98316,
+    6.78325, 6.58309, 6.38318, 6.18315, 5.98323, 5.78308, 5.58317, 5.38325,
+    5.18310, 4.98319, 4.78315, 4.58324, 4.38309, 4.18323, 3.98314, 3.78317,
+    3.58319, 3.38316, 3.18319, 2.98315, 2.78318, 2.58315, 2.38311, 2.18320,
+    1.98317, 1.78319, 1.58316, 1.38313, 1.18321, 0.98312, 0.78321, 0.58317,
+    0.39166, 0.23502, 0.11837, 0.04178, 0.00513,
+};
+
+static const float OMEGA_TURN135_020[481] = {
+    0.00083, 0.00583, 0.01583, 0.03083, 0.05083, 0.07583, 0.10583, 0.14083,
+    0.18083, 0.22583, 0.27500, 0.32500, 0.37500, 0.42500, 0.47500, 0.52500,
+    0.57500, 0.62500, 0.67500, 0.72500, 0.77500, 0.82500, 0.87500, 0.92500,
+    0.97500, 1.02500, 1.07500, 1.12500, 1.17500, 1.22500, 1.27500, 1.32500,
+    1.37500, 1.42500, 1.47500, 1.52500, 1.57500, 1.62500, 1.67500, 1.72500,
+    1.77501, 1.82499, 1.87500, 1.92500, 1.97501, 2.02499, 2.07501, 2.12500,
+    2.17499, 2.22501, 2.27500, 2.32501, 2.37498, 2.42501, 2.47501, 2.52500,
+    2.57499, 2.62500, 2.67500, 2.72498, 2.77501, 2.82501, 2.87500, 2.92501,
+    2.97499, 3.02500, 3.07500, 3.12500, 3.17499, 3.22500, 3.27501, 3.32499,
+    3.37501, 3.42500, 3.47501, 3.52497, 3.57501, 3.62501, 3.67501, 3.72498,
+    3.77500, 3.82502, 3.87497, 3.92501, 3.97500, 4.02501, 4.07498, 4.12501,
+    4.17501, 4.22500, 4.27498, 4.32500, 4.37501, 4.42497, 4.47501, 4.52502,
+    4.57501, 4.62496, 4.67502, 4.72501, 4.77500, 4.82497, 4.87502, 4.92501,
+    4.97496, 5.02503, 5.07501, 5.12499, 5.17499, 5.22500, 5.27501, 5.32502,
+    5.37497, 5.42501, 5.47501, 5.52493, 5.57503, 5.62504, 5.67499, 5.72500,
+    5.77500, 5.82501, 5.87499, 5.92497, 5.97501, 6.02505, 6.07500, 6.12503,
+    6.17489, 6.22502, 6.27503, 6.32498, 6.37504, 6.42499, 6.47497, 6.52504,
+    6.57487, 6.62506, 6.67498, 6.72504, 6.77499, 6.82500, 6.87504, 6.92490,
+    6.97500, 7.02330, 7.06685, 7.10553, 7.13909, 7.16770, 7.19118, 7.20990,
+    7.22349, 7.23207, 7.23571, 7.23606, 7.23600, 7.23606, 7.23588, 7.23606,
+    7.23600, 7.23600, 7.23606, 7.23600, 7.23606, 7.23588, 7.23600, 7.23606,
+    7.23600, 7.23606, 7.23600, 7.23600, 7.23594, 7.23606, 7.23600, 7.23600,
+    7.23600, 7.23606, 7.23600, 7.23606, 7.23588, 7.23606, 7.23600, 7.23606,
+    7.23600, 7.23600, 7.23606, 7.23588, 7.23606, 7.23600, 7.23600, 7.23606,
+    7.23600, 7.23606, 7.23588, 7.23600, 7.23606, 7.23606, 7.23600, 7.23600,
+    7.23600, 7.23606, 7.23594, 7.23600, 7.23600, 7.23600, 7.23606, 7.23606,
+    7.23600, 7.23588, 7.23606, 7.23600, 7.23606, 7.23600, 7.23600, 7.23600,
+    7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23612, 7.23600, 7.23600,
+    7.23588, 7.23600, 7.23600, 7.23612, 7.23600, 7.23612, 7.23600, 7.23588,
+    7.23600, 7.23600, 7.23612, 7.23600, 7.23600, 7.23600, 7.23588, 7.23612,
+    7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23600,
+    7.23600, 7.23600, 7.23600, 7.23612, 7.23588, 7.23624, 7.23577, 7.23624,
+    7.23588, 7.23588, 7.23624, 7.23577, 7.23624, 7.23588, 7.23612, 7.23600,
+    7.23577, 7.23624, 7.23588, 7.23612, 7.23600, 7.23600, 7.23600, 7.23612,
+    7.23588, 7.23600, 7.23600, 7.23600, 7.23612, 7.23588, 7.23624, 7.23577,
+    7.23600, 7.23612, 7.23588, 7.23624, 7.23588, 7.23612, 7.23588, 7.23588,
+    7.23624, 7.23588, 7.23612, 7.23588, 7.23612, 7.23600, 7.23577, 7.23624,
+    7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23600,
+    7.23600, 7.23600, 7.23624, 7.23577, 7.23600, 7.23600, 7.23600, 7.23624,
+    7.23577, 7.23624, 7.23600, 7.23600, 7.23600, 7.23577, 7.23624, 7.23600,
+    7.23600, 7.23600, 7.23600, 7.23600, 7.23600, 7.23612, 7.23374, 7.22706,
+    7.21502, 7.19833, 7.17616, 7.14934, 7.11751, 7.08055, 7.03883, 6.99174,
+    6.94215, 6.89197, 6.84190, 6.79219, 6.74188, 6.69217, 6.64198, 6.59215,
+    6.54197, 6.49190, 6.44219, 6.39200, 6.34205, 6.29199, 6.24216, 6.19197,
+    6.14202, 6.09207, 6.04200, 5.99217, 5.94199, 5.89204, 5.84197, 5.79214,
+    5.74207, 5.69177, 5.64218, 5.59211, 5.54204, 5.49197, 5.44214, 5.39207,
+    5.34201, 5.29194, 5.24211, 5.19204, 5.14197, 5.09214, 5.04208, 4.99177,
+    4.94218, 4.89211, 4.84204, 4.79198, 4.74215, 4.69208, 4.64177, 4.59218,
+    4.54211, 4.49204, 4.44198, 4.39215, 4.34184, 4.29201, 4.24218, 4.19188,
+    4.14228, 4.09198, 4.04215, 3.99184, 3.94225, 3.89194, 3.84188, 3.79205,
+    3.74198, 3.69215, 3.64208, 3.59201, 3.54195, 3.49212, 3.44205, 3.39222,
+    3.34191, 3.29185, 3.24225, 3.19195, 3.14212, 3.09205, 3.04198, 2.99215,
+    2.94209, 2.89178, 2.84219, 2.79188, 2.74229, 2.69175, 2.64215, 2.59209,
+    2.54202, 2.49219, 2.44188, 2.39205, 2.34199, 2.29216, 2.24185, 2.19202,
+    2.14219, 2.09188, 2.04229, 1.99199, 1.94192, 1.89209, 1.84226, 1.79195,
+    1.74189, 1.69206, 1.64199, 1.59216, 1.54209, 1.49202, 1.44196, 1.39213,
+    1.34206, 1.29175, 1.24216, 1.19209, 1.14202, 1.09196, 1.04213, 0.99206,
+    0.94199, 0.89192, 0.84209, 0.79203, 0.74196, 0.69237, 0.64182, 0.59223,
+    0.54193, 0.49210, 0.44203, 0.39196, 0.34213, 0.29182, 0.24247, 0.19574,
+    0.15378, 0.11730, 0.08535, 0.05889, 0.03719, 0.02027, 0.00858, 0.00215,
+    0.00000,
+};
+
+static const float OMEGA_TURN135_030[321] = {
+    0.00281, 0.01969, 0.05344, 0.10406, 0.17156, 0.25594, 0.35708, 0.46875,
+    0.58125, 0.69375, 0.80625, 0.91875, 1.03125, 1.14375, 1.25625, 1.36875,
+    1.48125, 1.59375, 1.70625, 1.81875, 1.93125, 2.04375, 2.15625, 2.26875,
+    2.38125, 2.49374, 2.60626, 2.71874, 2.83125, 2.94375, 3.05625, 3.16876,
+    3.28124, 3.39376, 3.50624, 3.61874, 3.73126, 3.84374, 3.95627, 4.06874,
+    4.18125, 4.29375, 4.40626, 4.51874, 4.63126, 4.74375, 4.85624, 4.96876,
+    5.08124, 5.19376, 5.30624, 5.41876, 5.53124, 5.64375, 5.75626, 5.86876,
+    5.98124, 6.09374, 6.20624, 6.31875, 6.43128, 6.54373, 6.65627, 6.76876,
+    6.88119, 6.99377, 7.10626, 7.21876, 7.33124, 7.44374, 7.55629, 7.66870,
+    7.78127, 7.89374, 8.00628, 8.11872, 8.23125, 8.34376, 8.45629, 8.56870,
+    8.68127, 8.79377, 8.90622, 9.01872, 9.13128, 9.24376, 9.35620, 9.46876,
+    9.58127, 9.69377, 9.80622, 9.91875, 10.03131, 10.14370, 10.25626, 10.36876,
+    10.48088, 10.58424, 10.67114, 10.74111, 10.79422, 10.83040, 10.84977, 10.85406,
+    10.85395, 10.85406, 10.85401, 10.85406, 10.85395, 10.85406, 10.85401, 10.85406,
+    10.85395, 10.85406, 10.85401, 10.85395, 10.85406, 10.85406, 10.85401, 10.85401,
+    10.85401, 10.85401, 10.85406, 10.85395, 10.85406, 10.85406, 10.85401, 10.85406,
+    10.85383, 10.85413, 10.85401, 10.85401, 10.85406, 10.85406, 10.85401, 10.85406,
+    10.85383, 10.85413, 10.85401, 10.85401, 10.85406, 10.85406, 10.85401, 10.85389,
+    10.85401, 10.85413, 10.85401, 10.85401, 10.85413, 10.85401, 10.85389, 10.85401,
+    10.85413, 10.85401, 10.85401, 10.85401, 10.85401, 10.85413, 10.85389, 10.85401,
+    10.85401, 10.85401, 10.85413, 10.85413, 10.85401, 10.85377, 10.85413, 10.85401,
+    10.85413, 10.85401, 10.85401, 10.85401, 10.85401, 10.85401, 10.85401, 10.85401,
+    10.85401, 10.85401, 10.85413, 10.85413, 10.85377, 10.85401, 10.85413, 10.85401,
+    10.85413, 10.85401, 10.85401, 10.85389, 10.85413, 10.85401, 10.85401, 10.85401,
+    10.85401, 10.85413, 10.85389, 10.85401, 10.85401, 10.85401, 10.85401, 10.85424,
+    10.85401, 10.85401, 10.85377, 10.85424, 10.85401, 10.85401, 10.85401, 10.85401,
+    10.85401, 10.85401, 10.85401, 10.85401, 10.85401, 10.85401, 10.85401, 10.85424,
+    10.85377, 10.85186, 10.83636, 10.80394, 10.75470, 10.68854, 10.60545, 10.50568,
+    10.39422, 10.28180, 10.16927, 10.05685, 9.94432, 9.83191, 9.71925, 9.60672,
+    9.49430, 9.38189, 9.26924, 9.15694, 9.04429, 8.93176, 8.81934, 8.70681,
+    8.59427, 8.48174, 8.36945, 8.25667, 8.14438, 8.03185, 7.91931, 7.80678,
+    7.69424, 7.58195, 7.46918, 7.35688, 7.24411, 7.13205, 7.01928, 6.90675,
+    6.79445, 6.68168, 6.56939, 6.45661, 6.34456, 6.23155, 6.11949, 6.00672,
+    5.89442, 5.78189, 5.66912, 5.55682, 5.44429, 5.33199, 5.21922, 5.10693,
+    4.99415, 4.88186, 4.76933, 4.65679, 4.54450, 4.43172, 4.31919, 4.20690,
+    4.09412, 3.98183, 3.86930, 3.75700, 3.64423, 3.53193, 3.41916, 3.30687,
+    3.19433, 3.08156, 2.96950, 2.85673, 2.74444, 2.63166, 2.51937, 2.40684,
+    2.29430, 2.18177, 2.06947, 1.95670, 1.84417, 1.73187, 1.61934, 1.50681,
+    1.39427, 1.28174, 1.16944, 1.05691, 0.94414, 0.83208, 0.71907, 0.60701,
+    0.49424, 0.38195, 0.27752, 0.18930, 0.11778, 0.06366, 0.02575, 0.00525,
+    0.00000,
+};
+
+static const float OMEGA_TURN135_040[241] = {
+    0.00667, 0.04667, 0.12667, 0.24667, 0.40667, 0.60000, 0.80000, 1.00000,
+    1.20000, 1.40000, 1.60000, 1.80000, 2.00000, 2.20000, 2.40000, 2.60000,
+    2.80000, 3.00000, 3.20000, 3.40000, 3.60000, 3.80000, 3.99999, 4.20001,
+    4.40000, 4.60001, 4.79999, 5.00001, 5.19999, 5.39999, 5.60002, 5.80001,
+    5.99999, 6.20001, 6.39999, 6.59999, 6.80001, 6.99998, 7.20002, 7.39999,
+    7.60002, 7.79998, 8.00002, 8.19999, 8.40001, 8.59998, 8.79998, 9.00003,
+    9.19998, 9.40003, 9.59997, 9.80003, 9.99999, 10.19999, 10.40000, 10.60003,
+    10.79997, 10.99995, 11.20007, 11.39998, 11.60002, 11.79996, 12.00005, 12.20003,
+    12.39991, 12.60000, 12.80004, 13.00001, 13.19993, 13.40002, 13.59999, 13.79994,
+    13.99830, 14.17237, 14.30678, 14.40108, 14.45556, 14.47177, 14.47207, 14.47195,
+    14.47201, 14.47207, 14.47195, 14.47207, 14.47207, 14.47201, 14.47201, 14.47201,
+    14.47207, 14.47207, 14.47195, 14.47207, 14.47201, 14.47195, 14.47207, 14.47207,
+    14.47207, 14.47189, 14.47213, 14.47201, 14.47207, 14.47195, 14.47201, 14.47213,
+    14.47189, 14.47207, 14.47207, 14.47201, 14.47201, 14.47201, 14.47213, 14.47201,
+    14.47189, 14.47213, 14.47213, 14.47189, 14.47201, 14.47213, 14.47201, 14.47201,
+    14.47201, 14.47201, 14.47201, 14.47201, 14.47201, 14.47213, 14.47213, 14.47201,
+    14.47177, 14.47201, 14.47213, 14.47213, 14.47201, 14.47201, 14.47201, 14.47213,
+    14.47189, 14.47201, 14.47201, 14.47201, 14.47213, 14.47213, 14.47201, 14.47177,
+    14.47213, 14.47201, 14.47213, 14.47201, 14.47201, 14.47201, 14.47201, 14.47201,
+    14.47201, 14.47201, 14.47201, 14.47225, 14.47201, 14.47201, 14.47177, 14.47225,
+    14.47201, 14.47201, 14.47213, 14.46080, 14.41336, 14.32550, 14.19806, 14.03058,
+    13.83412, 13.63409, 13.43405, 13.23414, 13.03387, 12.83419, 12.63404, 12.43412,
+    12.23409, 12.03418, 11.83403, 11.63411, 11.43384, 11.23428, 11.03401, 10.83422,
+    10.63395, 10.43415, 10.23412, 10.03385, 9.83429, 9.63402, 9.43422, 9.23395,
+    9.03416, 8.83412, 8.63385, 8.43406, 8.23426, 8.03399, 7.83420, 7.63392,
+    7.43413, 7.23410, 7.03406, 6.83427, 6.63376, 6.43420, 6.23417, 6.03414,
+    5.83386, 5.63407, 5.43404, 5.23424, 5.03421, 4.83394, 4.63414, 4.43387,
+    4.23408, 4.03428, 3.83401, 3.63421, 3.43394, 3.23415, 3.03411, 2.83408,
+    2.63381, 2.43425, 2.23398, 2.03419, 1.83392, 1.63412, 1.43433, 1.23405,
+    1.03402, 0.83399, 0.63396, 0.43821, 0.27108, 0.14424, 0.05746, 0.01073,
+    0.00000,
+};
+
+static const float OMEGA_V90_020[372] = {
+    0.00083, 0.00583, 0.01583, 0.03083, 0.05083, 0.07583, 0.10583, 0.14083,
+    0.18083, 0.22583, 0.27500, 0.32500, 0.37500, 0.42500, 0.47500, 0.52500,
+    0.57500, 0.62500, 0.67500, 0.72500, 0.77500, 0.82500, 0.87500, 0.92500,
+    0.97500, 1.02500, 1.07500, 1.12500, 1.17500, 1.22500, 1.27500, 1.32500,
+    1.37500, 1.42500, 1.47500, 1.52500, 1.57500, 1.62500, 1.67500, 1.72500,
+    1.77501, 1.82499, 1.87500, 1.92500, 1.97501, 2.02499, 2.07501, 2.12500,
+    2.17499, 2.22501, 2.27500, 2.32501, 2.37498, 2.42501, 2.47501, 2.52500,
+    2.57499, 2.62500, 2.67500, 2.72498, 2.77501, 2.82501, 2.87500, 2.92501,
+    2.97499, 3.02500, 3.07500, 3.12500, 3.17499, 3.22500, 3.27501, 3.32499,
+    3.37501, 3.42500, 3.47501, 3.52497, 3.57501, 3.62501, 3.67501, 3.72498,
+    3.77500, 3.82502, 3.87497, 3.92501, 3.97500, 4.02501, 4.07498, 4.12501,
+    4.17501, 4.22500, 4.27498, 4.32500, 4.37501, 4.42497, 4.47501, 4.52502,
+    4.57501, 4.62496, 4.67502, 4.72501, 4.77500, 4.82497, 4.87502, 4.92501,
+    4.97496, 5.02503, 5.07501, 5.12499, 5.17499, 5.22500, 5.27501, 5.32502,
+    5.37497, 5.42501, 5.47501, 5.52493, 5.57503, 5.62504, 5.67499, 5.72500,
+    5.77500, 5.82501, 5.87499, 5.92497, 5.97501, 6.02505, 6.07500, 6.12503,
+    6.17489, 6.22502, 6.27503, 6.32498, 6.37504, 6.42499, 6.47497, 6.52504,
+    6.57487, 6.62506, 6.67498, 6.72504, 6.77499, 6.82500, 6.87504, 6.92490,
+    6.97500, 7.02330, 7.06685, 7.10553, 7.13909, 7.16770, 7.19118, 7.20990,
+    7.22349, 7.23207, 7.23571, 7.23606, 7.23600, 7.23606, 7.23588, 7.23606,
+    7.23600, 7.23600, 7.23606, 7.23600, 7.23606, 7.23588, 7.23600, 7.23606,
+    7.23600, 7.23606, 7.23600, 7.23600, 7.23594, 7.23606, 7.23600, 7.23600,
+    7.23600, 7.23606, 7.23600, 7.23606, 7.23588, 7.23606, 7.23600, 7.23606,
+    7.23600, 7.23600, 7.23606, 7.23588, 7.23606, 7.23600, 7.23600, 7.23606,
+    7.23600, 7.23606, 7.23588, 7.23600, 7.23606, 7.23606, 7.23600, 7.23600,
+    7.23600, 7.23606, 7.23594, 7.23600, 7.23600, 7.23600, 7.23606, 7.23606,
+    7.23600, 7.23588, 7.23606, 7.23600, 7.23606, 7.23600, 7.23600, 7.23600,
+    7.23600, 7.23541, 7.23076, 7.22110, 7.20668, 7.18689, 7.16245, 7.13277,
+    7.09808, 7.05862, 7.01404, 6.96504, 6.91497, 6.86502, 6.81508, 6.76501,
+    6.71506, 6.66499, 6.61504, 6.56497, 6.51515, 6.46508, 6.41489, 6.36506,
+    6.31499, 6.26504, 6.21510, 6.16503, 6.11508, 6.06501, 6.01494, 5.96499,
+    5.91505, 5.86510, 5.81491, 5.76520, 5.71489, 5.66518, 5.61500, 5.56505,
+    5.51498, 5.46491, 5.41520, 5.36489, 5.31518, 5.26500, 5.21505, 5.16510,
+    5.11491, 5.06508, 5.01490, 4.96519, 4.91500, 4.86505, 4.81498, 4.76515,
+    4.71497, 4.66490, 4.61519, 4.56488, 4.51517, 4.46498, 4.41515, 4.36497,
+    4.31490, 4.26507, 4.21500, 4.16517, 4.11499, 4.06504, 4.01509, 3.96490,
+    3.91507, 3.86500, 3.81517, 3.76487, 3.71516, 3.66497, 3.61502, 3.56507,
+    3.51501, 3.46506, 3.41499, 3.36504, 3.31497, 3.26502, 3.21507, 3.16501,
+    3.11506, 3.06511, 3.01504, 2.96497, 2.91491, 2.86508, 2.81501, 2.76518,
+    2.71487, 2.66516, 2.61497, 2.56503, 2.51508, 2.46501, 2.41506, 2.36499,
+    2.31504, 2.26498, 2.21515, 2.16496, 2.11501, 2.06506, 2.01499, 1.96517,
+    1.91498, 1.86503, 1.81496, 1.76501, 1.71506, 1.66500, 1.61517, 1.56498,
+    1.51503, 1.46508, 1.41490, 1.36507, 1.31512, 1.26505, 1.21498, 1.16503,
+    1.11496, 1.06502, 1.01507, 0.96500, 0.91505, 0.86510, 0.81503, 0.76497,
+    0.71502, 0.66507, 0.61500, 0.56505, 0.51510, 0.46504, 0.41497, 0.36502,
+    0.31519, 0.26500, 0.21636, 0.17262, 0.13340, 0.09942, 0.07045, 0.04649,
+    0.02742, 0.01335, 0.00453, 0.00048,
+};
+
+static const float OMEGA_V90_030[248] = {
+    0.00281, 0.01969, 0.05344, 0.10406, 0.17156, 0.25594, 0.35708, 0.46875,
+    0.58125, 0.69375, 0.80625, 0.91875, 1.03125, 1.14375, 1.25625, 1.36875,
+    1.48125, 1.59375, 1.70625, 1.81875, 1.93125, 2.04375, 2.15625, 2.26875,
+    2.38125, 2.49374, 2.60626, 2.71874, 2.83125, 2.94375, 3.05625, 3.16876,
+    3.28124, 3.39376, 3.50624, 3.61874, 3.73126, 3.84374, 3.95627, 4.06874,
+    4.18125, 4.29375, 4.40626, 4.51874, 4.63126, 4.74375, 4.85624, 4.96876,
+    5.08124, 5.19376, 5.30624, 5.41876, 5.53124, 5.64375, 5.75626, 5.86876,
+    5.98124, 6.09374, 6.20624, 6.31875, 6.43128, 6.54373, 6.65627, 6.76876,
+    6.88119, 6.99377, 7.10626, 7.21876, 7.33124, 7.44374, 7.55629, 7.66870,
+    7.78127, 7.89374, 8.00628, 8.11872, 8.23125, 8.34376, 8.45629, 8.56870,
+    8.68127, 8.79377, 8.90622, 9.01872, 9.13128, 9.24376, 9.35620, 9.46876,
+    9.58127, 9.69377, 9.80622, 9.91875, 10.03131, 10.14370, 10.25626, 10.36876,
+    10.48088, 10.58424, 10.67114, 10.74111, 10.79422, 10.83040, 10.84977, 10.85406,
+    10.85395, 10.85406, 10.85401, 10.85406, 10.85395, 10.85406, 10.85401, 10.85406,
+    10.85395, 10.85406, 10.85401, 10.85395, 10.85406, 10.85406, 10.85401, 10.85401,
+    10.85401, 10.85401, 10.85406, 10.85395, 10.85406, 10.85406, 10.85401, 10.85406,
+    10.85383, 10.85413, 10.85401, 10.85401, 10.85406, 10.85406, 10.85401, 10.85406,
+    10.85383, 10.85413, 10.85401, 10.85401, 10.85406, 10.85406, 10.85401, 10.85389,
+    10.85401, 10.84816, 10.82659, 10.78820, 10.73277, 10.66053, 10.57136, 10.46622,
+    10.35380, 10.24127, 10.12886, 10.01632, 9.90379, 9.79137, 9.67860, 9.56631,
+    9.45389, 9.34124, 9.22883, 9.11629, 9.00388, 8.89122, 8.77881, 8.66628,
+    8.55386, 8.44133, 8.32868, 8.21638, 8.10373, 7.99131, 7.87878, 7.76637,
+    7.65371, 7.54142, 7.42877, 7.31623, 7.20382, 7.09128, 6.97875, 6.86634,
+    6.75380, 6.64139, 6.52874, 6.41620, 6.30391, 6.19125, 6.07884, 5.96631,
+    5.85377, 5.74136, 5.62871, 5.51629, 5.40376, 5.29134, 5.17881, 5.06628,
+    4.95386, 4.84133, 4.72867, 4.61638, 4.50385, 4.39131, 4.27878, 4.16625,
+    4.05383, 3.94130, 3.82876, 3.71623, 3.60394, 3.49116, 3.37887, 3.26633,
+    3.15380, 3.04127, 2.92885, 2.81620, 2.70379, 2.59137, 2.47884, 2.36630,
+    2.25377, 2.14124, 2.02882, 1.91629, 1.80387, 1.69134, 1.57869, 1.46616,
+    1.35398, 1.24133, 1.12867, 1.01638, 0.90373, 0.79131, 0.67878, 0.56636,
+    0.45383, 0.34261, 0.24390, 0.16153, 0.09644, 0.04792, 0.01645, 0.00191,
+};
+
+static const float OMEGA_V90_040[186] = {
+    0.00667, 0.04667, 0.12667, 0.24667, 0.40667, 0.60000, 0.80000, 1.00000,
+    1.20000, 1.40000, 1.60000, 1.80000, 2.00000, 2.20000, 2.40000, 2.60000,
+    2.80000, 3.00000, 3.20000, 3.40000, 3.60000, 3.80000, 3.99999, 4.20001,
+    4.40000, 4.60001, 4.79999, 5.00001, 5.19999, 5.39999, 5.60002, 5.80001,
+    5.99999, 6.20001, 6.39999, 6.59999, 6.80001, 6.99998, 7.20002, 7.39999,
+    7.60002, 7.79998, 8.00002, 8.19999, 8.40001, 8.59998, 8.79998, 9.00003,
+    9.19998, 9.40003, 9.59997, 9.80003, 9.99999, 10.19999, 10.40000, 10.60003,
+    10.79997, 10.99995, 11.20007, 11.39998, 11.60002, 11.79996, 12.00005, 12.20003,
+    12.39991, 12.60000, 12.80004, 13.00001, 13.19993, 13.40002, 13.59999, 13.79994,
+    13.99830, 14.17237, 14.30678, 14.40108, 14.45556, 14.47177, 14.47207, 14.47195,
+    14.47201, 14.47207, 14.47195, 14.47207, 14.47207, 14.47201, 14.47201, 14.47201,
+    14.47207, 14.47207, 14.47195, 14.47207, 14.47201, 14.47195, 14.47207, 14.47207,
+    14.47207, 14.47189, 14.47213, 14.47201, 14.47207, 14.47195, 14.47201, 14.47213,
+    14.47189, 14.47207, 14.47207, 14.47201, 14.47141, 14.45186, 14.39357, 14.29522,
+    14.15670, 13.97908, 13.78000, 13.58008, 13.38005, 13.18002, 12.98022, 12.77995,
+    12.58004, 12.38012, 12.18009, 11.97994, 11.78014, 11.58011, 11.38008, 11.18004,
+    10.97989, 10.78010, 10.58018, 10.38015, 10.18000, 9.98008, 9.78005, 9.58014,
+    9.37986, 9.18007, 8.98015, 8.78012, 8.57997, 8.38017, 8.18002, 7.97999,
+    7.78008, 7.58004, 7.38013, 7.18009, 6.98006, 6.78003, 6.58000, 6.38008,
+    6.18017, 5.98001, 5.77998, 5.58019, 5.38003, 5.18000, 4.98009, 4.78005,
+    4.58002, 4.38011, 4.18007, 3.98016, 3.78001, 3.57997, 3.38006, 3.18015,
+    2.98011, 2.77996, 2.58017, 2.38001, 2.17998, 1.98007, 1.78015, 1.58000,
+    1.38009, 1.18005, 0.98014, 0.77999, 0.58019, 0.38898, 0.23282, 0.11694,
+    0.04077, 0.00501,
+};
+
+const t_slalom_table SLALOM_TABLES[] = {
+    {&SEARCH_SLALOM, 0.20, 295, OMEGA_SEARCH_020},
+    {&FAST_TURNS[FAST_TURN_SMALL90], 0.20, 372, OMEGA_SMALL90_020},
+    {&FAST_TURNS[FAST_TURN_SMALL90], 0.30, 248, OMEGA_SMALL90_030},
+    {&FAST_TURNS[FAST_TURN_SMALL90], 0.40, 186, OMEGA_SMALL90_040},
+    {&FAST_TURNS[FAST_TURN_LARGE90], 0.20, 744, OMEGA_LARGE90_020},
+    {&FAST_TURNS[FAST_TURN_LARGE90], 0.30, 496, OMEGA_LARGE90_030},
+    {&FAST_TURNS[FAST_TURN_LARGE90], 0.40, 372, OMEGA_LARGE90_040},
+    {&FAST_TURNS[FAST_TURN_LARGE90], 0.50, 298, OMEGA_LARGE90_050},
+    {&FAST_TURNS[FAST_TURN_LARGE90], 0.60, 248, OMEGA_LARGE90_060},
+    {&FAST_TURNS[FAST_TURN_180], 0.20, 860, OMEGA_TURN180_020},
+    {&FAST_TURNS[FAST_TURN_180], 0.30, 573, OMEGA_TURN180_030},
+    {&FAST_TURNS[FAST_TURN_180], 0.40, 430, OMEGA_TURN180_040},
+    {&FAST_TURNS[FAST_TURN_180], 0.50, 344, OMEGA_TURN180_050},
+    {&FAST_TURNS[FAST_TURN_45], 0.20, 266, OMEGA_TURN45_020},
+    {&FAST_TURNS[FAST_TURN_45], 0.30, 178, OMEGA_TURN45_030},
+    {&FAST_TURNS[FAST_TURN_45], 0.40, 133, OMEGA_TURN45_040},
+    {&FAST_TURNS[FAST_TURN_135], 0.20, 481, OMEGA_TURN135_020},
+    {&FAST_TURNS[FAST_TURN_135], 0.30, 321, OMEGA_TURN135_030},
+    {&FAST_TURNS[FAST_TURN_135], 0.40, 241, OMEGA_TURN135_040},
+    {&FAST_TURNS[FAST_TURN_V90], 0.20, 372, OMEGA_V90_020},
+    {&FAST_TURNS[FAST_TURN_V90], 0.30, 248, OMEGA_V90_030},
+    {&FAST_TURNS[FAST_TURN_V90], 0.40, 186, OMEGA_V90_040},
+};
+
+const int SLALOM_TABLE_NUM = sizeof(SLALOM_TABLES) / sizeof(SLALOM_TABLES[0]);
@@ -0,0 +1,364 @@
+#include <math.h>
+#include <stdio.h>
+
+#include "trajectory.h"
+#include "variables.h"
+#include "parameters.h"
+
+#define LOG_LOCAL_LEVEL ESP_LOG_INFO
+#include "esp_log.h"
+static const char *TAG="Trajectory";
+
+// 走行の軌跡と所要時間の見積もり
+// ハードウェアを使わないので、maze.cの経路探索やホストのシミュレータからも使える
+
+// 探索走行用のスラローム
+// 区画の境界から、隣の区画の境界まで曲がる
+// 直進速度は呼び出し側のendSpeedを使うので、speedは見積もり用の探索速度
+// 加減速角度2つと低速角度の和が90度になるようにし、checkSearchSlalom()で出口を確かめること
+const t_slalom SEARCH_SLALOM = {0.2, 8, 100, 0.0093, 0.0093,
+    15.0 * M_PI / 180.0, 60.0 * M_PI / 180.0, 0.045, 0.045};
+
+// 最短走行用のターンの一覧
+// 入口と出口の位置は区画の中心線上にあるように、オフセット距離を決めている
+// 角速度はslalomCurve()のS字加減速で変えるので、ジャークを変えたらcheckFastTurn()で確かめること
+// 形を変えたら、角速度の表(slalom_table.c)もhost/gen_slalom_table.cで作り直すこと
+// 斜めに入る(IN)ターンと斜めから出る(OUT)ターンは、前後のオフセット距離を入れ替えて使う
+const t_slalom FAST_TURNS[FAST_TURN_NUM] = {
+    // 小回り90度: 区画の入口から出口まで
+    [FAST_TURN_SMALL90] = {0.4, 15, 200, 0.00076, 0.00076,
+        30.0 * M_PI / 180.0, 30.0 * M_PI / 180.0, 0.045, 0.045},
+    // 大回り90度: 前の区画の中心から次の区画の中心まで
+    [FAST_TURN_LARGE90] = {0.6, 15, 125, 0.00064, 0.00064,
+        20.0 * M_PI / 180.0, 50.0 * M_PI / 180.0, 0.090, 0.090},
+    // 180度: 区画の入口から、隣の区画の出口まで
+    [FAST_TURN_180] = {0.5, 15, 184, 0.002, 0.0024,
+        20.0 * M_PI / 180.0, 140.0 * M_PI / 180.0, 0.0, 0.090},
+    // 45度: 前の区画の中心から、斜めの通過点(区画の境界の中点)まで
+    [FAST_TURN_45] = {0.4, 15, 200, 0.0174, 0.0361,
+        15.0 * M_PI / 180.0, 15.0 * M_PI / 180.0, 0.090, 0.045},
+    // 135度: 区画の入口から、隣の区画の先にある斜めの通過点まで
+    [FAST_TURN_135] = {0.4, 15, 200, 0.0049, 0.0422,
+        30.0 * M_PI / 180.0, 75.0 * M_PI / 180.0, 0.0, 0.090},
+    // V90度: 斜めの通過点から、1区画横の斜めの通過点まで
+    [FAST_TURN_V90] = {0.4, 15, 200, 0.0194, 0.0194,
+        30.0 * M_PI / 180.0, 30.0 * M_PI / 180.0, 0.0636396, 0.0636396},
+};
+
+// スラロームの角速度の表を作る直進速度(遅い順)
+// 最短走行のターンはこのどれかの速度で走るので、表の速度と同じ軌跡で曲がれる
+// 表の速度(t_slalom.speed)もこのどれかにすること
+const float SLALOM_SPEEDS[SLALOM_SPEED_NUM] = {0.2, 0.3, 0.4, 0.5, 0.6};
+
+static float changeTime(const float deltaSpeed, const float accel, const float jerk,
+        float *jerkTime){
+    // 速度をdeltaSpeedだけ変える時間と、そのうち加速度を変えている時間(jerkTime)を求める
+    // 加速度は0から上げて、上限で保ち、0まで下げる
+    if(deltaSpeed <= 0){
+        *jerkTime = 0;
+        return 0;
+    }
+    if(deltaSpeed >= accel * accel / jerk){
+        *jerkTime = accel / jerk;
+        return deltaSpeed / accel + accel / jerk;
+    }
+    // 加速度が上限に届く前に速度が変わりきる
+    *jerkTime = sqrtf(deltaSpeed / jerk);
+    return 2.0 * *jerkTime;
+}
+
+static float changeDistance(const float speed1, const float speed2,
+        const float accel, const float jerk){
+    // 速度の変化は前後対称なので、進む距離は平均の速度×時間になる
+    float jerkTime;
+    return (speed1 + speed2) * 0.5 * changeTime(fabsf(speed2 - speed1), accel, jerk, &jerkTime);
+}
+
+static void sampleChange(const t_scurve *curve, const float startSpeed, const float endSpeed,
+        const float time, float *position, float *speed, float *accel){
+    // 速度をstartSpeedからendSpeedに変え始めてから、時刻timeの位置、速度、加速度を求める
+    const float jerk = curve->jerk;
+    const float sign = (endSpeed >= startSpeed) ? 1.0 : -1.0;
+    float jerkTime;
+    float totalTime = changeTime(fabsf(endSpeed - startSpeed), curve->accel, jerk, &jerkTime);
+    float peakAccel = jerk * jerkTime;
+
+    if(time < jerkTime){
+        // 加速度を上げる
+        *accel = sign * jerk * time;
+        *speed = startSpeed + sign * jerk * time * time * 0.5;
+        *position = startSpeed * time + sign * jerk * time * time * time / 6.0;
+    }else if(time < totalTime - jerkTime){
+        // 加速度を保つ
+        float t = time - jerkTime;
+        float speed1 = startSpeed + sign * jerk * jerkTime * jerkTime * 0.5;
+        float position1 = startSpeed * jerkTime + sign * jerk * jerkTime * jerkTime * jerkTime / 6.0;
+        *accel = sign * peakAccel;
+        *speed = speed1 + sign * peakAccel * t;
+        *position = position1 + speed1 * t + sign * peakAccel * t * t * 0.5;
+    }else{
+        // 加速度を下げる 終わりから見ると、加速度を上げるときと対称になる
+        float t = totalTime - time;
+        *accel = sign * jerk * t;
+        *speed = endSpeed - sign * jerk * t * t * 0.5;
+        *position = (startSpeed + endSpeed) * 0.5 * totalTime
+            - (endSpeed * t - sign * jerk * t * t * t / 6.0);
+    }
+}
+
+void scurvePlan(t_scurve *curve, const float distance, const float startSpeed,
+        const float endSpeed, const float maxSpeed, const float accel, const float jerk){
+    // 距離distanceを、startSpeedから始めてendSpeedで終わるS字加減速を作る
+    // 距離が短くて最高速度まで加速できないときは、届く速度を二分法で探す
+    // 距離が短すぎてendSpeedまで減速しきれないときは、距離をはみ出す
+    float lowSpeed = fmaxf(startSpeed, endSpeed);
+    float peakSpeed = fmaxf(maxSpeed, lowSpeed);
+    if(changeDistance(startSpeed, peakSpeed, accel, jerk)
+            + changeDistance(peakSpeed, endSpeed, accel, jerk) > distance){
+        float highSpeed = peakSpeed;
+        for(int i=0; i<32; i++){
+            float speed = (lowSpeed + highSpeed) * 0.5;
+            if(changeDistance(startSpeed, speed, accel, jerk)
+                    + changeDistance(speed, endSpeed, accel, jerk) > distance){
+                highSpeed = speed;
+            }else{
+                lowSpeed = speed;
+            }
+        }
+        peakSpeed = lowSpeed;
+    }
+
+    float jerkTime;
+    curve->distance = distance;
+    curve->startSpeed = startSpeed;
+    curve->peakSpeed = peakSpeed;
+    curve->endSpeed = endSpeed;
+    curve->accel = accel;
+    curve->jerk = jerk;
+    curve->accelTime = changeTime(peakSpeed - startSpeed, accel, jerk, &jerkTime);
+    curve->decelTime = changeTime(peakSpeed - endSpeed, accel, jerk, &jerkTime);
+    float cruiseDistance = distance - changeDistance(startSpeed, peakSpeed, accel, jerk)
+        - changeDistance(peakSpeed, endSpeed, accel, jerk);
+    curve->cruiseTime = 0;
+    if(cruiseDistance > 0 && peakSpeed > 0){
+        curve->cruiseTime = cruiseDistance / peakSpeed;
+    }
+    curve->time = curve->accelTime + curve->cruiseTime + curve->decelTime;
+}
+
+void scurveSample(const t_scurve *curve, const float time,
+        float *position, float *speed, float *accel){
+    // 走り始めてから時刻timeの目標位置、目標速度、目標加速度を求める
+    // 終わったあとはendSpeedのまま進む
+    float t = fmaxf(time, 0);
+    float accelDistance = (curve->startSpeed + curve->peakSpeed) * 0.5 * curve->accelTime;
+    float cruiseDistance = curve->peakSpeed * curve->cruiseTime;
+    float decelDistance = (curve->peakSpeed + curve->endSpeed) * 0.5 * curve->decelTime;
+
+    if(t < curve->accelTime){
+        sampleChange(curve, curve->startSpeed, curve->peakSpeed, t, position, speed, accel);
+        return;
+    }
+    t -= curve->accelTime;
+    if(t < curve->cruiseTime){
+        *position = accelDistance + curve->peakSpeed * t;
+        *speed = curve->peakSpeed;
+        *accel = 0;
+        return;
+    }
+    t -= curve->cruiseTime;
+    if(t < curve->decelTime){
+        sampleChange(curve, curve->peakSpeed, curve->endSpeed, t, position, speed, accel);
+        *position += accelDistance + cruiseDistance;
+        return;
+    }
+    t -= curve->decelTime;
+    *position = accelDistance + cruiseDistance + decelDistance + curve->endSpeed * t;
+    *speed = curve->endSpeed;
+    *accel = 0;
+}
+
+void slalomCurve(t_scurve *curve, const t_slalom *slalom, const float speed){
+    // slalomの角速度のS字加減速を作る
+    // 表の速度より遅いときは、角速度を速度に、角加速度を速度の2乗に、
+    // ジャークを速度の3乗に比例させると軌跡の形が変わらない
+    float ratio = 1.0;
+    if(speed > 0 && speed < slalom->speed){
+        ratio = speed / slalom->speed;
+    }
+    float accel = slalom->accelDecel * ratio * ratio;
+    float jerk = accel * ratio / pSLALOM_JERK_TIME;
+    float maxOmega = fminf(sqrtf(2.0 * slalom->accelDecel * slalom->accelDecelAngle),
+            slalom->maxOmega) * ratio;
+    float turnAngle = 2.0 * slalom->accelDecelAngle + slalom->keepOmegaAngle;
+    scurvePlan(curve, turnAngle, 0, 0, maxOmega, accel, jerk);
+}
+
+float slalomTableOmega(const t_scurve *curve, const int tick){
+    // slalomCurve()で作ったcurveの、tick番目の制御周期の間の平均の角速度を返す
+    // slalom_table.cの表を作るときと、表が古くないか確かめるときに使う
+    float startAngle, endAngle, omega, alpha;
+    scurveSample(curve, tick * SLALOM_TABLE_PERIOD, &startAngle, &omega, &alpha);
+    scurveSample(curve, (tick + 1) * SLALOM_TABLE_PERIOD, &endAngle, &omega, &alpha);
+    return (endAngle - startAngle) / SLALOM_TABLE_PERIOD;
+}
+
+float slalomSpeedClass(const float speed){
+    // speed以下で一番速い、表のある直進速度を返す
+    // 一番遅い表の速度より遅ければ、speedをそのまま返す
+    const float MARGIN = 0.0001; // m/s 計算誤差で1つ下の速度にならないように
+    float classSpeed = speed;
+    for(int speed_i=0; speed_i<SLALOM_SPEED_NUM; speed_i++){
+        if(SLALOM_SPEEDS[speed_i] <= speed + MARGIN){
+            classSpeed = SLALOM_SPEEDS[speed_i];
+        }
+    }
+    return classSpeed;
+}
+
+float straightTime(const float distance, const float startSpeed, const float endSpeed,
+        const float maxSpeed, const float accel){
+    // straight()の所要時間を見積もる
+    if(distance <= 0){
+        return 0;
+    }
+    t_scurve curve;
+    scurvePlan(&curve, distance, startSpeed, endSpeed, maxSpeed, accel, accel / pJERK_TIME);
+    return curve.time;
+}
+
+float straightReachSpeed(const float distance, const float startSpeed, const float accel){
+    // straight()で、startSpeedから距離distanceのうちに加速しきれる速度を求める
+    // 減速しきれる速度を求めるときは、終端速度をstartSpeedとして逆向きに使う
+    const float jerk = accel / pJERK_TIME;
+    float lowSpeed = startSpeed;
+    float highSpeed = sqrtf(startSpeed * startSpeed + 2.0 * accel * distance); // 台形のとき
+    for(int i=0; i<32; i++){
+        float speed = (lowSpeed + highSpeed) * 0.5;
+        if(changeDistance(startSpeed, speed, accel, jerk) > distance){
+            highSpeed = speed;
+        }else{
+            lowSpeed = speed;
+        }
+    }
+    return lowSpeed;
+}
+
+float turnTime(const float targetAngle){
+    // turn()の所要時間を見積もる
+    // turn()のパラメータと合わせること
+    const float MAX_OMEGA= 8; // rad/s
+    const float ACCEL = 100; // rad/s^2
+
+    t_scurve curve;
+    scurvePlan(&curve, fabs(targetAngle), 0, 0, MAX_OMEGA, ACCEL, ACCEL / pJERK_TIME);
+    return curve.time;
+}
+
+float slalomTime(const t_slalom *slalom, const float speed){
+    // queueSlalomBase()の所要時間を見積もる
+    // 直進速度は一定で、角速度をS字に加速、一定、減速の順に変化させる
+    if(speed <= 0){
+        return 0;
+    }
+
+    t_scurve curve;
+    slalomCurve(&curve, slalom, speed);
+    return (slalom->startOffsetDistance + slalom->stopOffsetDistance) / speed + curve.time;
+}
+
+float fastTurnSpeed(const int type){
+    // fastTurn()の入口と出口の速度の上限
+    return FAST_TURNS[type].speed;
+}
+
+float fastTurnTime(const int type){
+    // fastTurn()の所要時間を見積もる
+    return slalomTime(&FAST_TURNS[type], FAST_TURNS[type].speed);
+}
+
+static int checkSlalom(const t_slalom *slalom, const float targetAngle, const int isExit,
+        const char *name){
+    // queueSlalomBase()の軌跡を計算して、曲がる角度がtargetAngleで、
+    // 出口が区画の中心線上にあるか確かめる
+    const float DT = 0.00001; // 積分の刻み sec
+    const float TOLERANCE = 0.002; // 許容する位置ずれ meter
+    const float ANGLE_TOLERANCE = 0.5 * M_PI / 180.0; // 許容する角度のずれ rad
+    float startOffset = slalom->startOffsetDistance;
+    float stopOffset = slalom->stopOffsetDistance;
+    if(isExit){
+        startOffset = slalom->stopOffsetDistance;
+        stopOffset = slalom->startOffsetDistance;
+    }
+    t_scurve curve;
+    slalomCurve(&curve, slalom, slalom->speed);
+    float turnAngle = curve.distance;
+    if(fabsf(turnAngle - targetAngle) > ANGLE_TOLERANCE){
+        ESP_LOGW(TAG, "Turn %s turns %f deg, expected %f deg",
+                name, turnAngle * 180.0 / M_PI, targetAngle * 180.0 / M_PI);
+        return FALSE;
+    }
+
+    // 左に曲がるとして、queueSlalomBase()と同じ角速度で進む
+    float x = startOffset;
+    float y = 0;
+    int steps = (int)ceilf(curve.time / DT);
+    for(int step_i=0; step_i<steps; step_i++){
+        float angle, omega, alpha;
+        scurveSample(&curve, (step_i + 0.5) * DT, &angle, &omega, &alpha);
+        x += slalom->speed * cosf(angle) * DT;
+        y += slalom->speed * sinf(angle) * DT;
+    }
+    x += stopOffset * cosf(turnAngle);
+    y += stopOffset * sinf(turnAngle);
+
+    // 出口の位置
+    // OUTのときは逆向きに曲がるINの軌跡を逆にたどるので、その出口から見た入口の位置になる
+    float endX = slalom->endX;
+    float endY = slalom->endY;
+    if(isExit){
+        endX = slalom->endX * cosf(turnAngle) + slalom->endY * sinf(turnAngle);
+        endY = slalom->endX * sinf(turnAngle) - slalom->endY * cosf(turnAngle);
+    }
+
+    float error = hypotf(x - endX, y - endY);
+    if(error > TOLERANCE){
+        ESP_LOGW(TAG, "Turn %s(exit:%d) ends at (%f, %f), expected (%f, %f)",
+                name, isExit, x, y, endX, endY);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+// ターンの形ごとに、曲がるべき角度 deg
+static const float FAST_TURN_ANGLES[FAST_TURN_NUM] = {
+    [FAST_TURN_SMALL90] = 90.0,
+    [FAST_TURN_LARGE90] = 90.0,
+    [FAST_TURN_180] = 180.0,
+    [FAST_TURN_45] = 45.0,
+    [FAST_TURN_135] = 135.0,
+    [FAST_TURN_V90] = 90.0,
+};
+
+float slalomNominalAngle(const t_slalom *slalom){
+    // スラロームの形が曲がるべき角度 rad
+    // 形の角度の和ではなく、迷路の上で決まる角度(探索のスラロームは90度)を返す
+    for(int type=0; type<FAST_TURN_NUM; type++){
+        if(slalom == &FAST_TURNS[type]){
+            return FAST_TURN_ANGLES[type] * M_PI / 180.0;
+        }
+    }
+    return M_PI_2;
+}
+
+int checkFastTurn(const int type, const int isExit){
+    // fastTurn()の軌跡を計算して、出口が区画の中心線上にあるか確かめる
+    char name[8];
+    snprintf(name, sizeof(name), "%d", type);
+    return checkSlalom(&FAST_TURNS[type], slalomNominalAngle(&FAST_TURNS[type]), isExit, name);
+}
+
+int checkSearchSlalom(void){
+    // slalom()の軌跡を計算して、90度曲がって隣の区画の境界に出るか確かめる
+    return checkSlalom(&SEARCH_SLALOM, slalomNominalAngle(&SEARCH_SLALOM), FALSE, "search");
+}
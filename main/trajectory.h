@@ -0,0 +1,82 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+// 最短走行用のターンの種類
+typedef enum{
+    FAST_TURN_SMALL90 = 0, // 小回り90度
+    FAST_TURN_LARGE90,     // 大回り90度
+    FAST_TURN_180,         // 180度
+    FAST_TURN_45,          // 直線と斜めの間の45度
+    FAST_TURN_135,         // 直線と斜めの間の135度
+    FAST_TURN_V90,         // 斜めから斜めへの90度
+    FAST_TURN_NUM,
+}ENUM_FAST_TURN;
+
+// queueSlalomBase()で走るターンの形
+// 直進速度はターンの間ずっとspeedのまま変えない
+typedef struct{
+    float speed; // 入口と出口の速度 m/s
+    float maxOmega; // 最大角速度 rad/s
+    float accelDecel; // 角加減速度 rad/s^2
+    float startOffsetDistance; // 入口側のオフセット直線走行距離 meter
+    float stopOffsetDistance; // 出口側のオフセット直線走行距離 meter
+    float accelDecelAngle; // 加減速角度 rad
+    float keepOmegaAngle; // 低速角度 rad
+    float endX; // 入口から見た出口の前方向の位置 meter (INのとき)
+    float endY; // 入口から見た出口の曲がる方向の位置 meter (INのとき)
+}t_slalom;
+
+// ジャークを制限した速度の変化(S字加減速)
+// startSpeedからpeakSpeedまで加速し、定速のあとendSpeedまで減速する
+// 速度は直進なら m/s、回転なら rad/s、距離は meter か rad
+typedef struct{
+    float distance;
+    float startSpeed;
+    float peakSpeed;
+    float endSpeed;
+    float accel; // 加速度の大きさの上限
+    float jerk; // ジャークの大きさ
+    float accelTime; // 加速にかかる時間 sec
+    float cruiseTime; // 定速の時間 sec
+    float decelTime; // 減速にかかる時間 sec
+    float time; // 全体の時間 sec
+}t_scurve;
+
+// 前もって計算したスラロームの角速度の表(slalom_table.c)
+// 直進速度speedでshapeの形に曲がるときの、1制御周期ごとの角速度を並べる
+// 各周期の角速度はその周期の間の平均なので、足していくと目標の角度になる
+typedef struct{
+    const t_slalom *shape;
+    float speed; // m/s
+    int length; // 表の長さ(回転にかかる制御周期の数)
+    const float *omega; // rad/s
+}t_slalom_table;
+
+#define SLALOM_TABLE_PERIOD 0.001 // 表の刻み sec controller.cの制御周期と合わせる
+#define SLALOM_SPEED_NUM 5 // 表を作る直進速度の数
+
+extern const t_slalom SEARCH_SLALOM;
+extern const t_slalom FAST_TURNS[FAST_TURN_NUM];
+extern const float SLALOM_SPEEDS[SLALOM_SPEED_NUM];
+extern const t_slalom_table SLALOM_TABLES[];
+extern const int SLALOM_TABLE_NUM;
+
+extern void scurvePlan(t_scurve *curve, const float distance, const float startSpeed,
+        const float endSpeed, const float maxSpeed, const float accel, const float jerk);
+extern void scurveSample(const t_scurve *curve, const float time,
+        float *position, float *speed, float *accel);
+extern void slalomCurve(t_scurve *curve, const t_slalom *slalom, const float speed);
+extern float slalomTableOmega(const t_scurve *curve, const int tick);
+extern float slalomSpeedClass(const float speed);
+extern float straightTime(const float distance, const float startSpeed, const float endSpeed,
+        const float maxSpeed, const float accel);
+extern float straightReachSpeed(const float distance, const float startSpeed, const float accel);
+extern float turnTime(const float targetAngle);
+extern float slalomTime(const t_slalom *slalom, const float speed);
+extern float fastTurnSpeed(const int type);
+extern float fastTurnTime(const int type);
+extern float slalomNominalAngle(const t_slalom *slalom);
+extern int checkFastTurn(const int type, const int isExit);
+extern int checkSearchSlalom(void);
+
+#endif
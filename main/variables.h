@@ -60,7 +60,26 @@ typedef struct
     unsigned char west:2;	//西の壁情報
 }t_wall;			//壁情報を格納する構造体(ビットフィールド)
 
+// 迷路のサイズ(区画数)
+// PC上のベンチマークでは、コンパイルオプションで16x16区画にもできる
+#ifndef MAZESIZE_X
+#define MAZESIZE_X (32)
+#endif
+#ifndef MAZESIZE_Y
+#define MAZESIZE_Y (32)
+#endif
+
+// 歩数Map用の型
+// 歩数の最大値は区画数-1(全区画を一筆書きで通る迷路)なので、未到達の値(STEPS_MAX)と重ならない型をコンパイル時に選ぶ
+// 255区画まではunsigned char(最大254歩)、16x16区画(256区画)からはunsigned shortになる
+// 16x16区画では最大255歩になり、unsigned charの未到達の値0xFFと重なるため
+#if (MAZESIZE_X * MAZESIZE_Y) <= 0xFF
 typedef unsigned char t_steps;
+#define STEPS_MAX (0xFF)
+#else
+typedef unsigned short t_steps;
+#define STEPS_MAX (0xFFFF)
+#endif
 
 // -----Especialのモード-----
 extern enum MODE gCurrentMode;